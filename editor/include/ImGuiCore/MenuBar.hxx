@@ -50,10 +50,14 @@ public:
         return temp;
     }
 
+private:
+    void renderStatisticsWindow();
+
 private:
     std::unordered_map<std::string, std::vector<FileInteraction>> fileSubMenu;
 
     bool showMetricsWindow = false;
     bool displayColors = false;
     bool captureNextFrame = false;
+    bool showStatisticsWindow = false;
 };
@@ -16,7 +16,7 @@ MenuBar::MenuBar(const pivot::ecs::SceneManager &sceneManager, pivot::Engine &en
                     .sButtonText = "Save Scene",
                     .sSuccesText = "Scene correctly saved.",
                     .sErrorText = "Failed to save the scene, please check the log.",
-                    .acceptedFiles = {{"Scene", "json"}},
+                    .acceptedFiles = {{"Scene", "json"}, {"Binary scene", "pvscene"}},
                     .handler =
                         [&](const std::filesystem::path &path) {
                             engine.saveScene(sceneManager.getCurrentSceneId(), path);
@@ -28,7 +28,7 @@ MenuBar::MenuBar(const pivot::ecs::SceneManager &sceneManager, pivot::Engine &en
                     .sButtonText = "Load Scene",
                     .sSuccesText = "Scene loaded succefully !",
                     .sErrorText = "Scene loading failed, please check the log.",
-                    .acceptedFiles = {{"Scene", "json"}},
+                    .acceptedFiles = {{"Scene", "json"}, {"Binary scene", "pvscene"}},
                     .handler =
                         [&](const std::filesystem::path &path) {
                             engine.loadScene(path);
@@ -104,6 +104,18 @@ bool MenuBar::render()
                 if (ImGui::MenuItem("End Tracing")) { pivot::benchmark::Instrumentor::get().endSession(); }
             }
             if (ImGui::MenuItem("Capture One Frame")) { captureNextFrame = true; }
+            if (!pivot::benchmark::Instrumentor::get().isStreaming()) {
+                if (ImGui::MenuItem("Start Streaming")) { pivot::benchmark::Instrumentor::get().beginStreaming(); }
+            } else {
+                if (ImGui::MenuItem("Stop Streaming")) { pivot::benchmark::Instrumentor::get().endStreaming(); }
+            }
+            if (ImGui::MenuItem("Statistics Window", "", showStatisticsWindow)) {
+                showStatisticsWindow = !showStatisticsWindow;
+                if (showStatisticsWindow)
+                    pivot::benchmark::Instrumentor::get().enableStatistics();
+                else
+                    pivot::benchmark::Instrumentor::get().disableStatistics();
+            }
             ImGui::EndMenu();
         }
 #endif
@@ -112,11 +124,42 @@ bool MenuBar::render()
     }
 
     if (showMetricsWindow) ImGui::ShowMetricsWindow();
+    if (showStatisticsWindow) renderStatisticsWindow();
 
     ImGui::PopStyleVar(3);
     return true;
 }
 
+void MenuBar::renderStatisticsWindow()
+{
+    PROFILE_FUNCTION();
+    if (!ImGui::Begin("Statistics", &showStatisticsWindow)) {
+        ImGui::End();
+        return;
+    }
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("Zones", 6, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Zone");
+        for (const char *column: {"Min", "Avg", "P95", "P99", "Max"}) ImGui::TableSetupColumn(column);
+        ImGui::TableHeadersRow();
+        for (const auto &stats: pivot::benchmark::Instrumentor::get().getStatistics()) {
+            const bool isScope = stats.type == pivot::benchmark::ZoneType::Scope;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(stats.name.c_str());
+            for (double value: {stats.min, stats.average, stats.p95, stats.p99, stats.max}) {
+                ImGui::TableNextColumn();
+                ImGui::Text(isScope ? "%.3f ms" : "%.1f", value);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+    // The window was closed with its close button
+    if (!showStatisticsWindow) pivot::benchmark::Instrumentor::get().disableStatistics();
+}
+
 MenuBar::FileResult MenuBar::FileInteraction::open() const
 {
     PROFILE_FUNCTION();
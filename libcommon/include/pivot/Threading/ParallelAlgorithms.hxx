@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+
+#include "pivot/Threading/ThreadPool.hxx"
+
+namespace pivot
+{
+
+namespace parallel::detail
+{
+    /// Type erased chunk body, called with the chunk index
+    using ChunkFunction = void (*)(void *data, std::size_t chunk);
+
+    /// Run every chunk on the pool and the calling thread, and return once they are all done
+    ///
+    /// Jobs are submitted as a single batch of at most one job per worker, which then claim the chunks one by one.
+    /// Nothing is allocated to wait for them. If a chunk throws, the remaining chunks are skipped and the first
+    /// exception is rethrown on the calling thread.
+    void runChunks(ThreadPool &pool, std::size_t chunkCount, ChunkFunction function, void *data);
+
+    /// Call chunk(i) for every i in [0, chunkCount)
+    template <typename F>
+    void forEachChunk(ThreadPool &pool, std::size_t chunkCount, F &&chunk)
+    {
+        using Function = std::remove_reference_t<F>;
+        runChunks(
+            pool, chunkCount, [](void *data, std::size_t i) { (*static_cast<Function *>(data))(i); },
+            const_cast<void *>(static_cast<const void *>(std::addressof(chunk))));
+    }
+
+    /// Choose the number of items processed by a chunk
+    ///
+    /// A grain of 0 means automatic: the range is split in about 4 chunks per thread, so faster threads can pick up
+    /// the work left by the slower ones.
+    std::size_t grainSize(ThreadPool &pool, std::size_t itemCount, std::size_t grain);
+}    // namespace parallel::detail
+
+/// Call f(chunkBegin, chunkEnd) on consecutive sub-ranges of [begin, end), in parallel
+template <typename F>
+requires std::is_invocable_v<F, std::size_t, std::size_t>
+void parallel_for_chunks(ThreadPool &pool, std::size_t begin, std::size_t end, F &&f, std::size_t grain = 0)
+{
+    DEBUG_FUNCTION();
+    if (end <= begin) return;
+    const std::size_t count = end - begin;
+    grain = parallel::detail::grainSize(pool, count, grain);
+
+    parallel::detail::forEachChunk(pool, (count + grain - 1) / grain, [&](std::size_t chunk) {
+        const std::size_t chunkBegin = begin + chunk * grain;
+        f(chunkBegin, std::min(chunkBegin + grain, end));
+    });
+}
+
+/// Call f(i) for every index in [begin, end), in parallel
+template <typename F>
+requires std::is_invocable_v<F, std::size_t>
+void parallel_for(ThreadPool &pool, std::size_t begin, std::size_t end, F &&f, std::size_t grain = 0)
+{
+    parallel_for_chunks(
+        pool, begin, end,
+        [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+            for (std::size_t i = chunkBegin; i < chunkEnd; i++) f(i);
+        },
+        grain);
+}
+
+/// Call f(element) on every element of the range, in parallel
+template <std::ranges::random_access_range R, typename F>
+requires std::is_invocable_v<F, std::ranges::range_reference_t<R>>
+void parallel_for(ThreadPool &pool, R &&range, F &&f, std::size_t grain = 0)
+{
+    auto first = std::ranges::begin(range);
+    parallel_for_chunks(
+        pool, 0, std::ranges::size(range),
+        [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+            std::for_each(first + chunkBegin, first + chunkEnd, f);
+        },
+        grain);
+}
+
+///
+/// @brief Reduce the transformed elements of a range, in parallel
+///
+/// Like std::transform_reduce, reduce must be associative. The partial results are combined in the order of the
+/// range, so the result does not depend on the scheduling.
+///
+/// @param init The value the result is reduced into
+/// @param reduce Combine two values into one
+/// @param transform Applied on every element before reducing it
+/// @param grain Amount of elements handled by a chunk, 0 for automatic
+template <std::ranges::random_access_range R, typename T, typename Reduce, typename Transform = std::identity>
+requires std::is_invocable_r_v<T, Reduce, T, std::invoke_result_t<Transform, std::ranges::range_reference_t<R>>>
+T parallel_reduce(ThreadPool &pool, R &&range, T init, Reduce &&reduce, Transform &&transform = {},
+                  std::size_t grain = 0)
+{
+    DEBUG_FUNCTION();
+    /// Partial results are kept on the stack, so the amount of chunks is bounded
+    constexpr std::size_t maxChunks = 64;
+
+    const std::size_t count = std::ranges::size(range);
+    if (count == 0) return init;
+    grain = std::max(parallel::detail::grainSize(pool, count, grain), (count + maxChunks - 1) / maxChunks);
+    const std::size_t chunkCount = (count + grain - 1) / grain;
+
+    auto first = std::ranges::begin(range);
+    std::array<std::optional<T>, maxChunks> partials;
+    parallel::detail::forEachChunk(pool, chunkCount, [&](std::size_t chunk) {
+        auto it = first + chunk * grain;
+        const auto last = first + std::min((chunk + 1) * grain, count);
+
+        T partial = std::invoke(transform, *it);
+        for (++it; it != last; ++it) partial = std::invoke(reduce, std::move(partial), std::invoke(transform, *it));
+        partials[chunk] = std::move(partial);
+    });
+
+    for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+        init = std::invoke(reduce, std::move(init), std::move(*partials[chunk]));
+    return init;
+}
+
+///
+/// @brief Sort a range in parallel
+///
+/// The range is cut in chunks sorted independently, which are then merged two by two. Like std::sort, the sort is
+/// not stable.
+template <std::ranges::random_access_range R, typename Compare = std::ranges::less>
+requires std::sortable<std::ranges::iterator_t<R>, Compare>
+void parallel_sort(ThreadPool &pool, R &&range, Compare &&comp = {}, std::size_t grain = 0)
+{
+    DEBUG_FUNCTION();
+    auto first = std::ranges::begin(range);
+    const std::size_t count = std::ranges::size(range);
+    grain = parallel::detail::grainSize(pool, count, grain);
+
+    // Round the amount of chunks to a power of two, so every merge pass halves it
+    std::size_t chunkCount = 1;
+    while (chunkCount * grain < count) chunkCount *= 2;
+    if (chunkCount == 1) return std::sort(first, first + count, comp);
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    auto bound = [&](std::size_t chunk) { return first + std::min(chunk * chunkSize, count); };
+    parallel::detail::forEachChunk(pool, chunkCount,
+                                   [&](std::size_t chunk) { std::sort(bound(chunk), bound(chunk + 1), comp); });
+    for (std::size_t width = 1; width < chunkCount; width *= 2) {
+        parallel::detail::forEachChunk(pool, chunkCount / (width * 2), [&](std::size_t pair) {
+            const std::size_t left = pair * width * 2;
+            std::inplace_merge(bound(left), bound(left + width), bound(left + width * 2), comp);
+        });
+    }
+}
+
+}    // namespace pivot
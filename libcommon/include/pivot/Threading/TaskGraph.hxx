@@ -0,0 +1,80 @@
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "pivot/Threading/ThreadPool.hxx"
+#include "pivot/exception.hxx"
+
+namespace pivot
+{
+
+///
+/// @brief Directed acyclic graph of jobs, executed on a ThreadPool
+///
+/// Each task declares the tasks it depends on. When run, every task whose dependencies are done is handed to the
+/// pool, so independent branches of the graph overlap. A graph can be run any number of times.
+///
+class TaskGraph
+{
+public:
+    /// Error thrown when the graph is malformed
+    LOGIC_ERROR(TaskGraph);
+
+    /// Handle on a task of the graph
+    using TaskId = std::size_t;
+    /// The code executed by a task
+    using Work = std::function<void()>;
+
+public:
+    /// Add a task running after all of its dependencies
+    TaskId add(std::string name, Work work, std::span<const TaskId> dependencies = {});
+    /// @copydoc add
+    TaskId add(std::string name, Work work, std::initializer_list<TaskId> dependencies)
+    {
+        return add(std::move(name), std::move(work), std::span(dependencies.begin(), dependencies.size()));
+    }
+    /// Add a continuation, running after the task
+    TaskId then(TaskId task, std::string name, Work work) { return add(std::move(name), std::move(work), {task}); }
+    /// Make task wait for dependency before running
+    void depend(TaskId task, TaskId dependency);
+
+    ///
+    /// @brief Execute every task of the graph, and wait for them
+    ///
+    /// The calling thread runs pending jobs of the pool while waiting. If a task throws, the tasks depending on it
+    /// are skipped, and the first exception is rethrown once the graph is done.
+    ///
+    /// @throw TaskGraphError if the graph contains a cycle
+    void run(ThreadPool &pool);
+
+    /// Return the name of a task
+    const std::string &getName(TaskId task) const { return nodes.at(task).name; }
+    /// Return the amount of task in the graph
+    std::size_t size() const noexcept { return nodes.size(); }
+    /// Is the graph empty ?
+    bool empty() const noexcept { return nodes.empty(); }
+    /// Remove all the tasks
+    void clear() noexcept { nodes.clear(); }
+
+private:
+    struct Node {
+        std::string name;
+        const benchmark::Zone *zone;
+        Work work;
+        std::vector<TaskId> successors;
+        unsigned dependencyCount = 0;
+    };
+    struct Execution;
+
+    void checkAcyclic() const;
+    void execute(Execution &execution, TaskId task) const;
+
+private:
+    std::vector<Node> nodes;
+};
+
+}    // namespace pivot
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <thread>
 #include <type_traits>
 
@@ -16,22 +22,105 @@ namespace pivot
 {
 
 /// Manage a set of thread for sheduling work
+///
+/// Every worker owns a deque of jobs per lane. A worker pops from the back of its own deque, and steals from the front
+/// of the others when it runs dry. Idle workers sleep on a condition variable until a job is pushed.
+///
+/// Jobs of the Frame lane always run first. Jobs of the Background lane only run when there is no frame work left,
+/// and on a limited share of the workers, so that the other workers are always available for the frame. A background
+/// job is never interrupted, but a worker checks the Frame lane again before starting the next one.
 class ThreadPool
 {
     PIVOT_NO_COPY_NO_MOVE(ThreadPool)
+public:
+    /// Priority of a job
+    enum class Lane : std::uint8_t {
+        /// Work needed to finish the current frame
+        Frame,
+        /// Long running work, like loading assets, which must not delay the frames
+        Background,
+    };
+    /// Amount of lanes
+    static constexpr std::size_t laneCount = 2;
+
+    /// Activity of a lane, since the last call to resetMetrics()
+    struct LaneMetrics {
+        /// Amount of jobs waiting to be run
+        std::size_t queueDepth;
+        /// Amount of jobs started
+        std::size_t startedJobs;
+        /// Average time between the push of a job and its start
+        std::chrono::nanoseconds averageLatency;
+        /// Longest time between the push of a job and its start
+        std::chrono::nanoseconds maxLatency;
+    };
+
 private:
     using WorkUnits = std::function<void(unsigned id)>;
 
+    struct Job {
+        WorkUnits work;
+        std::chrono::steady_clock::time_point pushTime;
+    };
+
+    /// Jobs owned by a single worker
+    struct WorkQueue {
+        std::mutex mutex;
+        std::array<std::deque<Job>, laneCount> tasks;
+    };
+
+    struct LaneState {
+        std::atomic_size_t i_pendingWork = 0;
+        std::atomic_size_t i_startedJobs = 0;
+        std::atomic_uint64_t i_totalLatency = 0;
+        std::atomic_uint64_t i_maxLatency = 0;
+    };
+
     struct State {
+        /// Push a job on the queue of the calling worker, or on any queue when called from outside the pool
+        void enqueue(WorkUnits work, Lane lane);
+        /// Push count copies of a job, spread over every queue
+        void enqueueBatch(const WorkUnits &work, unsigned count, Lane lane);
+        /// Pop a job of the lane from the queue at index, or steal one from another queue
+        std::optional<Job> dequeue(unsigned index, Lane lane);
+        /// Run a job, and record its latency
+        void execute(Job &job, Lane lane, unsigned threadID);
+        /// Run a background job if the amount of workers running them allows it
+        bool runBackgroundJob(unsigned index, unsigned threadID);
+        /// Take a place among the workers allowed to run background jobs
+        bool acquireBackgroundSlot();
+        /// Give back the place taken by acquireBackgroundSlot()
+        void releaseBackgroundSlot();
+        /// Can a sleeping worker find something to do ?
+        bool hasRunnableWork() const;
+        /// Make sure there is at least size queues
+        void reserve(unsigned size);
+        /// Wake sleeping workers
+        void wake(bool all);
+        /// Wake every sleeping worker
+        void wakeAll();
+
+        std::shared_mutex queues_mutex;
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+        std::array<LaneState, laneCount> lanes;
+        std::atomic_size_t i_nextQueue = 0;
+        std::atomic_size_t i_sleepingWorkers = 0;
+        std::atomic_uint i_backgroundWorkers = 0;
+        std::atomic_uint i_maxBackgroundWorkers = 1;
+
         std::mutex q_mutex;
         std::condition_variable q_var;
-        std::queue<WorkUnits> qWork;
+
+        /// State, queue index and thread id of the worker running on this thread, if any
+        static thread_local const State *currentState;
+        static thread_local unsigned currentQueue;
+        static thread_local unsigned currentThreadID;
     };
 
     class WorkerPoolRuntime : public internal::IThreadRuntime
     {
     public:
-        WorkerPoolRuntime(std::shared_ptr<ThreadPool::State> context);
+        WorkerPoolRuntime(std::shared_ptr<ThreadPool::State> context, unsigned queueIndex);
 
         bool init() override;
         std::uint32_t run() override;
@@ -43,6 +132,7 @@ private:
 
     private:
         int i_threadID;
+        unsigned i_queueIndex;
         std::atomic_bool b_requestExit;
         std::shared_ptr<ThreadPool::State> p_state;
     };
@@ -59,30 +149,59 @@ public:
     size_t size() { return thread_p.size(); }
     /// Resize the thread pool
     void resize(unsigned size);
+    ///
+    /// @brief Set the share of the workers allowed to run background jobs at the same time
+    ///
+    /// At least one worker is always allowed, so that the background jobs are eventually run.
+    void setBackgroundShare(float share);
+    /// Return the share of the workers allowed to run background jobs
+    float getBackgroundShare() const noexcept { return f_backgroundShare; }
+
+    /// Push count copies of a job in a single batch, without creating any future
+    void dispatch(const WorkUnits &work, unsigned count, Lane lane = Lane::Frame);
+    /// Run one pending frame job on the calling thread, used to help the pool while waiting on it
+    ///
+    /// Background jobs are never run, as they could block the calling thread for too long.
+    ///
+    /// @return false if there was no job to run
+    bool runPendingWork();
 
     template <class F, typename... Args>
     /// Push a new job in the pool and return a future
     requires std::is_invocable_v<F, unsigned, Args...>
     [[nodiscard]] auto push(F &&f, Args &&...args) -> std::future<decltype(f(0, args...))>
+    {
+        return push(Lane::Frame, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    template <class F, typename... Args>
+    /// Push a new job in a lane of the pool and return a future
+    requires std::is_invocable_v<F, unsigned, Args...>
+    [[nodiscard]] auto push(Lane lane, F &&f, Args &&...args) -> std::future<decltype(f(0, args...))>
     {
         DEBUG_FUNCTION();
         if (!verifyAlwaysMsg(!thread_p.empty(), "Pushing task when no thread are started !")) { start(1); }
         auto packagedFunction = std::make_shared<std::packaged_task<decltype(f(0, args...))(unsigned)>>(
             std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...));
 
-        WorkUnits storageFunc([packagedFunction](int id) { (*packagedFunction)(id); });
-
-        {
-            std::unique_lock lock(state->q_mutex);
-            state->qWork.push(storageFunc);
-        }
-        state->q_var.notify_one();
-        return packagedFunction->get_future();
+        auto future = packagedFunction->get_future();
+        state->enqueue([packagedFunction = std::move(packagedFunction)](unsigned id) { (*packagedFunction)(id); },
+                       lane);
+        return future;
     }
 
+    /// Return the activity of a lane
+    LaneMetrics getMetrics(Lane lane) const;
+    /// Restart the latency measurements of every lane
+    void resetMetrics();
+
+private:
+    void updateBackgroundWorkers();
+
 private:
     std::shared_ptr<State> state;
     std::vector<Thread> thread_p;
+    float f_backgroundShare = 0.5f;
 };
 
 }    // namespace pivot
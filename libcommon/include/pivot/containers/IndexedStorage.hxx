@@ -1,77 +1,136 @@
 #pragma once
 
 #include <algorithm>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "pivot/containers/SlotMap.hxx"
 #include "pivot/pivot.hxx"
 
 namespace pivot
 {
 
 template <Hashable Key, typename Value>
-/// Store a type in a vector, while keeping a map to the indexes
+///
+/// @brief Store named values contiguously
+///
+/// Values live in a SlotMap, so every operation is O(1): a key is resolved with a single hash lookup, and a dense
+/// index is mapped back to its key through a reverse index. Removing a value only moves the last value in its place.
+///
 class IndexedStorage
 {
 private:
     using size_type = typename std::vector<Value>::size_type;
 
 public:
-    /// return an iterator over the indexes
-    auto begin() { return index.begin(); }
-    /// return the end iterator
-    auto end() { return index.end(); }
-    /// return an iterator over the indexes
-    auto begin() const { return index.begin(); }
+    /// Stable reference to a value of the storage
+    using Handle = typename SlotMap<Value>::Handle;
+
+    /// Iterate over the keys and their dense index
+    class const_iterator
+    {
+    public:
+        /// The key, and the index of its value
+        using value_type = std::pair<const Key &, size_type>;
+        /// Iterators yield values
+        using reference = value_type;
+        /// Distance between two iterators
+        using difference_type = std::ptrdiff_t;
+        /// Iterator concept
+        using iterator_concept = std::forward_iterator_tag;
+
+        const_iterator() = default;
+        /// Create an iterator at the given index
+        const_iterator(const std::vector<Key> *keys, size_type idx): keys(keys), idx(idx) {}
+
+        /// Dereference operator
+        value_type operator*() const { return {(*keys)[idx], idx}; }
+        /// Pre-increment operator
+        const_iterator &operator++()
+        {
+            ++idx;
+            return *this;
+        }
+        /// Post-increment operator
+        const_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++idx;
+            return copy;
+        }
+        /// Equality operator
+        bool operator==(const const_iterator &) const = default;
+
+    private:
+        const std::vector<Key> *keys = nullptr;
+        size_type idx = 0;
+    };
+
+public:
+    /// return an iterator over the keys and their index
+    const_iterator begin() const noexcept { return {&keys, 0}; }
     /// return the end iterator
-    auto end() const { return index.end(); }
+    const_iterator end() const noexcept { return {&keys, keys.size()}; }
 
     /// Clear the internal storage
     void clear()
     {
         index.clear();
+        keys.clear();
         storage.clear();
     }
     /// Reserve extra memory
     void reserve(size_type size)
     {
         index.reserve(size);
+        keys.reserve(size);
         storage.reserve(size);
     }
 
     /// Append to the current storage
     void append(const IndexedStorage &other)
     {
-        for (const auto &[name, idx]: other.getIndexes()) {
-            if (contains(name)) throw std::runtime_error("Index already in use !");
-            index.emplace(name, idx + storage.size());
-        }
-        storage.insert(storage.end(), other.getStorage().begin(), other.getStorage().end());
+        for (const auto &key: other.keys)
+            if (contains(key)) throw std::runtime_error("Index already in use !");
+        reserve(size() + other.size());
+        for (size_type i = 0; i < other.size(); i++) add(other.keys[i], other.get(i));
     }
 
-    /// Remove key from storage
+    /// Remove key from storage, the last item takes its index
     void erase(const Key &key)
     {
-        auto idx = getIndex(key);
-        if (idx == -1) throw std::out_of_range("Key not found !");
-        storage.erase(storage.begin() + idx);
-        index.erase(key);
+        auto iter = index.find(key);
+        if (iter == index.end()) throw std::out_of_range("Key not found !");
+        eraseEntry(iter);
+    }
+    /// @copydoc erase
+    void erase(const Handle &handle)
+    {
+        if (!storage.contains(handle)) throw std::out_of_range("Stale handle !");
+        eraseEntry(index.find(keys[storage.getDenseIndex(handle)]));
     }
     /// Add a new item to the storage
-    inline void add(const Key &i, Value value)
+    inline Handle add(const Key &i, Value value)
     {
-        if (contains(i)) throw std::runtime_error("Index already in use !");
-        storage.push_back(std::move(value));
-        index.emplace(i, storage.size() - 1);
+        auto [iter, inserted] = index.try_emplace(i);
+        if (!inserted) throw std::runtime_error("Index already in use !");
+        iter->second = storage.insert(std::move(value));
+        keys.push_back(i);
+        return iter->second;
     }
     /// @copydoc add
-    inline void add(const std::pair<Key, Value> value) { add(value.first, std::move(value.second)); }
-    /// Valueell if given key already exist in storage
+    inline Handle add(std::pair<Key, Value> value) { return add(value.first, std::move(value.second)); }
+    /// Tell if given key already exist in storage
     inline bool contains(const Key &i) const { return index.contains(i); }
+    /// Tell if the handle refers to an item of the storage
+    inline bool contains(const Handle &handle) const noexcept { return storage.contains(handle); }
     /// return the number of item in the storage
-    constexpr auto size() const noexcept
+    constexpr size_type size() const noexcept
     {
         pivotAssert(storage.size() == index.size());
         return storage.size();
@@ -79,52 +138,84 @@ public:
     /// return whether or not the size is equal to 0
     constexpr bool empty() const noexcept { return size() == 0; }
 
-    /// return the internal vector
-    constexpr const auto &getStorage() const noexcept { return storage; }
+    /// return the internal vector, which must not be resized
+    constexpr const auto &getStorage() const noexcept { return storage.getStorage(); }
     /// @copydoc getStorage
-    constexpr auto &getStorage() noexcept { return storage; }
-    /// return the internal vector
+    constexpr auto &getStorage() noexcept { return storage.getStorage(); }
+    /// return the handle of every key
     constexpr const auto &getIndexes() const noexcept { return index; }
-    /// @copydoc getIndexes
-    constexpr auto &getIndexes() noexcept { return index; }
 
     /// Get the name associated to given idx
-    constexpr std::optional<Key> getName(const size_type &idx) const
+    std::optional<Key> getName(const size_type &idx) const
     {
-        auto findResult =
-            std::find_if(index.begin(), index.end(), [&idx](const auto &pair) { return pair.second == idx; });
-        if (findResult != index.end()) return findResult->first;
-        return std::nullopt;
+        if (idx >= keys.size()) return std::nullopt;
+        return keys[idx];
     }
     /// return the index of an item name
     inline std::int32_t getIndex(const Key &i) const noexcept
     {
-        if (index.contains(i))
-            return index.at(i);
-        else
-            return -1;
+        auto iter = index.find(i);
+        if (iter == index.end()) return -1;
+        return storage.getDenseIndex(iter->second);
+    }
+    /// return the handle of an item name, which is not valid if the name is unknown
+    inline Handle getHandle(const Key &i) const noexcept
+    {
+        auto iter = index.find(i);
+        return (iter != index.end()) ? (iter->second) : (Handle{});
     }
 
     /// return the item at a given index
-    constexpr Value &get(const size_type &i) { return storage.at(i); }
+    constexpr Value &get(const size_type &i) { return storage.getStorage().at(i); }
+    /// @copydoc get
+    constexpr Value &get(const Key &i) { return storage[findHandle(i)]; }
     /// @copydoc get
-    constexpr Value &get(const Key &i) { return get(index.at(i)); }
+    constexpr Value &get(const Handle &handle) { return storage.at(handle); }
     /// @copydoc get
-    constexpr const Value &get(const size_type &i) const { return storage.at(i); }
+    constexpr const Value &get(const size_type &i) const { return storage.getStorage().at(i); }
     /// @copydoc get
-    constexpr const Value &get(const Key &i) const { return get(index.at(i)); }
+    constexpr const Value &get(const Key &i) const { return storage[findHandle(i)]; }
+    /// @copydoc get
+    constexpr const Value &get(const Handle &handle) const { return storage.at(handle); }
     /// Get the item, if it doesnt exist, create the index
-    inline Value &operator[](const std::string &i)
+    inline Value &operator[](const Key &i)
+    {
+        auto iter = index.find(i);
+        if (iter == index.end()) return storage[add(i, {})];
+        return storage[iter->second];
+    }
+    /// Equality operator, true if both storage hold the same items, whatever their order
+    bool operator==(const IndexedStorage &other) const
+    {
+        if (size() != other.size()) return false;
+        return std::ranges::all_of(*this, [&other, this](const auto &entry) {
+            auto iter = other.index.find(entry.first);
+            return iter != other.index.end() && other.storage[iter->second] == get(entry.second);
+        });
+    }
+
+private:
+    const Handle &findHandle(const Key &i) const
+    {
+        auto iter = index.find(i);
+        if (iter == index.end()) throw std::out_of_range("Key not found !");
+        return iter->second;
+    }
+    void eraseEntry(typename std::unordered_map<Key, Handle>::iterator iter)
     {
-        if (!index.contains(i)) add(i, {});
-        return get(i);
+        // The storage moves its last item in place of the erased one, the reverse index must follow
+        const auto dense = storage.getDenseIndex(iter->second);
+        storage.erase(iter->second);
+        keys[dense] = std::move(keys.back());
+        keys.pop_back();
+        index.erase(iter);
     }
-    /// Equality operator
-    bool operator==(const IndexedStorage &) const = default;
 
 private:
-    std::vector<Value> storage;
-    std::unordered_map<Key, size_type> index;
+    SlotMap<Value> storage;
+    std::unordered_map<Key, Handle> index;
+    /// Key of each item, in the order of the storage
+    std::vector<Key> keys;
 };
 
 }    // namespace pivot
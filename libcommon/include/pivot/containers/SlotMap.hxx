@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "pivot/pivot.hxx"
+
+namespace pivot
+{
+
+template <typename Value>
+///
+/// @brief Store values densely, behind stable generational handles
+///
+/// Insertion, removal and lookup are O(1). Values are kept contiguous, so iterating over them is as fast as over a
+/// vector. Removing a value moves the last one in its place, so only the dense index of that last value changes.
+///
+/// A handle stays valid until its value is removed. Once removed, the slot can be reused, but its generation is
+/// bumped so that old handles are detected as stale instead of silently pointing to the new value.
+///
+class SlotMap
+{
+public:
+    /// Type of the indexes
+    using size_type = std::uint32_t;
+
+    /// Stable reference to a value of the map
+    struct Handle {
+        /// Index of the slot
+        size_type index = std::numeric_limits<size_type>::max();
+        /// Generation of the slot when the handle was created
+        size_type generation = 0;
+
+        /// Was the handle returned by a map, rather than default constructed ?
+        constexpr bool isValid() const noexcept { return index != std::numeric_limits<size_type>::max(); }
+        /// Comparison operator
+        constexpr auto operator<=>(const Handle &) const = default;
+    };
+
+public:
+    /// return an iterator over the values
+    auto begin() noexcept { return values.begin(); }
+    /// return the end iterator
+    auto end() noexcept { return values.end(); }
+    /// return an iterator over the values
+    auto begin() const noexcept { return values.begin(); }
+    /// return the end iterator
+    auto end() const noexcept { return values.end(); }
+
+    /// Construct a value in place, and return its handle
+    template <typename... Args>
+    Handle emplace(Args &&...args)
+    {
+        size_type slotIndex;
+        if (freeHead != invalidIndex) {
+            slotIndex = freeHead;
+            freeHead = slots[slotIndex].denseIndex;
+        } else {
+            slotIndex = static_cast<size_type>(slots.size());
+            slots.push_back({});
+        }
+        values.emplace_back(std::forward<Args>(args)...);
+        denseToSlot.push_back(slotIndex);
+        slots[slotIndex].denseIndex = static_cast<size_type>(values.size() - 1);
+        return {slotIndex, slots[slotIndex].generation};
+    }
+    /// Add a value, and return its handle
+    Handle insert(Value value) { return emplace(std::move(value)); }
+
+    ///
+    /// @brief Remove a value, moving the last value in its place
+    ///
+    /// @return false if the handle is stale
+    bool erase(const Handle &handle)
+    {
+        if (!contains(handle)) return false;
+        Slot &slot = slots[handle.index];
+        const size_type dense = slot.denseIndex;
+        const size_type last = static_cast<size_type>(values.size() - 1);
+        if (dense != last) {
+            values[dense] = std::move(values[last]);
+            denseToSlot[dense] = denseToSlot[last];
+            slots[denseToSlot[dense]].denseIndex = dense;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+
+        slot.generation++;
+        slot.denseIndex = freeHead;
+        freeHead = handle.index;
+        return true;
+    }
+
+    /// Does the handle refer to a value of the map ?
+    constexpr bool contains(const Handle &handle) const noexcept
+    {
+        // The generation of a slot is bumped when its value is removed, so a free slot never matches a handle
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+    }
+    /// Return a pointer to the value, or nullptr if the handle is stale
+    Value *find(const Handle &handle) noexcept
+    {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+    /// @copydoc find
+    const Value *find(const Handle &handle) const noexcept
+    {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+    ///
+    /// @brief Return the value of the handle
+    ///
+    /// @throw std::out_of_range if the handle is stale
+    Value &at(const Handle &handle)
+    {
+        if (!contains(handle)) throw std::out_of_range("Stale slot map handle !");
+        return values[slots[handle.index].denseIndex];
+    }
+    /// @copydoc at
+    const Value &at(const Handle &handle) const
+    {
+        if (!contains(handle)) throw std::out_of_range("Stale slot map handle !");
+        return values[slots[handle.index].denseIndex];
+    }
+    /// Return the value of the handle, which must be valid
+    Value &operator[](const Handle &handle) noexcept
+    {
+        pivotAssert(contains(handle));
+        return values[slots[handle.index].denseIndex];
+    }
+    /// @copydoc operator[]
+    const Value &operator[](const Handle &handle) const noexcept
+    {
+        pivotAssert(contains(handle));
+        return values[slots[handle.index].denseIndex];
+    }
+
+    /// Return the position of the value in the dense storage, the handle must be valid
+    size_type getDenseIndex(const Handle &handle) const noexcept
+    {
+        pivotAssert(contains(handle));
+        return slots[handle.index].denseIndex;
+    }
+    /// Return the handle of the value at a position of the dense storage
+    Handle getHandle(size_type denseIndex) const
+    {
+        const size_type slotIndex = denseToSlot.at(denseIndex);
+        return {slotIndex, slots[slotIndex].generation};
+    }
+
+    /// return the number of values
+    constexpr size_type size() const noexcept { return static_cast<size_type>(values.size()); }
+    /// return whether or not the size is equal to 0
+    constexpr bool empty() const noexcept { return values.empty(); }
+    /// Remove every value, invalidating all the handles
+    void clear()
+    {
+        for (size_type slotIndex: denseToSlot) {
+            slots[slotIndex].generation++;
+            slots[slotIndex].denseIndex = freeHead;
+            freeHead = slotIndex;
+        }
+        values.clear();
+        denseToSlot.clear();
+    }
+    /// Reserve extra memory
+    void reserve(size_type size)
+    {
+        values.reserve(size);
+        denseToSlot.reserve(size);
+        slots.reserve(size);
+    }
+
+    /// return the dense storage, which must not be resized
+    constexpr const std::vector<Value> &getStorage() const noexcept { return values; }
+    /// @copydoc getStorage
+    constexpr std::vector<Value> &getStorage() noexcept { return values; }
+
+private:
+    static constexpr size_type invalidIndex = std::numeric_limits<size_type>::max();
+
+    struct Slot {
+        /// Position of the value in the dense storage, or next free slot when unused
+        size_type denseIndex = invalidIndex;
+        size_type generation = 0;
+    };
+
+private:
+    std::vector<Value> values;
+    std::vector<size_type> denseToSlot;
+    std::vector<Slot> slots;
+    size_type freeHead = invalidIndex;
+};
+
+}    // namespace pivot
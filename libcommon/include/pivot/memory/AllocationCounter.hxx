@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace pivot::memory
+{
+
+///
+/// @brief Count the heap allocations of the current thread
+///
+/// This is a test hook: nothing is counted unless PIVOT_COUNT_ALLOCATIONS() is expanded once, at global scope, in
+/// the test executable. It replaces every form of the global operator new and operator delete (plain, array, nothrow
+/// and aligned), so it must never be used in the engine itself, nor in an executable linking pivot-allocator, whose
+/// mimalloc replaces them too.
+///
+/// @code
+/// PIVOT_COUNT_ALLOCATIONS()
+///
+/// AllocationCounter counter;
+/// runFrame();
+/// REQUIRE(counter.getCount() == 0);
+/// @endcode
+///
+class AllocationCounter
+{
+public:
+    /// Start counting
+    AllocationCounter() noexcept: start(allocations) {}
+
+    /// Amount of allocations made by the current thread since the counter was created
+    std::size_t getCount() const noexcept { return allocations - start; }
+    /// Restart counting from zero
+    void reset() noexcept { start = allocations; }
+
+    /// Amount of allocations made by the current thread, updated by the replaced operator new
+    static inline thread_local std::size_t allocations = 0;
+
+private:
+    std::size_t start;
+};
+
+namespace detail
+{
+    /// Counts and makes an allocation of the replaced operator new, returns nullptr on failure
+    inline void *countedAllocate(std::size_t size) noexcept
+    {
+        ++AllocationCounter::allocations;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    /// Counts and makes an aligned allocation, the block returned by malloc is stored right before the pointer
+    inline void *countedAllocate(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        ++AllocationCounter::allocations;
+        const auto align = std::max(static_cast<std::size_t>(alignment), alignof(void *));
+        if (size > SIZE_MAX - align - sizeof(void *)) return nullptr;
+        void *block = std::malloc(size + align + sizeof(void *));
+        if (!block) return nullptr;
+        const auto address = (reinterpret_cast<std::uintptr_t>(block) + sizeof(void *) + align - 1) & ~(align - 1);
+        reinterpret_cast<void **>(address)[-1] = block;
+        return reinterpret_cast<void *>(address);
+    }
+
+    /// Frees an allocation made by countedAllocate(size)
+    inline void release(void *ptr) noexcept { std::free(ptr); }
+
+    /// Frees an allocation made by countedAllocate(size, alignment)
+    inline void release(void *ptr, std::align_val_t) noexcept
+    {
+        if (ptr) std::free(static_cast<void **>(ptr)[-1]);
+    }
+
+    /// Same as countedAllocate, throwing std::bad_alloc on failure
+    template <typename... Alignment>
+    void *countedNew(std::size_t size, Alignment... alignment)
+    {
+        if (void *ptr = countedAllocate(size, alignment...)) return ptr;
+        throw std::bad_alloc();
+    }
+}    // namespace detail
+
+}    // namespace pivot::memory
+
+#if defined(__GNUC__) && !defined(__clang__)
+    // g++ pairs the inlined std::malloc with the replaced operator delete and reports them as mismatched
+    #define PIVOT_ALLOCATIONS_DIAGNOSTIC_PUSH \
+        _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wmismatched-new-delete\"")
+    #define PIVOT_ALLOCATIONS_DIAGNOSTIC_POP _Pragma("GCC diagnostic pop")
+#else
+    #define PIVOT_ALLOCATIONS_DIAGNOSTIC_PUSH
+    #define PIVOT_ALLOCATIONS_DIAGNOSTIC_POP
+#endif
+
+/// Replace the global operator new to count the allocations, see pivot::memory::AllocationCounter
+#define PIVOT_COUNT_ALLOCATIONS()                                                                                      \
+    PIVOT_ALLOCATIONS_DIAGNOSTIC_PUSH                                                                                  \
+    void *operator new(std::size_t size) { return pivot::memory::detail::countedNew(size); }                           \
+    void *operator new[](std::size_t size) { return pivot::memory::detail::countedNew(size); }                         \
+    void *operator new(std::size_t size, const std::nothrow_t &) noexcept                                              \
+    {                                                                                                                  \
+        return pivot::memory::detail::countedAllocate(size);                                                           \
+    }                                                                                                                  \
+    void *operator new[](std::size_t size, const std::nothrow_t &) noexcept                                            \
+    {                                                                                                                  \
+        return pivot::memory::detail::countedAllocate(size);                                                           \
+    }                                                                                                                  \
+    void *operator new(std::size_t size, std::align_val_t align)                                                       \
+    {                                                                                                                  \
+        return pivot::memory::detail::countedNew(size, align);                                                         \
+    }                                                                                                                  \
+    void *operator new[](std::size_t size, std::align_val_t align)                                                     \
+    {                                                                                                                  \
+        return pivot::memory::detail::countedNew(size, align);                                                         \
+    }                                                                                                                  \
+    void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept                      \
+    {                                                                                                                  \
+        return pivot::memory::detail::countedAllocate(size, align);                                                    \
+    }                                                                                                                  \
+    void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept                    \
+    {                                                                                                                  \
+        return pivot::memory::detail::countedAllocate(size, align);                                                    \
+    }                                                                                                                  \
+    void operator delete(void *ptr) noexcept { pivot::memory::detail::release(ptr); }                                  \
+    void operator delete[](void *ptr) noexcept { pivot::memory::detail::release(ptr); }                                \
+    void operator delete(void *ptr, std::size_t) noexcept { pivot::memory::detail::release(ptr); }                     \
+    void operator delete[](void *ptr, std::size_t) noexcept { pivot::memory::detail::release(ptr); }                   \
+    void operator delete(void *ptr, const std::nothrow_t &) noexcept { pivot::memory::detail::release(ptr); }          \
+    void operator delete[](void *ptr, const std::nothrow_t &) noexcept { pivot::memory::detail::release(ptr); }        \
+    void operator delete(void *ptr, std::align_val_t align) noexcept { pivot::memory::detail::release(ptr, align); }   \
+    void operator delete[](void *ptr, std::align_val_t align) noexcept { pivot::memory::detail::release(ptr, align); } \
+    void operator delete(void *ptr, std::size_t, std::align_val_t align) noexcept                                      \
+    {                                                                                                                  \
+        pivot::memory::detail::release(ptr, align);                                                                    \
+    }                                                                                                                  \
+    void operator delete[](void *ptr, std::size_t, std::align_val_t align) noexcept                                    \
+    {                                                                                                                  \
+        pivot::memory::detail::release(ptr, align);                                                                    \
+    }                                                                                                                  \
+    void operator delete(void *ptr, std::align_val_t align, const std::nothrow_t &) noexcept                           \
+    {                                                                                                                  \
+        pivot::memory::detail::release(ptr, align);                                                                    \
+    }                                                                                                                  \
+    void operator delete[](void *ptr, std::align_val_t align, const std::nothrow_t &) noexcept                         \
+    {                                                                                                                  \
+        pivot::memory::detail::release(ptr, align);                                                                    \
+    }                                                                                                                  \
+    PIVOT_ALLOCATIONS_DIAGNOSTIC_POP
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+
+#include "pivot/memory/MonotonicArena.hxx"
+
+namespace pivot::memory
+{
+
+///
+/// @brief Memory which only lives for the current frame
+///
+/// Each thread has its own arena, so allocating never takes a lock. Containers which are rebuilt every frame should
+/// allocate from it instead of the heap:
+///
+/// @code
+/// std::pmr::vector<Data> data(FrameArena::get());
+/// @endcode
+///
+/// Memory allocated during a frame stays valid until the end of the next frame, then it is reused. The frames are
+/// counted by the engine loop, code running outside of it must call nextFrame() itself.
+///
+class FrameArena
+{
+public:
+    /// Get the arena of the current thread
+    static MonotonicArena *get();
+    /// Start a new frame, the memory of the frame before the previous one will be reused
+    static void nextFrame() noexcept;
+    /// Index of the current frame
+    static std::uint64_t getFrame() noexcept;
+};
+
+}    // namespace pivot::memory
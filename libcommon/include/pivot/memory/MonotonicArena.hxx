@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "pivot/pivot.hxx"
+
+namespace pivot::memory
+{
+
+///
+/// @brief Bump allocator which keeps its memory between resets
+///
+/// Allocating only moves a pointer forward, and deallocating does nothing: the memory is reclaimed all at once by
+/// reset(). When the arena overflows, a new block is taken from the upstream resource, and the blocks are merged into
+/// a single one on the next reset. Once the arena is large enough, it does not allocate anymore.
+///
+/// The arena is not thread-safe.
+///
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    /// Size of the first block
+    static constexpr std::size_t defaultBlockSize = 64 * 1024;
+
+public:
+    /// Constructor, nothing is allocated until the first allocation
+    explicit MonotonicArena(std::size_t initialSize = defaultBlockSize,
+                            std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+    /// Destructor, give the memory back to the upstream resource
+    ~MonotonicArena() override;
+    PIVOT_NO_COPY_NO_MOVE(MonotonicArena)
+
+    /// Reclaim every allocation at once, the memory is kept for the next allocations
+    void reset();
+    /// Reclaim every allocation, and give the memory back to the upstream resource
+    void release();
+
+    /// Amount of bytes allocated since the last reset
+    std::size_t getUsed() const noexcept { return used + offset; }
+    /// Amount of bytes the arena can hold without allocating
+    std::size_t getCapacity() const noexcept;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    void addBlock(std::size_t minimumSize);
+
+private:
+    struct Block {
+        std::byte *data;
+        std::size_t size;
+    };
+
+    std::pmr::memory_resource *upstream;
+    std::size_t nextBlockSize;
+    std::vector<Block> blocks;
+    /// Block currently used, and offset of the first free byte in it
+    std::size_t current = 0;
+    std::size_t offset = 0;
+    /// Bytes allocated in the previous blocks
+    std::size_t used = 0;
+};
+
+}    // namespace pivot::memory
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "pivot/pivot.hxx"
+
+namespace pivot::memory
+{
+
+///
+/// @brief Recycle small allocations of the same size
+///
+/// Allocations are rounded up to a power of two between minBlockSize and maxBlockSize, and served from free lists of
+/// blocks of that size. Freed blocks go back to their list, so node based containers which are filled and cleared
+/// repeatedly (maps, lists) stop allocating once they reached their usual size. Larger, or over-aligned, allocations
+/// are forwarded to the upstream resource.
+///
+/// The memory is only given back to the upstream resource by release() or the destructor. The pool is not
+/// thread-safe.
+///
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    /// Size of the smallest blocks
+    static constexpr std::size_t minBlockSize = 16;
+    /// Size of the largest blocks
+    static constexpr std::size_t maxBlockSize = 1024;
+    /// Size of the chunks taken from the upstream resource
+    static constexpr std::size_t chunkSize = 16 * 1024;
+
+public:
+    /// Constructor, nothing is allocated until the first allocation
+    explicit PoolResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+    /// Destructor, give the memory back to the upstream resource
+    ~PoolResource() override;
+    PIVOT_NO_COPY_NO_MOVE(PoolResource)
+
+    /// Give every chunk back to the upstream resource, the allocated blocks must not be used anymore
+    void release();
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    static std::size_t getSizeClass(std::size_t bytes) noexcept;
+    void refill(std::size_t sizeClass);
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+    static constexpr std::size_t sizeClassCount = 7;
+    static_assert(minBlockSize << (sizeClassCount - 1) == maxBlockSize);
+
+    std::pmr::memory_resource *upstream;
+    std::array<FreeBlock *, sizeClassCount> freeLists = {};
+    std::vector<std::byte *> chunks;
+};
+
+}    // namespace pivot::memory
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+#include "pivot/exception.hxx"
+
+namespace pivot
+{
+
+///
+/// @brief A file mapped read-only in memory
+///
+/// The pages of the file are only read from the disk when they are accessed, and are shared with the page cache, so
+/// the content is never copied.
+///
+class MappedFile
+{
+public:
+    /// Error thrown when a file can't be mapped
+    RUNTIME_ERROR(MappedFile);
+
+public:
+    /// Create an empty mapping
+    MappedFile() = default;
+    ///
+    /// @brief Map the whole content of a file
+    ///
+    /// @throw MappedFileError if the file can't be opened or mapped
+    explicit MappedFile(const std::filesystem::path &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    /// Move constructor
+    MappedFile(MappedFile &&other) noexcept;
+    /// Move assignment
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    /// Unmap the file
+    ~MappedFile();
+
+    /// Content of the file
+    std::span<const std::byte> data() const noexcept { return {m_data, m_size}; }
+    /// Size of the file
+    std::size_t size() const noexcept { return m_size; }
+
+private:
+    void unmap() noexcept;
+
+private:
+    const std::byte *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+}    // namespace pivot
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "pivot/exception.hxx"
+
+namespace pivot
+{
+
+///
+/// @brief Minimal blocking TCP socket
+///
+/// Only meant for local tooling, like streaming profiling data to a viewer.
+///
+class Socket
+{
+public:
+    /// Error thrown when a socket operation fails
+    RUNTIME_ERROR(Socket);
+
+    /// Native handle of the socket
+    using Handle = std::intptr_t;
+    /// Value of an handle not backed by any socket
+    static constexpr Handle invalidHandle = -1;
+
+public:
+    ///
+    /// @brief Open a connection to a listening socket
+    ///
+    /// @throw SocketError if the connection failed
+    static Socket connect(const std::string &host, std::uint16_t port);
+    ///
+    /// @brief Create a socket accepting connections
+    ///
+    /// @param port the port to listen on, 0 to pick any available port
+    /// @param address the address to bind the socket to
+    /// @throw SocketError if the socket can't be bound
+    static Socket listen(std::uint16_t port, const std::string &address = "127.0.0.1");
+
+public:
+    /// Create a closed socket
+    Socket() = default;
+    Socket(const Socket &) = delete;
+    Socket &operator=(const Socket &) = delete;
+    /// Move constructor
+    Socket(Socket &&other) noexcept;
+    /// Move assignment
+    Socket &operator=(Socket &&other) noexcept;
+    /// Close the socket
+    ~Socket();
+
+    ///
+    /// @brief Wait for a connection on a listening socket
+    ///
+    /// @throw SocketError if the socket is not listening anymore
+    Socket accept();
+    /// Send all the data, return false if the connection was closed
+    bool send(std::span<const std::byte> data);
+    /// Receive some data, return the amount received, or 0 if the connection was closed
+    std::size_t receive(std::span<std::byte> buffer);
+
+    /// Return the local port of the socket
+    std::uint16_t getPort() const;
+    /// Is the socket open ?
+    bool isOpen() const noexcept { return handle != invalidHandle; }
+    /// Stop any pending or future operation without releasing the socket, can be called from another thread
+    void shutdown() noexcept;
+    /// Close the socket
+    void close() noexcept;
+
+private:
+    explicit Socket(Handle handle): handle(handle) {}
+
+private:
+    Handle handle = invalidHandle;
+};
+
+}    // namespace pivot
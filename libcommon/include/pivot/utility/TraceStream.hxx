@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "pivot/exception.hxx"
+#include "pivot/utility/benchmark.hxx"
+
+///
+/// @brief Binary framing of the profiling events streamed by the Instrumentor
+///
+/// A stream starts with the magic number and the protocol version, followed by messages. Each message is a type byte,
+/// the size of its payload as an u32, and the payload itself. Every integer is little endian.
+///
+/// Zones and threads are described once per connection, events then refer to them by id.
+///
+namespace pivot::benchmark::stream
+{
+
+/// First bytes of a stream ("PVTR")
+constexpr std::uint32_t magic = 0x52545650;
+/// Version of the protocol
+constexpr std::uint16_t version = 1;
+/// Port used when none is specified
+constexpr std::uint16_t defaultPort = defaultStreamPort;
+
+/// Kind of a message
+enum class MessageType : std::uint8_t {
+    Zone,
+    Thread,
+    Scope,
+    Value,
+    Frame,
+};
+
+/// Describe a zone, sent before the first event referencing it
+struct ZoneMessage {
+    /// Id of the zone in the following events
+    std::uint32_t id;
+    /// What is recorded for this zone
+    ZoneType type;
+    /// The name of the zone
+    std::string name;
+};
+
+/// Describe a thread, sent before the first event recorded by it
+struct ThreadMessage {
+    /// Id of the thread in the following events
+    std::uint32_t id;
+    /// The name of the thread
+    std::string name;
+};
+
+/// A timed section
+struct ScopeMessage {
+    /// The zone being timed
+    std::uint32_t zone;
+    /// The thread the section ran on
+    std::uint32_t thread;
+    /// Start of the section, in nanoseconds
+    std::uint64_t start;
+    /// Duration of the section, in nanoseconds
+    std::uint64_t duration;
+};
+
+/// A sample of a counter or gauge
+struct ValueMessage {
+    /// The counter or gauge
+    std::uint32_t zone;
+    /// The thread the sample was recorded on
+    std::uint32_t thread;
+    /// Time of the sample, in nanoseconds
+    std::uint64_t timestamp;
+    /// The recorded value
+    double value;
+};
+
+/// End of a frame
+struct FrameMessage {
+    /// Time of the end of the frame, in nanoseconds
+    std::uint64_t timestamp;
+};
+
+/// Any message of the stream
+using Message = std::variant<ZoneMessage, ThreadMessage, ScopeMessage, ValueMessage, FrameMessage>;
+
+///
+/// @brief Serialize messages into a byte buffer
+///
+class Encoder
+{
+public:
+    /// Write the magic number and version, must be the first thing sent on a connection
+    void writeHeader();
+    /// Append a message to the buffer
+    void write(const Message &message);
+
+    /// Return the encoded bytes
+    std::span<const std::byte> data() const noexcept { return buffer; }
+    /// Return the amount of encoded bytes
+    std::size_t size() const noexcept { return buffer.size(); }
+    /// Remove the encoded bytes, keeping the allocated memory
+    void clear() noexcept { buffer.clear(); }
+
+private:
+    template <typename T>
+    void put(T value);
+    void putString(const std::string &value);
+
+private:
+    std::vector<std::byte> buffer;
+};
+
+///
+/// @brief Parse messages out of a byte stream, received in arbitrary pieces
+///
+class Decoder
+{
+public:
+    /// Error thrown when the stream is malformed
+    RUNTIME_ERROR(Decoder);
+
+public:
+    /// Append received bytes
+    void feed(std::span<const std::byte> data);
+    ///
+    /// @brief Return the next complete message, if any
+    ///
+    /// Messages of an unknown type are skipped.
+    ///
+    /// @throw DecoderError if the stream does not start with the expected header, or a message is malformed
+    std::optional<Message> next();
+
+private:
+    std::vector<std::byte> buffer;
+    std::size_t offset = 0;
+    bool b_headerRead = false;
+};
+
+}    // namespace pivot::benchmark::stream
@@ -1,9 +1,22 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <source_location>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include "pivot/Threading/Thread.hxx"
 #include "pivot/pivot.hxx"
 #include "pivot/utility/define.hxx"
 #include "pivot/utility/source_location.hxx"
@@ -11,16 +24,86 @@
 namespace pivot::benchmark
 {
 
-/// Hold the result of a Timer
-struct TimerResult {
+/// Port used to stream the profiling results when none is specified
+constexpr std::uint16_t defaultStreamPort = 28597;
+
+/// What is recorded for a zone
+enum class ZoneType : std::uint8_t {
+    /// A timed section
+    Scope,
+    /// A value summed over each frame
+    Counter,
+    /// A value of which only the last sample of each frame is kept
+    Gauge,
+    /// The end of a frame
+    Frame,
+};
+
+///
+/// @brief Static description of a profiled section
+///
+/// Created once per PROFILE_SCOPE, at compile time, so timers only have to carry a pointer to it.
+///
+struct Zone {
+    /// Create a zone
+    constexpr Zone(const char *name, const char *file, std::uint32_t line, ZoneType type = ZoneType::Scope)
+        : name(name), file(file), line(line), type(type)
+    {
+    }
+    PIVOT_NO_COPY_NO_MOVE(Zone)
+
     /// The name of the section
-    const std::string name;
+    const char *const name;
+    /// The file the section is in
+    const char *const file;
+    /// The line the section starts at
+    const std::uint32_t line;
+    /// What is recorded for this zone
+    const ZoneType type;
+    /// Unique id of the zone, assigned by the Instrumentor the first time the zone is recorded
+    mutable std::atomic_uint32_t id = 0;
+};
+
+/// Return the current time of the profiling clock, in nanoseconds
+FORCEINLINE std::uint64_t getTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Hold the result of a Timer, or a sample of a counter or gauge
+struct TimerResult {
+    /// The section
+    const Zone *zone;
     /// The start point of the timestamp
-    const unsigned long long start_timestamp;
-    /// The end point of the timestamp
-    const unsigned long long end_timestamp;
-    /// The id of the thread the section was executed on
-    const std::thread::id threadId;
+    std::uint64_t start_timestamp;
+    union {
+        /// The end point of the timestamp, for scopes
+        std::uint64_t end_timestamp;
+        /// The recorded value, for counters and gauges
+        double value;
+    };
+};
+
+/// Statistics of a zone over the last frames
+struct ZoneStatistics {
+    /// The name of the zone
+    std::string name;
+    /// What is recorded for this zone
+    ZoneType type;
+    /// Amount of frames the statistics are computed on
+    std::size_t frameCount;
+    /// Smallest per-frame value, in milliseconds for scopes
+    double min;
+    /// Average per-frame value
+    double average;
+    /// 95th percentile of the per-frame values
+    double p95;
+    /// 99th percentile of the per-frame values
+    double p99;
+    /// Largest per-frame value
+    double max;
 };
 
 class Timer;
@@ -28,6 +111,13 @@ class Timer;
 ///
 /// @brief Manage the profiling session and timer
 ///
+/// Each thread records its results into its own lock-free ring buffer, drained into the session file by a background
+/// writer thread. When a buffer is full, the results are dropped rather than blocking the recording thread.
+///
+/// Results are recorded while a session is started, while statistics are enabled, or while streaming. Statistics are
+/// aggregated per frame by the writer thread, and do not need a session file. Streaming sends the results to a
+/// receiver over a socket as they are drained, so capture can run for as long as needed (see TraceStream.hxx).
+///
 class Instrumentor
 {
     PIVOT_NO_COPY_NO_MOVE(Instrumentor)
@@ -60,8 +150,52 @@ public:
     void endSession();
     /// Is a session open ?
     bool isSessionStarted() const;
-    /// Dump the timer result data in the session file
+    /// Are results being recorded, either for a session, for statistics or for streaming ?
+    FORCEINLINE bool isRecording() const { return recordingFlags.load(std::memory_order_relaxed) != 0; }
+    /// Record the timer result, it will be written in the session file by the writer thread
     void writeResult(const TimerResult &result);
+    /// Record a sample of a counter or gauge
+    FORCEINLINE void recordValue(const Zone &zone, double value)
+    {
+        if (!isRecording()) return;
+        TimerResult result{&zone, getTimestamp()};
+        result.value = value;
+        writeResult(result);
+    }
+    /// Return the zone interned for a name only known at runtime
+    const Zone &getZone(std::string_view name);
+    /// Write the results recorded so far in the session file, without waiting for the writer thread
+    void flush();
+    /// Amount of results dropped in the current session because a thread buffer was full
+    std::size_t getDroppedCount() const;
+
+    ///
+    /// @brief Start computing per-frame statistics of every zone
+    ///
+    /// @param frameCount the amount of frames the statistics are computed on
+    void enableStatistics(std::size_t frameCount = 120);
+    /// Stop computing statistics, and forget the ones computed so far
+    void disableStatistics();
+    /// Are statistics computed ?
+    bool isStatisticsEnabled() const;
+    /// Mark the end of the current frame
+    void endFrame();
+    /// Return the statistics of every zone recorded during the last frames
+    std::vector<ZoneStatistics> getStatistics() const;
+    /// Return the statistics of a single zone, if it was recorded during the last frames
+    std::optional<ZoneStatistics> getStatistics(std::string_view zoneName) const;
+
+    ///
+    /// @brief Start sending the results to a receiver, until endStreaming() is called
+    ///
+    /// @param host the address the receiver listens on
+    /// @param port the port the receiver listens on
+    /// @return false if the receiver can't be reached
+    bool beginStreaming(const std::string &host = "127.0.0.1", std::uint16_t port = defaultStreamPort);
+    /// Send the remaining results, and close the connection to the receiver
+    void endStreaming();
+    /// Are the results sent to a receiver ?
+    bool isStreaming() const;
 
     /// Return the thread name associated with this id
     std::string getThreadName(const std::thread::id &id = std::this_thread::get_id()) const;
@@ -71,14 +205,70 @@ public:
     void clearThreadName(const std::thread::id &id = std::this_thread::get_id());
 
 private:
+    struct ThreadBuffer;
+    class WriterRuntime;
+    struct StreamState;
+    /// What the results are recorded for
+    enum RecordingFlag : std::uint8_t {
+        Session = 1 << 0,
+        Statistics = 1 << 1,
+        Streaming = 1 << 2,
+    };
+    /// Per-frame values of a zone
+    struct ZoneHistory {
+        std::deque<double> values;
+        std::size_t lastRecordedFrame = 0;
+    };
+    /// Value of each zone during a single frame
+    using FrameValues = std::unordered_map<const Zone *, double>;
+
+    /// Return the buffer of the calling thread, registering it if needed
+    ThreadBuffer &getThreadBuffer();
+    /// Start or stop the writer thread, depending on what is recorded
+    void updateWriter();
+    /// Drop every buffered result
+    void discardBuffers();
+    /// Write every buffered result in the session file, and aggregate them in the statistics
+    void drainBuffers();
+    /// Send the encoded results to the receiver, closing the stream if it is gone
+    void sendStream(StreamState &state);
+    /// Add the values of a finished frame to the statistics
+    void closeFrame(const FrameValues &values);
+    /// Compute the statistics of a zone
+    ZoneStatistics computeStatistics(const Zone &zone, const ZoneHistory &history) const;
+    /// Return the name of the zone, as written in the session file
+    const std::string &getZoneName(const Zone &zone);
     void writeHeader();
     void writeFooter();
 
 private:
-    int profileCount = 0;
-    mutable std::recursive_mutex mutex;
+    std::atomic_uint8_t recordingFlags = 0;
+    std::mutex controlMutex;
+    bool b_writerRunning = false;
+
+    mutable std::mutex buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    std::mutex outputMutex;
+    std::size_t profileCount = 0;
+    std::uint32_t zoneCount = 0;
+    std::unordered_map<const Zone *, std::string> zoneNames;
     std::ofstream outputStream;
+    Thread writerThread;
+    /// Values of the frame not ended yet
+    FrameValues currentFrame;
+    std::unique_ptr<StreamState> stream;
+
+    mutable std::mutex statisticsMutex;
+    std::size_t statisticsFrameCount = 120;
+    std::size_t frameIndex = 0;
+    std::unordered_map<const Zone *, ZoneHistory> statistics;
+
+    mutable std::mutex namesMutex;
     std::unordered_map<std::thread::id, std::string> thread_names;
+
+    std::mutex zonesMutex;
+    std::map<std::string, std::unique_ptr<Zone>, std::less<>> dynamicZones;
 };
 
 ///
@@ -91,52 +281,59 @@ public:
     ///
     /// @brief Construct a new timer object
     ///
-    /// @param name the name of the section
-    FORCEINLINE Timer(const std::string name): name(std::move(name))
-    {
-        startTimepoint = std::chrono::high_resolution_clock::now();
-    }
+    /// @param zone the section being timed
+    FORCEINLINE explicit Timer(const Zone &zone): zone(&zone), startTimestamp(getTimestamp()) {}
     /// Stop the timer
-    FORCEINLINE ~Timer()
-    {
-        if (!stopped) stop();
-    }
+    FORCEINLINE ~Timer() { stop(); }
 
     /// Send the result to the Instrumentor
     FORCEINLINE void stop()
     {
-        if (stopped) return;
-
-        auto endTimepoint = std::chrono::high_resolution_clock::now();
+        if (zone == nullptr) return;
+        endTimestamp = getTimestamp();
 
-        Instrumentor::get().writeResult({
-            .name = std::move(name),
-            .start_timestamp = static_cast<unsigned long long>(
-                std::chrono::time_point_cast<std::chrono::nanoseconds>(startTimepoint).time_since_epoch().count()),
-            .end_timestamp = static_cast<unsigned long long>(
-                std::chrono::time_point_cast<std::chrono::nanoseconds>(endTimepoint).time_since_epoch().count()),
-            .threadId = std::this_thread::get_id(),
-        });
-
-        stopped = true;
+        auto &instrumentor = Instrumentor::get();
+        if (instrumentor.isRecording()) instrumentor.writeResult({zone, startTimestamp, endTimestamp});
+        zone = nullptr;
     }
 
 private:
-    const std::string name;
-    std::chrono::time_point<std::chrono::high_resolution_clock> startTimepoint;
-    bool stopped = false;
+    const Zone *zone;
+    std::uint64_t startTimestamp;
+    std::uint64_t endTimestamp = 0;
 };
 
 }    // namespace pivot::benchmark
 
 #if !defined(NO_BENCHMARK)
 
-    #define PROFILE_SCOPE(name) ::pivot::benchmark::Timer PIVOT_MACRO_EXPENDER(timer, __LINE__)(name)
-    #define PROFILE_FUNCTION() PROFILE_SCOPE(::pivot::utils::function_name())
+    #define PROFILE_ZONE(zone) ::pivot::benchmark::Timer PIVOT_MACRO_EXPENDER(timer, __LINE__)(zone)
+    #define PROFILE_SCOPE(name)                                                                            \
+        static constinit const ::pivot::benchmark::Zone PIVOT_MACRO_EXPENDER(zone, __LINE__)(name, __FILE__, \
+                                                                                            __LINE__);     \
+        PROFILE_ZONE(PIVOT_MACRO_EXPENDER(zone, __LINE__))
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(std::source_location::current().function_name())
+
+    #define PIVOT_PROFILE_VALUE(name, value, type)                                                             \
+        do {                                                                                                   \
+            static constinit const ::pivot::benchmark::Zone PIVOT_MACRO_EXPENDER(zone, __LINE__)(name, __FILE__, \
+                                                                                                __LINE__, type);\
+            ::pivot::benchmark::Instrumentor::get().recordValue(PIVOT_MACRO_EXPENDER(zone, __LINE__), (value));  \
+        } while (0)
+    /// Add value to a counter, summed over each frame
+    #define PROFILE_COUNTER(name, value) PIVOT_PROFILE_VALUE(name, value, ::pivot::benchmark::ZoneType::Counter)
+    /// Set the value of a gauge
+    #define PROFILE_GAUGE(name, value) PIVOT_PROFILE_VALUE(name, value, ::pivot::benchmark::ZoneType::Gauge)
+    /// Mark the end of a frame, for the statistics
+    #define PROFILE_FRAME() ::pivot::benchmark::Instrumentor::get().endFrame()
 
 #else
 
+    #define PROFILE_ZONE(zone)
     #define PROFILE_SCOPE(name)
     #define PROFILE_FUNCTION()
+    #define PROFILE_COUNTER(name, value)
+    #define PROFILE_GAUGE(name, value)
+    #define PROFILE_FRAME()
 
 #endif
@@ -9,8 +9,6 @@ namespace pivot
 {
 /// @brief Id of an entity in the ECS
 using Entity = std::uint32_t;
-/// Maximum number of entity in the ECS
-const Entity MAX_ENTITIES = 500000;
 /// Special id of the null entity ref
 const Entity NULL_ENTITY = std::numeric_limits<Entity>::max();
 
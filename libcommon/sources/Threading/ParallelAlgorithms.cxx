@@ -0,0 +1,74 @@
+#include "pivot/Threading/ParallelAlgorithms.hxx"
+
+#include <exception>
+#include <latch>
+
+namespace pivot::parallel::detail
+{
+
+namespace
+{
+    /// Shared between the calling thread and the helpers, lives on the caller stack
+    struct ForkJoin {
+        ForkJoin(std::size_t count, ChunkFunction func, void *userData, unsigned helpers)
+            : chunkCount(count), function(func), data(userData), helpersDone(helpers)
+        {
+        }
+
+        /// Claim chunks until there is none left
+        void work()
+        {
+            for (std::size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+                try {
+                    function(data, chunk);
+                } catch (...) {
+                    if (!failed.test_and_set()) exception = std::current_exception();
+                    nextChunk = chunkCount;
+                }
+            }
+        }
+
+        const std::size_t chunkCount;
+        const ChunkFunction function;
+        void *const data;
+        std::atomic_size_t nextChunk = 0;
+        std::latch helpersDone;
+        std::atomic_flag failed;
+        std::exception_ptr exception;
+    };
+}    // namespace
+
+void runChunks(ThreadPool &pool, std::size_t chunkCount, ChunkFunction function, void *data)
+{
+    const unsigned helpers = std::min<std::size_t>(pool.size(), chunkCount > 0 ? chunkCount - 1 : 0);
+    if (helpers == 0) {
+        for (std::size_t chunk = 0; chunk < chunkCount; chunk++) function(data, chunk);
+        return;
+    }
+
+    ForkJoin join(chunkCount, function, data, helpers);
+    pool.dispatch(
+        [&join](unsigned) {
+            join.work();
+            join.helpersDone.count_down();
+        },
+        helpers);
+    join.work();
+
+    // The helpers reference the join, so wait for every one of them, even those that will find no chunk left.
+    // Run pending jobs meanwhile, in case the helpers are queued behind this thread.
+    while (!join.helpersDone.try_wait()) {
+        if (!pool.runPendingWork()) join.helpersDone.wait();
+    }
+    if (join.exception) std::rethrow_exception(join.exception);
+}
+
+std::size_t grainSize(ThreadPool &pool, std::size_t itemCount, std::size_t grain)
+{
+    if (grain > 0) return grain;
+
+    const std::size_t chunkCount = (pool.size() + 1) * 4;
+    return std::max<std::size_t>((itemCount + chunkCount - 1) / chunkCount, 1);
+}
+
+}    // namespace pivot::parallel::detail
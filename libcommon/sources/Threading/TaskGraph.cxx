@@ -0,0 +1,140 @@
+#include "pivot/Threading/TaskGraph.hxx"
+
+#include <exception>
+#include <latch>
+
+namespace pivot
+{
+
+/// State of a single run of the graph, lives on the stack of TaskGraph::run
+struct TaskGraph::Execution {
+    Execution(const TaskGraph &g, ThreadPool &p)
+        : graph(g), pool(p), joinCounters(g.size()), cancelled(g.size()), tasksDone(g.size())
+    {
+    }
+
+    const TaskGraph &graph;
+    ThreadPool &pool;
+    /// Amount of dependencies of each task that are not done yet
+    std::vector<std::atomic_uint> joinCounters;
+    /// Set when a dependency of the task failed
+    std::vector<std::atomic_bool> cancelled;
+    std::latch tasksDone;
+    std::atomic_flag failed;
+    std::exception_ptr exception;
+    /// Ready tasks, used instead of the pool when it has no thread
+    std::vector<TaskId> serialQueue;
+    bool serial = false;
+};
+
+TaskGraph::TaskId TaskGraph::add(std::string name, Work work, std::span<const TaskId> dependencies)
+{
+    const TaskId id = nodes.size();
+    const benchmark::Zone &zone = benchmark::Instrumentor::get().getZone(name);
+    nodes.push_back({
+        .name = std::move(name),
+        .zone = &zone,
+        .work = std::move(work),
+    });
+    for (TaskId dependency: dependencies) depend(id, dependency);
+    return id;
+}
+
+void TaskGraph::depend(TaskId task, TaskId dependency)
+{
+    if (task >= nodes.size() || dependency >= nodes.size())
+        throw TaskGraphError("Unknown task " + std::to_string(std::max(task, dependency)));
+    if (task == dependency) throw TaskGraphError("Task " + nodes[task].name + " can't depend on itself");
+
+    nodes[dependency].successors.push_back(task);
+    nodes[task].dependencyCount++;
+}
+
+void TaskGraph::run(ThreadPool &pool)
+{
+    DEBUG_FUNCTION();
+    if (nodes.empty()) return;
+    checkAcyclic();
+
+    Execution execution(*this, pool);
+    execution.serial = pool.size() == 0;
+    for (TaskId id = 0; id < nodes.size(); id++) execution.joinCounters[id] = nodes[id].dependencyCount;
+
+    if (execution.serial) {
+        for (TaskId id = 0; id < nodes.size(); id++)
+            if (nodes[id].dependencyCount == 0) execution.serialQueue.push_back(id);
+        while (!execution.serialQueue.empty()) {
+            TaskId id = execution.serialQueue.back();
+            execution.serialQueue.pop_back();
+            execute(execution, id);
+        }
+    } else {
+        for (TaskId id = 0; id < nodes.size(); id++) {
+            if (nodes[id].dependencyCount != 0) continue;
+            pool.dispatch([&execution, id](unsigned) { execution.graph.execute(execution, id); }, 1);
+        }
+        while (!execution.tasksDone.try_wait()) {
+            if (!pool.runPendingWork()) execution.tasksDone.wait();
+        }
+    }
+    if (execution.exception) std::rethrow_exception(execution.exception);
+}
+
+void TaskGraph::checkAcyclic() const
+{
+    std::vector<unsigned> remaining(nodes.size());
+    std::vector<TaskId> ready;
+    for (TaskId id = 0; id < nodes.size(); id++) {
+        remaining[id] = nodes[id].dependencyCount;
+        if (remaining[id] == 0) ready.push_back(id);
+    }
+
+    std::size_t visited = 0;
+    while (!ready.empty()) {
+        TaskId id = ready.back();
+        ready.pop_back();
+        visited++;
+        for (TaskId successor: nodes[id].successors)
+            if (--remaining[successor] == 0) ready.push_back(successor);
+    }
+    if (visited != nodes.size()) throw TaskGraphError("The task graph contains a cycle");
+}
+
+void TaskGraph::execute(Execution &execution, TaskId task) const
+{
+    // Loop instead of recursing: the first successor made ready by a task runs right after it, on the same thread
+    while (true) {
+        const Node &node = nodes[task];
+        bool succeeded = !execution.cancelled[task];
+        if (succeeded && node.work) {
+            try {
+                PROFILE_ZONE(*node.zone);
+                node.work();
+            } catch (...) {
+                succeeded = false;
+                if (!execution.failed.test_and_set()) execution.exception = std::current_exception();
+            }
+        }
+
+        std::optional<TaskId> continuation;
+        for (TaskId successor: node.successors) {
+            if (!succeeded) execution.cancelled[successor] = true;
+            if (--execution.joinCounters[successor] != 0) continue;
+
+            if (!continuation) {
+                continuation = successor;
+            } else if (execution.serial) {
+                execution.serialQueue.push_back(successor);
+            } else {
+                execution.pool.dispatch(
+                    [&execution, successor](unsigned) { execution.graph.execute(execution, successor); }, 1);
+            }
+        }
+        // Must be last, as the execution may be destroyed as soon as every task is done
+        execution.tasksDone.count_down();
+        if (!continuation) return;
+        task = *continuation;
+    }
+}
+
+}    // namespace pivot
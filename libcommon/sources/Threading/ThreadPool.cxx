@@ -2,6 +2,8 @@
 
 #include "pivot/utility/source_location.hxx"
 
+#include <algorithm>
+
 namespace pivot
 {
 
@@ -16,7 +18,7 @@ void ThreadPool::start(unsigned i)
 void ThreadPool::stop()
 {
     DEBUG_FUNCTION();
-    state->q_var.notify_all();
+    state->wakeAll();
     thread_p.clear();
 }
 
@@ -24,24 +26,221 @@ void ThreadPool::resize(unsigned size)
 {
     DEBUG_FUNCTION();
 
+    // Queues are never removed, so jobs left by a removed worker can still be stolen
+    state->reserve(size);
     unsigned old_size = thread_p.size();
     thread_p.resize(size);
     for (; old_size < thread_p.size(); old_size++) {
         thread_p.at(old_size).create("Worker Thread nb " + std::to_string(old_size),
-                                     std::make_unique<WorkerPoolRuntime>(state));
+                                     std::make_unique<WorkerPoolRuntime>(state, old_size));
     }
+    updateBackgroundWorkers();
+}
+
+void ThreadPool::setBackgroundShare(float share)
+{
+    f_backgroundShare = std::clamp(share, 0.f, 1.f);
+    updateBackgroundWorkers();
+}
+
+void ThreadPool::updateBackgroundWorkers()
+{
+    const auto workers = static_cast<unsigned>(f_backgroundShare * thread_p.size());
+    state->i_maxBackgroundWorkers = std::max(workers, 1u);
+    // Workers waiting for a background slot may be allowed to run now
+    state->wakeAll();
+}
+
+void ThreadPool::dispatch(const WorkUnits &work, unsigned count, Lane lane)
+{
+    if (count == 0) return;
+    if (!verifyAlwaysMsg(!thread_p.empty(), "Dispatching task when no thread are started !")) { start(1); }
+    state->enqueueBatch(work, count, lane);
 }
 
+bool ThreadPool::runPendingWork()
+{
+    const bool isWorker = State::currentState == state.get();
+    auto job = state->dequeue(isWorker ? State::currentQueue : 0, Lane::Frame);
+
+    if (!job) return false;
+    state->execute(*job, Lane::Frame, isWorker ? State::currentThreadID : 0);
+    return true;
+}
+
+ThreadPool::LaneMetrics ThreadPool::getMetrics(Lane lane) const
+{
+    const LaneState &laneState = state->lanes[static_cast<std::size_t>(lane)];
+    const std::size_t started = laneState.i_startedJobs;
+    return {
+        .queueDepth = laneState.i_pendingWork,
+        .startedJobs = started,
+        .averageLatency = std::chrono::nanoseconds(started ? laneState.i_totalLatency / started : 0),
+        .maxLatency = std::chrono::nanoseconds(laneState.i_maxLatency),
+    };
+}
+
+void ThreadPool::resetMetrics()
+{
+    for (LaneState &laneState: state->lanes) {
+        laneState.i_startedJobs = 0;
+        laneState.i_totalLatency = 0;
+        laneState.i_maxLatency = 0;
+    }
+}
+
+thread_local const ThreadPool::State *ThreadPool::State::currentState = nullptr;
+thread_local unsigned ThreadPool::State::currentQueue = 0;
+thread_local unsigned ThreadPool::State::currentThreadID = 0;
+
+void ThreadPool::State::enqueue(WorkUnits work, Lane lane)
+{
+    const auto laneIndex = static_cast<std::size_t>(lane);
+    {
+        std::shared_lock queuesLock(queues_mutex);
+        pivotAssertMsg(!queues.empty(), "No queue to push the work into");
+
+        unsigned index = (currentState == this) ? currentQueue : i_nextQueue++ % queues.size();
+        WorkQueue &queue = *queues.at(index);
+        std::unique_lock lock(queue.mutex);
+        queue.tasks[laneIndex].push_back({std::move(work), std::chrono::steady_clock::now()});
+        lanes[laneIndex].i_pendingWork++;
+    }
+    // Paired with the check in WorkerPoolRuntime::run: either the worker sees the pending work, or we see it sleeping
+    if (i_sleepingWorkers > 0) wake(false);
+}
+
+void ThreadPool::State::enqueueBatch(const WorkUnits &work, unsigned count, Lane lane)
+{
+    const auto laneIndex = static_cast<std::size_t>(lane);
+    {
+        std::shared_lock queuesLock(queues_mutex);
+        pivotAssertMsg(!queues.empty(), "No queue to push the work into");
+
+        const auto now = std::chrono::steady_clock::now();
+        const std::size_t first = i_nextQueue.fetch_add(count);
+        for (unsigned i = 0; i < count; i++) {
+            WorkQueue &queue = *queues.at((first + i) % queues.size());
+            std::unique_lock lock(queue.mutex);
+            queue.tasks[laneIndex].push_back({work, now});
+            lanes[laneIndex].i_pendingWork++;
+        }
+    }
+    if (i_sleepingWorkers > 0) wake(count > 1);
+}
+
+std::optional<ThreadPool::Job> ThreadPool::State::dequeue(unsigned index, Lane lane)
+{
+    const auto laneIndex = static_cast<std::size_t>(lane);
+    if (lanes[laneIndex].i_pendingWork == 0) return std::nullopt;
+
+    std::shared_lock queuesLock(queues_mutex);
+
+    if (index < queues.size()) {
+        WorkQueue &queue = *queues[index];
+        std::unique_lock lock(queue.mutex);
+        auto &tasks = queue.tasks[laneIndex];
+        if (!tasks.empty()) {
+            Job job = std::move(tasks.back());
+            tasks.pop_back();
+            lanes[laneIndex].i_pendingWork--;
+            return job;
+        }
+    }
+    for (unsigned offset = 1; offset <= queues.size(); offset++) {
+        WorkQueue &victim = *queues[(index + offset) % queues.size()];
+        std::unique_lock lock(victim.mutex);
+        auto &tasks = victim.tasks[laneIndex];
+        if (tasks.empty()) continue;
+
+        Job job = std::move(tasks.front());
+        tasks.pop_front();
+        lanes[laneIndex].i_pendingWork--;
+        return job;
+    }
+    return std::nullopt;
+}
+
+void ThreadPool::State::execute(Job &job, Lane lane, unsigned threadID)
+{
+    LaneState &laneState = lanes[static_cast<std::size_t>(lane)];
+    const std::uint64_t latency =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - job.pushTime).count();
+    laneState.i_startedJobs++;
+    laneState.i_totalLatency += latency;
+    auto max = laneState.i_maxLatency.load(std::memory_order_relaxed);
+    while (max < latency && !laneState.i_maxLatency.compare_exchange_weak(max, latency)) {}
+
+    if (job.work) job.work(threadID);
+}
+
+bool ThreadPool::State::runBackgroundJob(unsigned index, unsigned threadID)
+{
+    if (!acquireBackgroundSlot()) return false;
+    struct SlotGuard {
+        State &state;
+        ~SlotGuard() { state.releaseBackgroundSlot(); }
+    } guard{*this};
+
+    auto job = dequeue(index, Lane::Background);
+    if (!job) return false;
+    execute(*job, Lane::Background, threadID);
+    return true;
+}
+
+bool ThreadPool::State::acquireBackgroundSlot()
+{
+    auto running = i_backgroundWorkers.load();
+    do {
+        if (running >= i_maxBackgroundWorkers) return false;
+    } while (!i_backgroundWorkers.compare_exchange_weak(running, running + 1));
+    return true;
+}
+
+void ThreadPool::State::releaseBackgroundSlot()
+{
+    i_backgroundWorkers--;
+    // A worker may be sleeping because every slot was taken
+    if (i_sleepingWorkers > 0 && lanes[static_cast<std::size_t>(Lane::Background)].i_pendingWork > 0) wake(false);
+}
+
+bool ThreadPool::State::hasRunnableWork() const
+{
+    return lanes[static_cast<std::size_t>(Lane::Frame)].i_pendingWork > 0 ||
+           (lanes[static_cast<std::size_t>(Lane::Background)].i_pendingWork > 0 &&
+            i_backgroundWorkers < i_maxBackgroundWorkers);
+}
+
+void ThreadPool::State::reserve(unsigned size)
+{
+    std::unique_lock queuesLock(queues_mutex);
+    while (queues.size() < size) queues.push_back(std::make_unique<WorkQueue>());
+}
+
+void ThreadPool::State::wake(bool all)
+{
+    { std::unique_lock lock(q_mutex); }
+    if (all)
+        q_var.notify_all();
+    else
+        q_var.notify_one();
+}
+
+void ThreadPool::State::wakeAll() { wake(true); }
+
 std::atomic_int ThreadPool::WorkerPoolRuntime::i_threadIDCounter = 0;
 
-ThreadPool::WorkerPoolRuntime::WorkerPoolRuntime(std::shared_ptr<ThreadPool::State> context)
-    : i_threadID(0), b_requestExit(false), p_state(std::move(context))
+ThreadPool::WorkerPoolRuntime::WorkerPoolRuntime(std::shared_ptr<ThreadPool::State> context, unsigned queueIndex)
+    : i_threadID(0), i_queueIndex(queueIndex), b_requestExit(false), p_state(std::move(context))
 {
 }
 
 bool ThreadPool::WorkerPoolRuntime::init()
 {
     i_threadID = i_threadIDCounter++;
+    State::currentState = p_state.get();
+    State::currentQueue = i_queueIndex;
+    State::currentThreadID = i_threadID;
 #if !defined(NO_BENCHMARK)
     benchmark::Instrumentor::get().setThreadName("Worker Thread " + std::to_string(i_threadID));
 #endif
@@ -50,22 +249,19 @@ bool ThreadPool::WorkerPoolRuntime::init()
 
 std::uint32_t ThreadPool::WorkerPoolRuntime::run()
 {
-    using namespace std::chrono_literals;
-    ThreadPool::WorkUnits work;
-
     while (!b_requestExit) {
         try {
-            {
-                std::unique_lock lock(p_state->q_mutex);
-                if (p_state->qWork.empty()) p_state->q_var.wait_for(lock, 10ms);
-                /// lock is owned by this thread when .wait return
-
-                if (p_state->qWork.empty()) continue;
-
-                work = std::move(p_state->qWork.front());
-                p_state->qWork.pop();
+            // Frame work is checked before every background job, so it only waits for the jobs already started
+            if (auto job = p_state->dequeue(i_queueIndex, Lane::Frame)) {
+                p_state->execute(*job, Lane::Frame, i_threadID);
+                continue;
             }
-            if (work) work(i_threadID);
+            if (p_state->runBackgroundJob(i_queueIndex, i_threadID)) continue;
+
+            std::unique_lock lock(p_state->q_mutex);
+            p_state->i_sleepingWorkers++;
+            p_state->q_var.wait(lock, [this] { return b_requestExit || p_state->hasRunnableWork(); });
+            p_state->i_sleepingWorkers--;
         } catch (const std::exception &e) {
             logger.err("Thread Pool") << i_threadID << " : " << e.what();
         } catch (...) {
@@ -75,8 +271,16 @@ std::uint32_t ThreadPool::WorkerPoolRuntime::run()
     return 0;
 }
 
-void ThreadPool::WorkerPoolRuntime::stop() { b_requestExit = true; }
+void ThreadPool::WorkerPoolRuntime::stop()
+{
+    b_requestExit = true;
+    p_state->wakeAll();
+}
 
-void ThreadPool::WorkerPoolRuntime::exit() { b_requestExit = true; }
+void ThreadPool::WorkerPoolRuntime::exit()
+{
+    b_requestExit = true;
+    State::currentState = nullptr;
+}
 
 }    // namespace pivot
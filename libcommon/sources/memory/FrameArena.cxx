@@ -0,0 +1,37 @@
+#include "pivot/memory/FrameArena.hxx"
+
+#include <atomic>
+
+namespace pivot::memory
+{
+
+namespace
+{
+    std::atomic_uint64_t currentFrame = 0;
+
+    /// The arenas of a thread, one is used by the current frame while the other keeps the previous frame alive
+    struct ThreadArenas {
+        MonotonicArena arenas[2];
+        std::uint64_t frame = 0;
+    };
+    thread_local ThreadArenas threadArenas;
+}    // namespace
+
+MonotonicArena *FrameArena::get()
+{
+    auto &local = threadArenas;
+    const auto frame = currentFrame.load(std::memory_order_relaxed);
+    if (frame != local.frame) {
+        // The other arena is only kept if it holds the previous frame
+        if (frame - local.frame > 1) local.arenas[(frame + 1) % 2].reset();
+        local.arenas[frame % 2].reset();
+        local.frame = frame;
+    }
+    return &local.arenas[frame % 2];
+}
+
+void FrameArena::nextFrame() noexcept { currentFrame.fetch_add(1, std::memory_order_relaxed); }
+
+std::uint64_t FrameArena::getFrame() noexcept { return currentFrame.load(std::memory_order_relaxed); }
+
+}    // namespace pivot::memory
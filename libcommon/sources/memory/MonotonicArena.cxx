@@ -0,0 +1,85 @@
+#include "pivot/memory/MonotonicArena.hxx"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace pivot::memory
+{
+
+static constexpr std::size_t blockAlignment = alignof(std::max_align_t);
+
+MonotonicArena::MonotonicArena(std::size_t initialSize, std::pmr::memory_resource *upstream)
+    : upstream(upstream), nextBlockSize(std::max<std::size_t>(initialSize, blockAlignment))
+{
+}
+
+MonotonicArena::~MonotonicArena() { release(); }
+
+void MonotonicArena::reset()
+{
+    if (blocks.size() > 1) {
+        // Merge the blocks, so that a frame as large as this one fits in a single block
+        const auto capacity = getCapacity();
+        release();
+        addBlock(capacity);
+    }
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+void MonotonicArena::release()
+{
+    for (const auto &block: blocks) upstream->deallocate(block.data, block.size, blockAlignment);
+    if (!blocks.empty()) nextBlockSize = blocks.back().size;
+    blocks.clear();
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+std::size_t MonotonicArena::getCapacity() const noexcept
+{
+    std::size_t capacity = 0;
+    for (const auto &block: blocks) capacity += block.size;
+    return capacity;
+}
+
+void *MonotonicArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    while (true) {
+        if (current < blocks.size()) {
+            const auto &block = blocks[current];
+            const auto address = reinterpret_cast<std::uintptr_t>(block.data) + offset;
+            const auto padding = (alignment - address % alignment) % alignment;
+            if (offset + padding + bytes <= block.size) {
+                offset += padding + bytes;
+                return block.data + offset - bytes;
+            }
+            if (current + 1 < blocks.size()) {
+                used += offset;
+                offset = 0;
+                current++;
+                continue;
+            }
+        }
+        addBlock(bytes + alignment);
+        if (current < blocks.size() - 1) {
+            used += offset;
+            offset = 0;
+            current = blocks.size() - 1;
+        }
+    }
+}
+
+void MonotonicArena::addBlock(std::size_t minimumSize)
+{
+    const auto size = std::max(nextBlockSize, minimumSize);
+    blocks.push_back({
+        .data = static_cast<std::byte *>(upstream->allocate(size, blockAlignment)),
+        .size = size,
+    });
+    nextBlockSize = size * 2;
+}
+
+}    // namespace pivot::memory
@@ -0,0 +1,57 @@
+#include "pivot/memory/PoolResource.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace pivot::memory
+{
+
+PoolResource::PoolResource(std::pmr::memory_resource *upstream): upstream(upstream) {}
+
+PoolResource::~PoolResource() { release(); }
+
+void PoolResource::release()
+{
+    for (auto *chunk: chunks) upstream->deallocate(chunk, chunkSize, alignof(std::max_align_t));
+    chunks.clear();
+    freeLists.fill(nullptr);
+}
+
+void *PoolResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (bytes > maxBlockSize || alignment > alignof(std::max_align_t)) return upstream->allocate(bytes, alignment);
+
+    const auto sizeClass = getSizeClass(bytes);
+    if (freeLists[sizeClass] == nullptr) refill(sizeClass);
+    auto *block = freeLists[sizeClass];
+    freeLists[sizeClass] = block->next;
+    return block;
+}
+
+void PoolResource::do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment)
+{
+    if (bytes > maxBlockSize || alignment > alignof(std::max_align_t))
+        return upstream->deallocate(ptr, bytes, alignment);
+
+    const auto sizeClass = getSizeClass(bytes);
+    freeLists[sizeClass] = new (ptr) FreeBlock{freeLists[sizeClass]};
+}
+
+std::size_t PoolResource::getSizeClass(std::size_t bytes) noexcept
+{
+    // 16 bytes and less are class 0, 17 to 32 bytes are class 1, ...
+    return std::bit_width((std::max(bytes, minBlockSize) - 1) / minBlockSize);
+}
+
+void PoolResource::refill(std::size_t sizeClass)
+{
+    const auto blockSize = minBlockSize << sizeClass;
+    auto *chunk = static_cast<std::byte *>(upstream->allocate(chunkSize, alignof(std::max_align_t)));
+    chunks.push_back(chunk);
+    // Link the blocks backward, so that they are handed out in address order
+    for (auto index = chunkSize / blockSize; index > 0; index--)
+        freeLists[sizeClass] = new (chunk + (index - 1) * blockSize) FreeBlock{freeLists[sizeClass]};
+}
+
+}    // namespace pivot::memory
@@ -0,0 +1,102 @@
+#include "pivot/utility/MappedFile.hxx"
+
+#include "pivot/debug.hxx"
+
+#include <cstring>
+#include <utility>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace pivot
+{
+
+#if defined(PLATFORM_WINDOWS)
+
+MappedFile::MappedFile(const std::filesystem::path &path)
+{
+    HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw MappedFileError("Can't open " + path.string() + ": error " + std::to_string(::GetLastError()));
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size)) {
+        ::CloseHandle(file);
+        throw MappedFileError("Can't read the size of " + path.string());
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    // Empty files can't be mapped
+    if (m_size == 0) {
+        ::CloseHandle(file);
+        return;
+    }
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr) throw MappedFileError("Can't map " + path.string());
+    m_data = static_cast<const std::byte *>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    // The view keeps the mapping alive
+    ::CloseHandle(mapping);
+    if (m_data == nullptr) throw MappedFileError("Can't map " + path.string());
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (m_data) ::UnmapViewOfFile(m_data);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path &path)
+{
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file == -1) throw MappedFileError("Can't open " + path.string() + ": " + std::strerror(errno));
+    struct stat status;
+    if (::fstat(file, &status) == -1) {
+        ::close(file);
+        throw MappedFileError("Can't read the size of " + path.string() + ": " + std::strerror(errno));
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+    // Empty files can't be mapped
+    if (m_size == 0) {
+        ::close(file);
+        return;
+    }
+    void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps the file alive
+    ::close(file);
+    if (data == MAP_FAILED) throw MappedFileError("Can't map " + path.string() + ": " + std::strerror(errno));
+    m_data = static_cast<const std::byte *>(data);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (m_data) ::munmap(const_cast<std::byte *>(m_data), m_size);
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+}    // namespace pivot
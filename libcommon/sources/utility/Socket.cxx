@@ -0,0 +1,202 @@
+#include "pivot/utility/Socket.hxx"
+
+#include "pivot/debug.hxx"
+
+#include <cstring>
+#include <utility>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+
+    #pragma comment(lib, "Ws2_32.lib")
+#else
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace pivot
+{
+
+namespace
+{
+#if defined(PLATFORM_WINDOWS)
+    using NativeHandle = SOCKET;
+    constexpr int sendFlags = 0;
+
+    /// Winsock must be initialized before the first socket is created
+    struct WinsockInit {
+        WinsockInit()
+        {
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+        }
+        ~WinsockInit() { WSACleanup(); }
+    };
+    void initSockets() { static WinsockInit init; }
+    std::string lastError() { return "error " + std::to_string(WSAGetLastError()); }
+    void closeNative(NativeHandle handle) { ::closesocket(handle); }
+#else
+    using NativeHandle = int;
+    #if defined(MSG_NOSIGNAL)
+    // Don't kill the process with SIGPIPE when the peer is gone
+    constexpr int sendFlags = MSG_NOSIGNAL;
+    #else
+    constexpr int sendFlags = 0;
+    #endif
+
+    void initSockets() {}
+    std::string lastError() { return std::strerror(errno); }
+    void closeNative(NativeHandle handle) { ::close(handle); }
+#endif
+
+    NativeHandle native(Socket::Handle handle) { return static_cast<NativeHandle>(handle); }
+
+    /// Resolve the address, and call function on each result until it returns true
+    template <typename Function>
+    void forEachAddress(const std::string &host, std::uint16_t port, bool passive, Function &&function)
+    {
+        initSockets();
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        if (passive) hints.ai_flags = AI_PASSIVE;
+
+        addrinfo *results = nullptr;
+        const std::string service = std::to_string(port);
+        if (int error = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &results); error != 0)
+            throw Socket::SocketError("Can't resolve " + host + ": " + ::gai_strerror(error));
+
+        for (addrinfo *info = results; info != nullptr; info = info->ai_next) {
+            if (function(*info)) break;
+        }
+        ::freeaddrinfo(results);
+    }
+}    // namespace
+
+Socket Socket::connect(const std::string &host, std::uint16_t port)
+{
+    Handle connected = invalidHandle;
+    std::string error = "no address found";
+    forEachAddress(host, port, false, [&](const addrinfo &info) {
+        NativeHandle handle = ::socket(info.ai_family, info.ai_socktype, info.ai_protocol);
+        if (handle == native(invalidHandle)) {
+            error = lastError();
+            return false;
+        }
+        if (::connect(handle, info.ai_addr, static_cast<int>(info.ai_addrlen)) != 0) {
+            error = lastError();
+            closeNative(handle);
+            return false;
+        }
+        // Small messages are batched by the caller, don't delay them any further
+        int noDelay = 1;
+        ::setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&noDelay), sizeof(noDelay));
+        connected = static_cast<Handle>(handle);
+        return true;
+    });
+    if (connected == invalidHandle)
+        throw SocketError("Can't connect to " + host + ":" + std::to_string(port) + ": " + error);
+    return Socket(connected);
+}
+
+Socket Socket::listen(std::uint16_t port, const std::string &address)
+{
+    Handle listening = invalidHandle;
+    std::string error = "no address found";
+    forEachAddress(address, port, true, [&](const addrinfo &info) {
+        NativeHandle handle = ::socket(info.ai_family, info.ai_socktype, info.ai_protocol);
+        if (handle == native(invalidHandle)) {
+            error = lastError();
+            return false;
+        }
+        int reuse = 1;
+        ::setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&reuse), sizeof(reuse));
+        if (::bind(handle, info.ai_addr, static_cast<int>(info.ai_addrlen)) != 0 || ::listen(handle, 4) != 0) {
+            error = lastError();
+            closeNative(handle);
+            return false;
+        }
+        listening = static_cast<Handle>(handle);
+        return true;
+    });
+    if (listening == invalidHandle)
+        throw SocketError("Can't listen on " + address + ":" + std::to_string(port) + ": " + error);
+    return Socket(listening);
+}
+
+Socket::Socket(Socket &&other) noexcept: handle(std::exchange(other.handle, invalidHandle)) {}
+
+Socket &Socket::operator=(Socket &&other) noexcept
+{
+    if (this != &other) {
+        close();
+        handle = std::exchange(other.handle, invalidHandle);
+    }
+    return *this;
+}
+
+Socket::~Socket() { close(); }
+
+Socket Socket::accept()
+{
+    if (!isOpen()) throw SocketError("Can't accept on a closed socket");
+    NativeHandle client = ::accept(native(handle), nullptr, nullptr);
+    if (client == native(invalidHandle)) throw SocketError("Accept failed: " + lastError());
+    return Socket(static_cast<Handle>(client));
+}
+
+bool Socket::send(std::span<const std::byte> data)
+{
+    if (!isOpen()) return false;
+    while (!data.empty()) {
+        auto sent = ::send(native(handle), reinterpret_cast<const char *>(data.data()), static_cast<int>(data.size()),
+                           sendFlags);
+        if (sent <= 0) return false;
+        data = data.subspan(sent);
+    }
+    return true;
+}
+
+std::size_t Socket::receive(std::span<std::byte> buffer)
+{
+    if (!isOpen()) return 0;
+    auto received =
+        ::recv(native(handle), reinterpret_cast<char *>(buffer.data()), static_cast<int>(buffer.size()), 0);
+    return (received > 0) ? (static_cast<std::size_t>(received)) : (0);
+}
+
+std::uint16_t Socket::getPort() const
+{
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    if (!isOpen() || ::getsockname(native(handle), reinterpret_cast<sockaddr *>(&address), &length) != 0) return 0;
+    if (address.ss_family == AF_INET6) return ntohs(reinterpret_cast<const sockaddr_in6 &>(address).sin6_port);
+    return ntohs(reinterpret_cast<const sockaddr_in &>(address).sin_port);
+}
+
+void Socket::shutdown() noexcept
+{
+    if (!isOpen()) return;
+#if defined(PLATFORM_WINDOWS)
+    ::shutdown(native(handle), SD_BOTH);
+#else
+    ::shutdown(native(handle), SHUT_RDWR);
+#endif
+}
+
+void Socket::close() noexcept
+{
+    if (!isOpen()) return;
+    shutdown();
+    closeNative(native(handle));
+    handle = invalidHandle;
+}
+
+}    // namespace pivot
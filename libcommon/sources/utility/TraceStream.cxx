@@ -0,0 +1,198 @@
+#include "pivot/utility/TraceStream.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+namespace pivot::benchmark::stream
+{
+
+namespace
+{
+    constexpr std::size_t messageHeaderSize = sizeof(std::uint8_t) + sizeof(std::uint32_t);
+    constexpr std::size_t streamHeaderSize = sizeof(magic) + sizeof(version);
+    /// Bigger messages are considered a corruption of the stream
+    constexpr std::uint32_t maxMessageSize = 1 << 16;
+
+    /// Read little endian values out of a message payload
+    class Reader
+    {
+    public:
+        Reader(std::span<const std::byte> data): data(data) {}
+
+        template <typename T>
+        T get()
+        {
+            if constexpr (std::is_same_v<T, double>) {
+                return std::bit_cast<double>(get<std::uint64_t>());
+            } else {
+                if (data.size() < sizeof(T)) throw Decoder::DecoderError("Truncated message");
+                T value = 0;
+                for (std::size_t i = 0; i < sizeof(T); i++)
+                    value |= T(std::to_integer<std::uint8_t>(data[i])) << (8 * i);
+                data = data.subspan(sizeof(T));
+                return value;
+            }
+        }
+        std::string getString()
+        {
+            const auto size = get<std::uint16_t>();
+            if (data.size() < size) throw Decoder::DecoderError("Truncated string");
+            std::string value(reinterpret_cast<const char *>(data.data()), size);
+            data = data.subspan(size);
+            return value;
+        }
+
+    private:
+        std::span<const std::byte> data;
+    };
+
+    template <typename T>
+    constexpr MessageType typeOf()
+    {
+        if constexpr (std::is_same_v<T, ZoneMessage>) return MessageType::Zone;
+        if constexpr (std::is_same_v<T, ThreadMessage>) return MessageType::Thread;
+        if constexpr (std::is_same_v<T, ScopeMessage>) return MessageType::Scope;
+        if constexpr (std::is_same_v<T, ValueMessage>) return MessageType::Value;
+        if constexpr (std::is_same_v<T, FrameMessage>) return MessageType::Frame;
+    }
+}    // namespace
+
+template <typename T>
+void Encoder::put(T value)
+{
+    if constexpr (std::is_same_v<T, double>) {
+        put(std::bit_cast<std::uint64_t>(value));
+    } else {
+        for (std::size_t i = 0; i < sizeof(T); i++) buffer.push_back(std::byte((value >> (8 * i)) & 0xff));
+    }
+}
+
+void Encoder::putString(const std::string &value)
+{
+    const auto size = static_cast<std::uint16_t>(std::min<std::size_t>(value.size(), UINT16_MAX));
+    put(size);
+    const auto *begin = reinterpret_cast<const std::byte *>(value.data());
+    buffer.insert(buffer.end(), begin, begin + size);
+}
+
+void Encoder::writeHeader()
+{
+    put(magic);
+    put(version);
+}
+
+void Encoder::write(const Message &message)
+{
+    std::visit(
+        [this](const auto &msg) {
+            using T = std::decay_t<decltype(msg)>;
+            put(static_cast<std::uint8_t>(typeOf<T>()));
+            // The size is patched once the payload is written
+            const std::size_t sizeOffset = buffer.size();
+            put(std::uint32_t(0));
+            const std::size_t payloadStart = buffer.size();
+
+            if constexpr (std::is_same_v<T, ZoneMessage>) {
+                put(msg.id);
+                put(static_cast<std::uint8_t>(msg.type));
+                putString(msg.name);
+            } else if constexpr (std::is_same_v<T, ThreadMessage>) {
+                put(msg.id);
+                putString(msg.name);
+            } else if constexpr (std::is_same_v<T, ScopeMessage>) {
+                put(msg.zone);
+                put(msg.thread);
+                put(msg.start);
+                put(msg.duration);
+            } else if constexpr (std::is_same_v<T, ValueMessage>) {
+                put(msg.zone);
+                put(msg.thread);
+                put(msg.timestamp);
+                put(msg.value);
+            } else if constexpr (std::is_same_v<T, FrameMessage>) {
+                put(msg.timestamp);
+            }
+
+            const auto payloadSize = static_cast<std::uint32_t>(buffer.size() - payloadStart);
+            for (std::size_t i = 0; i < sizeof(payloadSize); i++)
+                buffer[sizeOffset + i] = std::byte((payloadSize >> (8 * i)) & 0xff);
+        },
+        message);
+}
+
+void Decoder::feed(std::span<const std::byte> data)
+{
+    // Drop the bytes already parsed before growing the buffer
+    if (offset > 0 && offset == buffer.size()) {
+        buffer.clear();
+        offset = 0;
+    } else if (offset > buffer.size() / 2) {
+        buffer.erase(buffer.begin(), buffer.begin() + offset);
+        offset = 0;
+    }
+    buffer.insert(buffer.end(), data.begin(), data.end());
+}
+
+std::optional<Message> Decoder::next()
+{
+    while (true) {
+        std::span<const std::byte> pending = std::span(buffer).subspan(offset);
+        if (!b_headerRead) {
+            if (pending.size() < streamHeaderSize) return std::nullopt;
+            Reader reader(pending);
+            if (reader.get<std::uint32_t>() != magic) throw DecoderError("Not a pivot trace stream");
+            if (auto streamVersion = reader.get<std::uint16_t>(); streamVersion != version)
+                throw DecoderError("Unsupported trace stream version " + std::to_string(streamVersion));
+            offset += streamHeaderSize;
+            b_headerRead = true;
+            continue;
+        }
+
+        if (pending.size() < messageHeaderSize) return std::nullopt;
+        Reader header(pending);
+        const auto type = static_cast<MessageType>(header.get<std::uint8_t>());
+        const auto size = header.get<std::uint32_t>();
+        if (size > maxMessageSize) throw DecoderError("Message too big: " + std::to_string(size) + " bytes");
+        if (pending.size() < messageHeaderSize + size) return std::nullopt;
+        offset += messageHeaderSize + size;
+
+        Reader reader(pending.subspan(messageHeaderSize, size));
+        switch (type) {
+            case MessageType::Zone: {
+                ZoneMessage msg;
+                msg.id = reader.get<std::uint32_t>();
+                msg.type = static_cast<ZoneType>(reader.get<std::uint8_t>());
+                msg.name = reader.getString();
+                return msg;
+            }
+            case MessageType::Thread: {
+                ThreadMessage msg;
+                msg.id = reader.get<std::uint32_t>();
+                msg.name = reader.getString();
+                return msg;
+            }
+            case MessageType::Scope: {
+                ScopeMessage msg;
+                msg.zone = reader.get<std::uint32_t>();
+                msg.thread = reader.get<std::uint32_t>();
+                msg.start = reader.get<std::uint64_t>();
+                msg.duration = reader.get<std::uint64_t>();
+                return msg;
+            }
+            case MessageType::Value: {
+                ValueMessage msg;
+                msg.zone = reader.get<std::uint32_t>();
+                msg.thread = reader.get<std::uint32_t>();
+                msg.timestamp = reader.get<std::uint64_t>();
+                msg.value = reader.get<double>();
+                return msg;
+            }
+            case MessageType::Frame: return FrameMessage{reader.get<std::uint64_t>()};
+        }
+        // Unknown message, sent by a newer version of the protocol
+    }
+}
+
+}    // namespace pivot::benchmark::stream
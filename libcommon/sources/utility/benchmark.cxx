@@ -1,64 +1,511 @@
 #include "pivot/utility/benchmark.hxx"
+#include "pivot/utility/Socket.hxx"
+#include "pivot/utility/TraceStream.hxx"
 
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
 #include <iomanip>
+#include <numeric>
+#include <unordered_set>
 
 namespace pivot::benchmark
 {
 
+/// Single producer (the owning thread), single consumer (the writer) ring of results
+struct Instrumentor::ThreadBuffer {
+    /// Must be a power of two
+    static constexpr std::size_t capacity = 1 << 14;
+
+    std::unique_ptr<TimerResult[]> results = std::make_unique<TimerResult[]>(capacity);
+    /// Next slot written by the owning thread
+    alignas(64) std::atomic_size_t head = 0;
+    /// Next slot read by the writer
+    alignas(64) std::atomic_size_t tail = 0;
+    std::atomic_size_t dropped = 0;
+    /// Set when the owning thread exited, so the buffer can be given to a new thread once drained
+    std::atomic_bool released = false;
+    /// Only changed while the buffer is empty, before the owning thread pushes anything
+    std::thread::id threadId;
+
+    bool push(const TimerResult &result)
+    {
+        const std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - tail.load(std::memory_order_acquire) >= capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        results[currentHead & (capacity - 1)] = result;
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/// Connection to a trace receiver
+struct Instrumentor::StreamState {
+    Socket socket;
+    stream::Encoder encoder;
+    /// Zones and threads already described to the receiver
+    std::unordered_set<const Zone *> zones;
+    std::unordered_map<std::thread::id, std::uint32_t> threads;
+};
+
+/// Periodically drain the thread buffers into the session file
+class Instrumentor::WriterRuntime : public internal::IThreadRuntime
+{
+public:
+    WriterRuntime(Instrumentor &instrumentor): instrumentor(instrumentor) {}
+
+    bool init() override
+    {
+        instrumentor.setThreadName("Trace writer");
+        return true;
+    }
+    std::uint32_t run() override
+    {
+        using namespace std::chrono_literals;
+        std::unique_lock lock(mutex);
+        while (!b_requestExit) {
+            var.wait_for(lock, 5ms);
+            lock.unlock();
+            instrumentor.drainBuffers();
+            lock.lock();
+        }
+        return 0;
+    }
+    void stop() override
+    {
+        {
+            std::unique_lock lock(mutex);
+            b_requestExit = true;
+        }
+        var.notify_all();
+    }
+    void exit() override { b_requestExit = true; }
+
+private:
+    Instrumentor &instrumentor;
+    std::mutex mutex;
+    std::condition_variable var;
+    bool b_requestExit = false;
+};
+
+namespace
+{
+    /// Amount of encoded bytes sent to the trace receiver at once
+    constexpr std::size_t maxStreamBatchSize = 64 * 1024;
+
+    /// Give the buffer back when the thread exits
+    struct ThreadBufferHandle {
+        ~ThreadBufferHandle()
+        {
+            if (buffer) *released = true;
+        }
+        void *buffer = nullptr;
+        std::atomic_bool *released = nullptr;
+    };
+    thread_local ThreadBufferHandle currentBuffer;
+}    // namespace
+
 Instrumentor::Instrumentor() {}
 
 Instrumentor::~Instrumentor()
 {
     if (isSessionStarted()) endSession();
+    if (isStatisticsEnabled()) disableStatistics();
+    if (isStreaming()) endStreaming();
 }
 
 void Instrumentor::beginSession(const std::string &filename)
 {
-    outputStream.open(filename);
-    writeHeader();
+    std::unique_lock controlLock(controlMutex);
+    // Discard what was recorded while nothing was listening
+    if (!isRecording()) discardBuffers();
+    {
+        std::unique_lock lock(outputMutex);
+        outputStream.open(filename);
+        writeHeader();
+    }
+    recordingFlags |= Session;
+    updateWriter();
 }
 
 void Instrumentor::endSession()
 {
+    std::unique_lock controlLock(controlMutex);
     if (!verify(isSessionStarted())) return;
-    writeFooter();
-    outputStream.close();
-    profileCount = 0;
+    recordingFlags &= ~Session;
+    drainBuffers();
+    {
+        std::unique_lock lock(outputMutex);
+        writeFooter();
+        outputStream.close();
+        profileCount = 0;
+    }
+    updateWriter();
+    if (auto dropped = getDroppedCount(); dropped > 0)
+        logger.warn("Instrumentor") << dropped << " results were dropped, the thread buffers were full";
 }
 
-bool Instrumentor::isSessionStarted() const { return outputStream.is_open(); }
+bool Instrumentor::isSessionStarted() const { return recordingFlags.load(std::memory_order_relaxed) & Session; }
 
 void Instrumentor::writeResult(const TimerResult &result)
 {
-    if (!verifyMsg(isSessionStarted(), "No session are started !")) return;
+    if (!verifyMsg(isRecording(), "No session are started !")) return;
+    getThreadBuffer().push(result);
+}
 
-    std::unique_lock lock(mutex);
-    if (profileCount++ > 0) outputStream << ",";
+const Zone &Instrumentor::getZone(std::string_view name)
+{
+    std::unique_lock lock(zonesMutex);
+    auto iter = dynamicZones.find(name);
+    if (iter == dynamicZones.end()) {
+        iter = dynamicZones.emplace(std::string(name), nullptr).first;
+        // The key of a std::map is never moved, so it can back the name of the zone
+        iter->second = std::make_unique<Zone>(iter->first.c_str(), "", 0);
+    }
+    return *iter->second;
+}
 
-    std::string name = result.name;
-    std::replace(name.begin(), name.end(), '"', '\'');
+void Instrumentor::flush()
+{
+    if (isRecording()) drainBuffers();
+}
 
-    // No need to do fancy json serialization, we want to be as fast as possible
-    outputStream << "{\"cat\":\"function\",\"dur\":" << (result.end_timestamp - result.start_timestamp)
-                 << ",\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":0,\"tid\": \"" << getThreadName(result.threadId)
-                 << "\",\"ts\":" << result.start_timestamp << "}";
+std::size_t Instrumentor::getDroppedCount() const
+{
+    std::unique_lock lock(buffersMutex);
+    std::size_t dropped = 0;
+    for (const auto &buffer: buffers) dropped += buffer->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
 
-    outputStream.flush();
+void Instrumentor::enableStatistics(std::size_t frameCount)
+{
+    verifyMsg(frameCount > 0, "Statistics must be computed on at least one frame");
+    std::unique_lock controlLock(controlMutex);
+    if (!isRecording()) discardBuffers();
+    {
+        std::unique_lock lock(statisticsMutex);
+        statisticsFrameCount = std::max<std::size_t>(frameCount, 1);
+        statistics.clear();
+        frameIndex = 0;
+    }
+    recordingFlags |= Statistics;
+    updateWriter();
+}
+
+void Instrumentor::disableStatistics()
+{
+    std::unique_lock controlLock(controlMutex);
+    recordingFlags &= ~Statistics;
+    updateWriter();
+    {
+        std::unique_lock lock(outputMutex);
+        currentFrame.clear();
+    }
+    std::unique_lock lock(statisticsMutex);
+    statistics.clear();
+}
+
+bool Instrumentor::isStatisticsEnabled() const { return recordingFlags.load(std::memory_order_relaxed) & Statistics; }
+
+void Instrumentor::endFrame()
+{
+    static constinit const Zone frameZone("Frame", __FILE__, __LINE__, ZoneType::Frame);
+    recordValue(frameZone, 0);
+}
+
+std::vector<ZoneStatistics> Instrumentor::getStatistics() const
+{
+    std::vector<ZoneStatistics> result;
+    {
+        std::unique_lock lock(statisticsMutex);
+        result.reserve(statistics.size());
+        for (const auto &[zone, history]: statistics) result.push_back(computeStatistics(*zone, history));
+    }
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) { return a.name < b.name; });
+    return result;
+}
+
+std::optional<ZoneStatistics> Instrumentor::getStatistics(std::string_view zoneName) const
+{
+    std::unique_lock lock(statisticsMutex);
+    for (const auto &[zone, history]: statistics)
+        if (zone->name == zoneName) return computeStatistics(*zone, history);
+    return std::nullopt;
+}
+
+bool Instrumentor::beginStreaming(const std::string &host, std::uint16_t port)
+{
+    std::unique_lock controlLock(controlMutex);
+    if (!verifyMsg(!isStreaming(), "Already streaming !")) return true;
+
+    auto state = std::make_unique<StreamState>();
+    try {
+        state->socket = Socket::connect(host, port);
+    } catch (const Socket::SocketError &error) {
+        logger.warn("Instrumentor") << error.what();
+        return false;
+    }
+    state->encoder.writeHeader();
+    if (!isRecording()) discardBuffers();
+    {
+        std::unique_lock lock(outputMutex);
+        stream = std::move(state);
+    }
+    recordingFlags |= Streaming;
+    updateWriter();
+    logger.info("Instrumentor") << "Streaming the profiling results to " << host << ":" << port;
+    return true;
+}
+
+void Instrumentor::endStreaming()
+{
+    std::unique_lock controlLock(controlMutex);
+    if (!isStreaming()) return;
+    drainBuffers();
+    recordingFlags &= ~Streaming;
+    {
+        std::unique_lock lock(outputMutex);
+        stream.reset();
+    }
+    updateWriter();
+}
+
+bool Instrumentor::isStreaming() const { return recordingFlags.load(std::memory_order_relaxed) & Streaming; }
+
+Instrumentor::ThreadBuffer &Instrumentor::getThreadBuffer()
+{
+    if (LIKELY(currentBuffer.buffer != nullptr)) return *static_cast<ThreadBuffer *>(currentBuffer.buffer);
+
+    std::unique_lock lock(buffersMutex);
+    std::shared_ptr<ThreadBuffer> buffer;
+    for (auto &candidate: buffers) {
+        if (candidate->released && candidate->head == candidate->tail) {
+            candidate->released = false;
+            buffer = candidate;
+            break;
+        }
+    }
+    if (!buffer) buffer = buffers.emplace_back(std::make_shared<ThreadBuffer>());
+    buffer->threadId = std::this_thread::get_id();
+    currentBuffer.buffer = buffer.get();
+    currentBuffer.released = &buffer->released;
+    return *buffer;
+}
+
+void Instrumentor::updateWriter()
+{
+    if (isRecording() && !b_writerRunning) {
+        writerThread.create("Trace writer", std::make_unique<WriterRuntime>(*this));
+        b_writerRunning = true;
+    } else if (!isRecording() && b_writerRunning) {
+        writerThread.end();
+        b_writerRunning = false;
+    }
+}
+
+void Instrumentor::discardBuffers()
+{
+    std::unique_lock lock(buffersMutex);
+    for (auto &buffer: buffers) {
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+        buffer->dropped = 0;
+    }
+}
+
+void Instrumentor::drainBuffers()
+{
+    struct PendingRange {
+        ThreadBuffer *buffer;
+        std::size_t tail;
+        std::size_t head;
+    };
+
+    std::vector<std::shared_ptr<ThreadBuffer>> toDrain;
+    {
+        std::unique_lock lock(buffersMutex);
+        toDrain = buffers;
+    }
+
+    std::unique_lock lock(outputMutex);
+    const bool writeTrace = outputStream.is_open();
+    const bool computeFrames = isStatisticsEnabled();
+    StreamState *const streaming = stream.get();
+
+    std::vector<PendingRange> ranges;
+    std::vector<std::uint64_t> frameEnds;
+    for (auto &buffer: toDrain) {
+        const std::size_t head = buffer->head.load(std::memory_order_acquire);
+        const std::size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        if (tail == head) continue;
+        ranges.push_back({buffer.get(), tail, head});
+        if (!computeFrames) continue;
+        for (std::size_t i = tail; i != head; i++) {
+            const TimerResult &result = buffer->results[i & (ThreadBuffer::capacity - 1)];
+            if (result.zone->type == ZoneType::Frame) frameEnds.push_back(result.start_timestamp);
+        }
+    }
+    if (ranges.empty()) return;
+    std::sort(frameEnds.begin(), frameEnds.end());
+
+    // One accumulator per frame ended in this batch, plus the frame still running
+    std::vector<FrameValues> frames(computeFrames ? frameEnds.size() + 1 : 0);
+    if (computeFrames) frames.front() = std::move(currentFrame);
+
+    for (const auto &range: ranges) {
+        const std::thread::id threadId = range.buffer->threadId;
+        const std::string threadName = (writeTrace || streaming) ? getThreadName(threadId) : std::string();
+        std::uint32_t streamThread = 0;
+        if (streaming) {
+            auto [iter, inserted] =
+                streaming->threads.emplace(threadId, static_cast<std::uint32_t>(streaming->threads.size()));
+            if (inserted) streaming->encoder.write(stream::ThreadMessage{iter->second, threadName});
+            streamThread = iter->second;
+        }
+
+        for (std::size_t tail = range.tail; tail != range.head; tail++) {
+            const TimerResult &result = range.buffer->results[tail & (ThreadBuffer::capacity - 1)];
+            const Zone &zone = *result.zone;
+
+            if (streaming) {
+                if (zone.type == ZoneType::Frame) {
+                    streaming->encoder.write(stream::FrameMessage{result.start_timestamp});
+                } else {
+                    const std::string &name = getZoneName(zone);
+                    if (streaming->zones.insert(&zone).second)
+                        streaming->encoder.write(stream::ZoneMessage{zone.id, zone.type, name});
+                    if (zone.type == ZoneType::Scope)
+                        streaming->encoder.write(stream::ScopeMessage{zone.id, streamThread, result.start_timestamp,
+                                                                      result.end_timestamp - result.start_timestamp});
+                    else
+                        streaming->encoder.write(
+                            stream::ValueMessage{zone.id, streamThread, result.start_timestamp, result.value});
+                }
+            }
+            if (zone.type == ZoneType::Frame) continue;
+
+            if (computeFrames) {
+                const std::uint64_t timestamp =
+                    (zone.type == ZoneType::Scope) ? result.end_timestamp : result.start_timestamp;
+                auto &values = frames[std::lower_bound(frameEnds.begin(), frameEnds.end(), timestamp) -
+                                      frameEnds.begin()];
+                switch (zone.type) {
+                    case ZoneType::Scope: values[&zone] += result.end_timestamp - result.start_timestamp; break;
+                    case ZoneType::Counter: values[&zone] += result.value; break;
+                    case ZoneType::Gauge: values[&zone] = result.value; break;
+                    case ZoneType::Frame: break;
+                }
+            }
+            if (!writeTrace) continue;
+
+            if (profileCount++ > 0) outputStream << ",";
+            // No need to do fancy json serialization, we want to be as fast as possible
+            if (zone.type == ZoneType::Scope) {
+                outputStream << "{\"cat\":\"function\",\"dur\":" << (result.end_timestamp - result.start_timestamp)
+                             << ",\"name\":\"" << getZoneName(zone) << "\",\"ph\":\"X\",\"pid\":0,\"tid\": \""
+                             << threadName << "\",\"ts\":" << result.start_timestamp << "}";
+            } else {
+                outputStream << "{\"cat\":\"counter\",\"name\":\"" << getZoneName(zone)
+                             << "\",\"ph\":\"C\",\"pid\":0,\"tid\": \"" << threadName
+                             << "\",\"ts\":" << result.start_timestamp << ",\"args\":{\"value\":" << result.value
+                             << "}}";
+            }
+        }
+        range.buffer->tail.store(range.head, std::memory_order_release);
+        // Keep the encoded data bounded, whatever the amount of results
+        if (streaming && streaming->encoder.size() >= maxStreamBatchSize) sendStream(*streaming);
+    }
+    if (writeTrace) outputStream.flush();
+    if (streaming) sendStream(*streaming);
+
+    if (computeFrames) {
+        for (std::size_t i = 0; i + 1 < frames.size(); i++) closeFrame(frames[i]);
+        currentFrame = std::move(frames.back());
+    }
+}
+
+void Instrumentor::sendStream(StreamState &state)
+{
+    if (state.encoder.size() == 0 || !state.socket.isOpen()) return;
+    if (!state.socket.send(state.encoder.data())) {
+        // The results are dropped until endStreaming() is called
+        logger.warn("Instrumentor") << "The trace receiver disconnected, streaming stopped";
+        state.socket.close();
+    }
+    state.encoder.clear();
+}
+
+void Instrumentor::closeFrame(const FrameValues &values)
+{
+    std::unique_lock lock(statisticsMutex);
+    frameIndex++;
+    for (const auto &[zone, value]: values) {
+        auto &history = statistics[zone];
+        history.values.push_back((zone->type == ZoneType::Scope) ? value / 1'000'000.0 : value);
+        history.lastRecordedFrame = frameIndex;
+    }
+    for (auto iter = statistics.begin(); iter != statistics.end();) {
+        auto &[zone, history] = *iter;
+        if (history.lastRecordedFrame != frameIndex) {
+            // Forget the zones that were not recorded during the whole window
+            if (frameIndex - history.lastRecordedFrame >= statisticsFrameCount) {
+                iter = statistics.erase(iter);
+                continue;
+            }
+            history.values.push_back((zone->type == ZoneType::Gauge) ? history.values.back() : 0.0);
+        }
+        while (history.values.size() > statisticsFrameCount) history.values.pop_front();
+        ++iter;
+    }
+}
+
+ZoneStatistics Instrumentor::computeStatistics(const Zone &zone, const ZoneHistory &history) const
+{
+    std::vector<double> sorted(history.values.begin(), history.values.end());
+    std::sort(sorted.begin(), sorted.end());
+    // Nearest-rank percentile
+    auto percentile = [&sorted](double p) {
+        auto rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    };
+    return {
+        .name = zone.name,
+        .type = zone.type,
+        .frameCount = sorted.size(),
+        .min = sorted.front(),
+        .average = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size(),
+        .p95 = percentile(0.95),
+        .p99 = percentile(0.99),
+        .max = sorted.back(),
+    };
+}
+
+const std::string &Instrumentor::getZoneName(const Zone &zone)
+{
+    auto iter = zoneNames.find(&zone);
+    if (iter != zoneNames.end()) return iter->second;
+
+    if (zone.id == 0) zone.id = ++zoneCount;
+    std::string name = zone.name;
+    std::replace(name.begin(), name.end(), '"', '\'');
+    return zoneNames.emplace(&zone, std::move(name)).first->second;
 }
 
 std::string Instrumentor::getThreadName(const std::thread::id &id) const
 {
-    std::unique_lock lock(mutex);
+    std::unique_lock lock(namesMutex);
     return (thread_names.contains(id)) ? (thread_names.at(id)) : (std::to_string(std::hash<std::thread::id>()(id)));
 }
 void Instrumentor::setThreadName(const std::string &name, const std::thread::id &id)
 {
-    std::unique_lock lock(mutex);
+    std::unique_lock lock(namesMutex);
     thread_names[id] = name;
 }
 void Instrumentor::clearThreadName(const std::thread::id &id)
 {
-    std::unique_lock lock(mutex);
+    std::unique_lock lock(namesMutex);
     thread_names.erase(id);
 }
 
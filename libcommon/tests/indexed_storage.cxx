@@ -1,5 +1,10 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <chrono>
+#include <iostream>
+#include <ranges>
+
 #include "pivot/containers/IndexedStorage.hxx"
 
 using namespace pivot;
@@ -104,3 +109,118 @@ TEST_CASE("Indexed Storage", "[indexedStorage]")
         REQUIRE_FALSE(copy != storage);
     }
 }
+
+TEST_CASE("Indexed Storage erase", "[indexedStorage]")
+{
+    IndexedStorage<std::string, std::string> storage;
+    auto handle1 = storage.add(key1, value1);
+    storage.add(key2, value2);
+    auto handle3 = storage.add(pair3);
+    REQUIRE(storage.get(handle1) == value1);
+
+    // The last item takes the index of the erased one, the others are left untouched
+    storage.erase(key1);
+    REQUIRE(storage.size() == 2);
+    REQUIRE_FALSE(storage.contains(key1));
+    REQUIRE_FALSE(storage.contains(handle1));
+    REQUIRE(testIndex(storage, key2, value2, 1));
+    REQUIRE(testIndex(storage, key3, value3, 0));
+    REQUIRE(storage.get(handle3) == value3);
+    REQUIRE_THROWS_AS(storage.erase(key1), std::out_of_range);
+    REQUIRE_THROWS_AS(storage.get(key1), std::out_of_range);
+
+    storage.erase(storage.getHandle(key3));
+    REQUIRE_THROWS_AS(storage.erase(handle3), std::out_of_range);
+    REQUIRE(testIndex(storage, key2, value2, 0));
+    REQUIRE_FALSE(storage.getHandle(key3).isValid());
+
+    auto keys = storage | std::views::keys;
+    REQUIRE(std::vector(keys.begin(), keys.end()) == std::vector{key2});
+}
+
+namespace
+{
+/// The vector and map storage used before IndexedStorage was backed by a SlotMap
+template <typename Key, typename Value>
+class LegacyIndexedStorage
+{
+public:
+    void add(const Key &i, Value value)
+    {
+        if (index.contains(i)) throw std::runtime_error("Index already in use !");
+        storage.push_back(std::move(value));
+        index.emplace(i, storage.size() - 1);
+    }
+    void erase(const Key &key)
+    {
+        auto idx = getIndex(key);
+        if (idx == -1) throw std::out_of_range("Key not found !");
+        storage.erase(storage.begin() + idx);
+        index.erase(key);
+    }
+    std::optional<Key> getName(const std::size_t &idx) const
+    {
+        auto findResult =
+            std::find_if(index.begin(), index.end(), [&idx](const auto &pair) { return pair.second == idx; });
+        if (findResult != index.end()) return findResult->first;
+        return std::nullopt;
+    }
+    std::int32_t getIndex(const Key &i) const noexcept
+    {
+        if (index.contains(i))
+            return index.at(i);
+        else
+            return -1;
+    }
+    const Value &get(const Key &i) const { return storage.at(index.at(i)); }
+
+private:
+    std::vector<Value> storage;
+    std::unordered_map<Key, std::size_t> index;
+};
+
+template <typename Storage>
+void benchmarkStorage(const std::vector<std::string> &names)
+{
+    BENCHMARK_ADVANCED("add")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            Storage storage;
+            for (const auto &name: names) storage.add(name, name.size());
+            return storage.getIndex(names.back());
+        });
+    };
+
+    Storage storage;
+    for (const auto &name: names) storage.add(name, name.size());
+    BENCHMARK("get by name")
+    {
+        std::size_t sum = 0;
+        for (const auto &name: names) sum += storage.get(name);
+        return sum;
+    };
+    BENCHMARK("getName")
+    {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < names.size(); i += 16) sum += storage.getName(i)->size();
+        return sum;
+    };
+
+    // Only the first item is erased: the legacy storage leaves the other indexes stale after an erase. Timed by
+    // hand, as a copy of the storage is needed for each run.
+    std::vector<Storage> copies(256, storage);
+    auto start = std::chrono::steady_clock::now();
+    for (auto &copy: copies) copy.erase(names.front());
+    const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "erase first: " << elapsed.count() / copies.size() << " ns" << std::endl;
+}
+}    // namespace
+
+TEST_CASE("Indexed Storage against the legacy storage", "[.][benchmark][indexedStorage]")
+{
+    std::vector<std::string> names;
+    for (unsigned i = 0; i < 4096; i++) names.push_back("asset_" + std::to_string(i * 7919));
+
+    SECTION("Legacy vector and map") { benchmarkStorage<LegacyIndexedStorage<std::string, std::size_t>>(names); }
+    SECTION("Slot map") { benchmarkStorage<IndexedStorage<std::string, std::size_t>>(names); }
+}
@@ -0,0 +1,183 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+#include "pivot/utility/benchmark.hxx"
+
+using namespace pivot::benchmark;
+
+namespace
+{
+std::string readFile(const std::filesystem::path &path)
+{
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::size_t countOccurrences(const std::string &haystack, const std::string &needle)
+{
+    std::size_t count = 0;
+    for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) count++;
+    return count;
+}
+}    // namespace
+
+TEST_CASE("Instrumentor writes the results of every thread", "[instrumentor]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "pivot_instrumentor_test.json";
+    auto &instrumentor = Instrumentor::get();
+
+    instrumentor.beginSession(path.string());
+    REQUIRE(instrumentor.isSessionStarted());
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned t = 0; t < 4; t++) {
+            threads.emplace_back([t, &instrumentor] {
+                instrumentor.setThreadName("Test thread " + std::to_string(t));
+                for (unsigned i = 0; i < 1000; i++) {
+                    Timer timer(instrumentor.getZone("scope \"" + std::to_string(i) + "\""));
+                }
+            });
+        }
+    }
+    instrumentor.endSession();
+    REQUIRE_FALSE(instrumentor.isSessionStarted());
+
+    const std::string trace = readFile(path);
+    REQUIRE(trace.starts_with("{\"otherData\": {},\"traceEvents\":["));
+    REQUIRE(trace.ends_with("]}"));
+    REQUIRE(countOccurrences(trace, "\"ph\":\"X\"") == 4000);
+    REQUIRE(countOccurrences(trace, "\"tid\": \"Test thread 2\"") == 1000);
+    REQUIRE(countOccurrences(trace, "\"name\":\"scope '999'\"") == 4);
+
+    // Nothing is recorded outside of a session
+    { PROFILE_SCOPE("outside of the session"); }
+    instrumentor.beginSession(path.string());
+    instrumentor.endSession();
+    REQUIRE(countOccurrences(readFile(path), "\"ph\":\"X\"") == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Instrumentor writes counters and gauges", "[instrumentor]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "pivot_instrumentor_counters.json";
+    auto &instrumentor = Instrumentor::get();
+    static constinit const Zone counter("test counter", __FILE__, __LINE__, ZoneType::Counter);
+    static constinit const Zone gauge("test gauge", __FILE__, __LINE__, ZoneType::Gauge);
+
+    instrumentor.beginSession(path.string());
+    instrumentor.recordValue(counter, 3);
+    instrumentor.recordValue(gauge, 0.5);
+    instrumentor.endFrame();
+    instrumentor.endSession();
+
+    const std::string trace = readFile(path);
+    REQUIRE(countOccurrences(trace, "\"ph\":\"C\"") == 2);
+    REQUIRE(countOccurrences(trace, "\"name\":\"test counter\"") == 1);
+    REQUIRE(countOccurrences(trace, "\"args\":{\"value\":0.5}") == 1);
+    // Frame markers are only used for the statistics
+    REQUIRE(countOccurrences(trace, "\"name\":\"Frame\"") == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Instrumentor computes per-frame statistics", "[instrumentor]")
+{
+    auto &instrumentor = Instrumentor::get();
+    static constinit const Zone scope("stats scope", __FILE__, __LINE__);
+    static constinit const Zone counter("stats counter", __FILE__, __LINE__, ZoneType::Counter);
+    static constinit const Zone gauge("stats gauge", __FILE__, __LINE__, ZoneType::Gauge);
+    static constinit const Zone sparse("stats sparse", __FILE__, __LINE__, ZoneType::Counter);
+
+    instrumentor.enableStatistics(10);
+    REQUIRE(instrumentor.isRecording());
+    REQUIRE_FALSE(instrumentor.isSessionStarted());
+    for (unsigned frame = 0; frame < 20; frame++) {
+        {
+            Timer timer(scope);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        instrumentor.recordValue(counter, 2);
+        instrumentor.recordValue(counter, 3);
+        instrumentor.recordValue(gauge, frame);
+        if (frame == 15) instrumentor.recordValue(sparse, 10);
+        instrumentor.endFrame();
+        // Frames may span several drains of the buffers
+        if (frame % 3 == 0) instrumentor.flush();
+    }
+    instrumentor.flush();
+
+    auto counterStats = instrumentor.getStatistics("stats counter");
+    REQUIRE(counterStats);
+    CHECK(counterStats->frameCount == 10);
+    CHECK(counterStats->min == 5);
+    CHECK(counterStats->max == 5);
+    CHECK(counterStats->average == 5);
+
+    auto gaugeStats = instrumentor.getStatistics("stats gauge");
+    REQUIRE(gaugeStats);
+    CHECK(gaugeStats->min == 10);
+    CHECK(gaugeStats->max == 19);
+    CHECK(gaugeStats->average == 14.5);
+    CHECK(gaugeStats->p95 == 19);
+
+    auto sparseStats = instrumentor.getStatistics("stats sparse");
+    REQUIRE(sparseStats);
+    CHECK(sparseStats->frameCount == 5);
+    CHECK(sparseStats->min == 0);
+    CHECK(sparseStats->max == 10);
+
+    auto scopeStats = instrumentor.getStatistics("stats scope");
+    REQUIRE(scopeStats);
+    CHECK(scopeStats->type == ZoneType::Scope);
+    CHECK(scopeStats->min >= 0.1);
+    CHECK(scopeStats->p99 <= scopeStats->max);
+    REQUIRE(instrumentor.getStatistics().size() == 4);
+
+    instrumentor.disableStatistics();
+    REQUIRE_FALSE(instrumentor.isRecording());
+    REQUIRE_FALSE(instrumentor.getStatistics("stats counter"));
+}
+
+TEST_CASE("Instrumentor scope overhead", "[.][benchmark][instrumentor]")
+{
+    constexpr unsigned batchSize = 1000;
+    constexpr unsigned batchCount = 200;
+    const auto path = std::filesystem::temp_directory_path() / "pivot_instrumentor_benchmark.json";
+    auto &instrumentor = Instrumentor::get();
+
+    static constinit const Zone zone("scope", __FILE__, __LINE__);
+    BENCHMARK("Scope without session") { Timer timer(zone); };
+
+    instrumentor.beginSession(path.string());
+    std::chrono::nanoseconds total(0);
+    for (unsigned batch = 0; batch < batchCount; batch++) {
+        // Start each batch with an empty buffer, so no result is dropped
+        instrumentor.flush();
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < batchSize; i++) Timer timer(zone);
+        total += std::chrono::steady_clock::now() - start;
+    }
+    REQUIRE(instrumentor.getDroppedCount() == 0);
+    instrumentor.endSession();
+    std::filesystem::remove(path);
+
+    // Cost of the two clock reads done by each timer, which depends on the platform rather than on the instrumentor
+    [[maybe_unused]] volatile long long sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < batchSize * batchCount; i++) {
+        auto begin = getTimestamp();
+        sink = getTimestamp() - begin;
+    }
+    const std::chrono::nanoseconds clockCost = std::chrono::steady_clock::now() - start;
+
+    const double nsPerScope = double(total.count()) / (batchSize * batchCount);
+    const double nsPerClock = double(clockCost.count()) / (batchSize * batchCount);
+    std::cout << "Recorded scope overhead: " << nsPerScope << " ns, " << nsPerScope - nsPerClock
+              << " ns without the clock reads" << std::endl;
+    CHECK(nsPerScope - nsPerClock < 50);
+}
@@ -0,0 +1,197 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "pivot/memory/AllocationCounter.hxx"
+#include "pivot/memory/FrameArena.hxx"
+#include "pivot/memory/MonotonicArena.hxx"
+#include "pivot/memory/PoolResource.hxx"
+
+using namespace pivot::memory;
+
+PIVOT_COUNT_ALLOCATIONS()
+
+TEST_CASE("Every form of operator new is counted", "[memory]")
+{
+    struct alignas(64) Aligned {
+        char bytes[64];
+    };
+
+    AllocationCounter counter;
+    std::vector<int> plain(4);
+    REQUIRE(counter.getCount() == 1);
+    std::vector<Aligned> aligned(4);
+    REQUIRE(counter.getCount() == 2);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(aligned.data()) % alignof(Aligned) == 0);
+
+    auto *array = new int[4];
+    auto *nothrow = new (std::nothrow) int(0);
+    auto *alignedArray = new Aligned[2];
+    auto *alignedNothrow = new (std::nothrow) Aligned;
+    REQUIRE(counter.getCount() == 6);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(alignedArray) % alignof(Aligned) == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(alignedNothrow) % alignof(Aligned) == 0);
+    delete[] array;
+    delete nothrow;
+    delete[] alignedArray;
+    delete alignedNothrow;
+}
+
+TEST_CASE("Monotonic arena", "[memory]")
+{
+    MonotonicArena arena(256);
+
+    auto *a = arena.allocate(10, 1);
+    auto *b = arena.allocate(32, 32);
+    REQUIRE(a != b);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 32 == 0);
+    REQUIRE(arena.getUsed() >= 42);
+
+    // Overflowing the first block allocates a new one, both are merged on reset
+    auto *large = arena.allocate(1000, 8);
+    REQUIRE(large != nullptr);
+    REQUIRE(arena.getCapacity() >= 1256);
+    const auto capacity = arena.getCapacity();
+    arena.reset();
+    REQUIRE(arena.getUsed() == 0);
+    REQUIRE(arena.getCapacity() == capacity);
+
+    AllocationCounter counter;
+    for (int frame = 0; frame < 10; frame++) {
+        std::pmr::vector<int> values(&arena);
+        for (int i = 0; i < 100; i++) values.push_back(i);
+        REQUIRE(values.back() == 99);
+        arena.reset();
+    }
+    REQUIRE(counter.getCount() == 0);
+
+    arena.release();
+    REQUIRE(arena.getCapacity() == 0);
+}
+
+TEST_CASE("Pool resource", "[memory]")
+{
+    PoolResource pool;
+
+    auto *a = pool.allocate(24, 8);
+    auto *b = pool.allocate(24, 8);
+    REQUIRE(a != b);
+    pool.deallocate(a, 24, 8);
+    REQUIRE(pool.allocate(30, 8) == a);
+    pool.deallocate(b, 24, 8);
+
+    // Large allocations are forwarded
+    auto *large = pool.allocate(PoolResource::maxBlockSize * 4, 16);
+    pool.deallocate(large, PoolResource::maxBlockSize * 4, 16);
+
+    std::pmr::map<int, std::array<char, 100>> map(&pool);
+    for (int i = 0; i < 100; i++) map[i];
+    map.clear();
+    AllocationCounter counter;
+    for (int repeat = 0; repeat < 10; repeat++) {
+        for (int i = 0; i < 100; i++) map[i];
+        map.clear();
+    }
+    REQUIRE(counter.getCount() == 0);
+}
+
+TEST_CASE("Frame arena keeps the previous frame alive", "[memory]")
+{
+    auto *arena = FrameArena::get();
+    REQUIRE(FrameArena::get() == arena);
+
+    std::pmr::vector<int> previous({1, 2, 3}, arena);
+    FrameArena::nextFrame();
+    auto *next = FrameArena::get();
+    REQUIRE(next != arena);
+    REQUIRE(next->getUsed() == 0);
+    std::pmr::vector<int> current({4, 5, 6}, next);
+    REQUIRE(previous == std::pmr::vector<int>{1, 2, 3});
+
+    FrameArena::nextFrame();
+    REQUIRE(FrameArena::get() == arena);
+    REQUIRE(arena->getUsed() == 0);
+}
+
+namespace
+{
+struct ObjectData {
+    std::array<float, 16> modelMatrix;
+    std::uint32_t textureIndex;
+    std::uint32_t materialIndex;
+};
+
+constexpr int objectCount = 1000;
+constexpr int lightCount = 20;
+constexpr int eventCount = 8;
+constexpr int entityCount = 50;
+
+/// The containers built every frame by the draw call resolver, the light resolver, the system manager and the script
+/// stack, before they were moved to the frame arena and the pools
+std::size_t legacyFrame()
+{
+    std::vector<ObjectData> objects;
+    for (int i = 0; i < objectCount; i++) objects.push_back({});
+    std::vector<std::array<float, 12>> lights;
+    for (int i = 0; i < lightCount; i++) lights.emplace_back();
+    std::vector<int> childEvents;
+    for (int i = 0; i < eventCount; i++) childEvents.push_back(i);
+    std::map<std::string, double> stack;
+    for (int entity = 0; entity < entityCount; entity++) {
+        stack.clear();
+        stack.insert_or_assign("entity", entity);
+        stack.insert_or_assign("payload", entity);
+    }
+    return objects.size() + lights.size() + childEvents.size() + stack.size();
+}
+
+std::size_t arenaFrame(PoolResource &stackPool)
+{
+    FrameArena::nextFrame();
+    std::pmr::vector<ObjectData> objects(FrameArena::get());
+    for (int i = 0; i < objectCount; i++) objects.push_back({});
+    std::pmr::vector<std::array<float, 12>> lights(FrameArena::get());
+    for (int i = 0; i < lightCount; i++) lights.emplace_back();
+    std::pmr::vector<int> childEvents(FrameArena::get());
+    for (int i = 0; i < eventCount; i++) childEvents.push_back(i);
+    std::pmr::map<std::string, double> stack(&stackPool);
+    for (int entity = 0; entity < entityCount; entity++) {
+        stack.clear();
+        stack.insert_or_assign("entity", entity);
+        stack.insert_or_assign("payload", entity);
+    }
+    return objects.size() + lights.size() + childEvents.size() + stack.size();
+}
+}    // namespace
+
+TEST_CASE("Frame containers stop allocating", "[memory]")
+{
+    PoolResource stackPool;
+    // Let the arenas and the pool grow, each arena merges its blocks on its second reset
+    for (int frame = 0; frame < 4; frame++) arenaFrame(stackPool);
+
+    AllocationCounter counter;
+    for (int frame = 0; frame < 10; frame++) arenaFrame(stackPool);
+    REQUIRE(counter.getCount() == 0);
+}
+
+TEST_CASE("Allocations per frame", "[.][benchmark][memory]")
+{
+    PoolResource stackPool;
+    for (int frame = 0; frame < 4; frame++) arenaFrame(stackPool);
+    constexpr int frames = 100;
+
+    AllocationCounter counter;
+    for (int frame = 0; frame < frames; frame++) legacyFrame();
+    std::cout << "Allocations per frame, heap containers: " << counter.getCount() / frames << std::endl;
+
+    counter.reset();
+    for (int frame = 0; frame < frames; frame++) arenaFrame(stackPool);
+    std::cout << "Allocations per frame, frame arena and pools: " << counter.getCount() / frames << std::endl;
+}
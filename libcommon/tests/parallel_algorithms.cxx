@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+#include <random>
+
+#include "pivot/Threading/ParallelAlgorithms.hxx"
+
+using namespace pivot;
+
+TEST_CASE("parallel_for visits every index once", "[parallel]")
+{
+    ThreadPool pool;
+    pool.start(4);
+
+    for (std::size_t grain: {0, 1, 7, 1000}) {
+        std::vector<std::atomic_int> visits(10000);
+        parallel_for(pool, 0, visits.size(), [&](std::size_t i) { visits[i]++; }, grain);
+        REQUIRE(std::all_of(visits.begin(), visits.end(), [](const auto &v) { return v == 1; }));
+    }
+}
+
+TEST_CASE("parallel_for works on ranges", "[parallel]")
+{
+    ThreadPool pool;
+    pool.start(3);
+
+    std::vector<int> values(5000);
+    std::iota(values.begin(), values.end(), 0);
+    parallel_for(pool, values, [](int &v) { v *= 2; });
+    for (int i = 0; i < 5000; i++) REQUIRE(values[i] == i * 2);
+
+    std::vector<int> empty;
+    parallel_for(pool, empty, [](int &) { FAIL("Called on an empty range"); });
+}
+
+TEST_CASE("parallel_for runs without any worker", "[parallel]")
+{
+    ThreadPool pool;
+    int sum = 0;
+    parallel_for(pool, 0, 100, [&](std::size_t i) { sum += i; });
+    REQUIRE(sum == 4950);
+}
+
+TEST_CASE("parallel_for can be nested", "[parallel]")
+{
+    ThreadPool pool;
+    pool.start(2);
+
+    std::atomic_int count = 0;
+    parallel_for(
+        pool, 0, 8, [&](std::size_t) { parallel_for(pool, 0, 100, [&](std::size_t) { count++; }, 10); }, 1);
+    REQUIRE(count == 800);
+}
+
+TEST_CASE("parallel_for rethrows exceptions", "[parallel]")
+{
+    ThreadPool pool;
+    pool.start(4);
+
+    REQUIRE_THROWS_AS(parallel_for(
+                          pool, 0, 1000,
+                          [](std::size_t i) {
+                              if (i == 500) throw std::runtime_error("chunk failure");
+                          },
+                          10),
+                      std::runtime_error);
+    // The pool must still be usable
+    REQUIRE(pool.push([](unsigned) { return 1; }).get() == 1);
+}
+
+TEST_CASE("parallel_reduce", "[parallel]")
+{
+    ThreadPool pool;
+    pool.start(4);
+
+    std::vector<std::uint64_t> values(100000);
+    std::iota(values.begin(), values.end(), 1);
+    REQUIRE(parallel_reduce(pool, values, std::uint64_t(0), std::plus<>{}) == 5000050000ull);
+    REQUIRE(parallel_reduce(
+                pool, values, std::uint64_t(0), std::plus<>{}, [](std::uint64_t v) { return v % 2; }, 3) == 50000);
+    REQUIRE(parallel_reduce(pool, std::vector<int>{}, 42, std::plus<>{}) == 42);
+
+    // Order of the partial results must be preserved
+    std::vector<std::string> letters;
+    for (char c = 'a'; c <= 'z'; c++) letters.emplace_back(1, c);
+    REQUIRE(parallel_reduce(pool, letters, std::string(), std::plus<>{}, std::identity{}, 2) ==
+            "abcdefghijklmnopqrstuvwxyz");
+}
+
+TEST_CASE("parallel_sort", "[parallel]")
+{
+    ThreadPool pool;
+    pool.start(4);
+
+    std::mt19937 gen(42);
+    for (std::size_t size: {0, 1, 2, 100, 12345, 100000}) {
+        std::vector<int> values(size);
+        for (auto &v: values) v = gen();
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        parallel_sort(pool, values);
+        REQUIRE(values == expected);
+
+        parallel_sort(pool, values, std::greater<>{}, 100);
+        std::reverse(expected.begin(), expected.end());
+        REQUIRE(values == expected);
+    }
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "pivot/containers/SlotMap.hxx"
+
+using namespace pivot;
+
+TEST_CASE("Slot map handles", "[slotMap]")
+{
+    SlotMap<std::string> map;
+    REQUIRE(map.empty());
+    REQUIRE_FALSE(SlotMap<std::string>::Handle{}.isValid());
+
+    auto a = map.insert("a");
+    auto b = map.emplace(3, 'b');
+    auto c = map.insert("c");
+    REQUIRE(map.size() == 3);
+    REQUIRE(a.isValid());
+    REQUIRE(map[b] == "bbb");
+    REQUIRE(map.getStorage() == std::vector<std::string>{"a", "bbb", "c"});
+
+    // The last value takes the place of the erased one
+    REQUIRE(map.erase(a));
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.getStorage() == std::vector<std::string>{"c", "bbb"});
+    REQUIRE(map.getDenseIndex(c) == 0);
+    REQUIRE(map.getHandle(0) == c);
+    REQUIRE(map.at(c) == "c");
+
+    // Stale handles are detected, even once their slot is reused
+    REQUIRE_FALSE(map.contains(a));
+    REQUIRE(map.find(a) == nullptr);
+    REQUIRE_FALSE(map.erase(a));
+    REQUIRE_THROWS_AS(map.at(a), std::out_of_range);
+    auto d = map.insert("d");
+    REQUIRE(d.index == a.index);
+    REQUIRE_FALSE(map.contains(a));
+    REQUIRE(*map.find(d) == "d");
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE_FALSE(map.contains(b));
+    REQUIRE_FALSE(map.contains(d));
+}
+
+TEST_CASE("Slot map random operations", "[slotMap]")
+{
+    SlotMap<int> map;
+    std::vector<std::pair<SlotMap<int>::Handle, int>> alive;
+    std::vector<SlotMap<int>::Handle> erased;
+    std::mt19937 gen(42);
+
+    for (int i = 0; i < 10000; i++) {
+        if (alive.empty() || gen() % 3 != 0) {
+            alive.emplace_back(map.insert(i), i);
+        } else {
+            auto pos = gen() % alive.size();
+            REQUIRE(map.erase(alive[pos].first));
+            erased.push_back(alive[pos].first);
+            alive[pos] = alive.back();
+            alive.pop_back();
+        }
+    }
+    REQUIRE(map.size() == alive.size());
+    for (const auto &[handle, value]: alive) REQUIRE(map.at(handle) == value);
+    for (const auto &handle: erased) REQUIRE_FALSE(map.contains(handle));
+
+    std::vector<int> expected;
+    for (const auto &[handle, value]: alive) expected.push_back(value);
+    std::vector<int> values(map.begin(), map.end());
+    std::ranges::sort(expected);
+    std::ranges::sort(values);
+    REQUIRE(values == expected);
+}
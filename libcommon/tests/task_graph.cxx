@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include "pivot/Threading/TaskGraph.hxx"
+
+using namespace pivot;
+
+namespace
+{
+/// Build a random graph where each task depends on some of the previous ones, and sleeps for a random time
+struct RandomGraph {
+    RandomGraph(std::size_t size, unsigned seed): starts(size), ends(size), dependencies(size)
+    {
+        std::mt19937 gen(seed);
+        for (std::size_t id = 0; id < size; id++) {
+            for (std::size_t dep = 0; dep < id; dep++)
+                if (std::uniform_int_distribution(0, 15)(gen) == 0) dependencies[id].push_back(dep);
+            auto delay = std::chrono::microseconds(std::uniform_int_distribution(0, 300)(gen));
+
+            graph.add(
+                "Task " + std::to_string(id),
+                [this, id, delay] {
+                    starts[id] = clock++;
+                    std::this_thread::sleep_for(delay);
+                    ends[id] = clock++;
+                },
+                dependencies[id]);
+        }
+    }
+
+    void checkOrder() const
+    {
+        for (std::size_t id = 0; id < dependencies.size(); id++) {
+            REQUIRE(starts[id] < ends[id]);
+            for (auto dep: dependencies[id]) REQUIRE(ends[dep] < starts[id]);
+        }
+    }
+
+    TaskGraph graph;
+    std::atomic_uint clock = 1;
+    std::vector<std::atomic_uint> starts;
+    std::vector<std::atomic_uint> ends;
+    std::vector<std::vector<TaskGraph::TaskId>> dependencies;
+};
+}    // namespace
+
+TEST_CASE("Task graph respects dependencies under random delays", "[task_graph]")
+{
+    ThreadPool pool;
+    pool.start(4);
+
+    for (unsigned seed = 0; seed < 5; seed++) {
+        RandomGraph random(200, seed);
+        random.graph.run(pool);
+        random.checkOrder();
+
+        // A graph can be executed again
+        random.clock = 1;
+        random.graph.run(pool);
+        random.checkOrder();
+    }
+}
+
+TEST_CASE("Task graph runs without any worker", "[task_graph]")
+{
+    ThreadPool pool;
+    RandomGraph random(50, 42);
+    random.graph.run(pool);
+    random.checkOrder();
+}
+
+TEST_CASE("Task graph continuations", "[task_graph]")
+{
+    ThreadPool pool;
+    pool.start(2);
+    TaskGraph graph;
+    std::vector<int> order;
+
+    auto first = graph.add("first", [&] { order.push_back(1); });
+    auto second = graph.then(first, "second", [&] { order.push_back(2); });
+    graph.then(second, "third", [&] { order.push_back(3); });
+    graph.run(pool);
+    REQUIRE(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("Task graph skips the dependents of a failed task", "[task_graph]")
+{
+    ThreadPool pool;
+    pool.start(2);
+    TaskGraph graph;
+    std::atomic_bool dependentRan = false;
+    std::atomic_bool independentRan = false;
+
+    auto failing = graph.add("failing", [] { throw std::runtime_error("task failure"); });
+    auto dependent = graph.then(failing, "dependent", [&] { dependentRan = true; });
+    graph.then(dependent, "transitive", [&] { dependentRan = true; });
+    graph.add("independent", [&] { independentRan = true; });
+
+    REQUIRE_THROWS_AS(graph.run(pool), std::runtime_error);
+    REQUIRE_FALSE(dependentRan);
+    REQUIRE(independentRan);
+}
+
+TEST_CASE("Task graph rejects malformed graphs", "[task_graph]")
+{
+    ThreadPool pool;
+    TaskGraph graph;
+    auto a = graph.add("a", [] {});
+    auto b = graph.then(a, "b", [] {});
+
+    REQUIRE_THROWS_AS(graph.depend(a, a), TaskGraph::TaskGraphError);
+    REQUIRE_THROWS_AS(graph.depend(a, 42), TaskGraph::TaskGraphError);
+
+    graph.depend(a, b);
+    REQUIRE_THROWS_AS(graph.run(pool), TaskGraph::TaskGraphError);
+}
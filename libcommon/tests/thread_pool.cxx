@@ -0,0 +1,247 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <iostream>
+#include <numeric>
+#include <queue>
+
+#include "pivot/Threading/ThreadPool.hxx"
+
+using namespace pivot;
+
+namespace
+{
+/// Copy of the previous ThreadPool design (one shared queue, polling workers), kept as a reference for benchmarks
+class LegacyThreadPool
+{
+public:
+    LegacyThreadPool(unsigned size)
+    {
+        for (unsigned i = 0; i < size; i++) {
+            workers.emplace_back([this, i](std::stop_token token) {
+                using namespace std::chrono_literals;
+                while (!token.stop_requested()) {
+                    std::function<void(unsigned)> work;
+                    {
+                        std::unique_lock lock(q_mutex);
+                        if (qWork.empty()) q_var.wait_for(lock, 10ms);
+                        if (qWork.empty()) continue;
+                        work = std::move(qWork.front());
+                        qWork.pop();
+                    }
+                    work(i);
+                }
+            });
+        }
+    }
+
+    template <class F>
+    auto push(F &&f) -> std::future<decltype(f(0))>
+    {
+        DEBUG_FUNCTION();
+        auto packagedFunction = std::make_shared<std::packaged_task<decltype(f(0))(unsigned)>>(std::forward<F>(f));
+        {
+            std::unique_lock lock(q_mutex);
+            qWork.push([packagedFunction](unsigned id) { (*packagedFunction)(id); });
+        }
+        q_var.notify_one();
+        return packagedFunction->get_future();
+    }
+
+private:
+    std::mutex q_mutex;
+    std::condition_variable q_var;
+    std::queue<std::function<void(unsigned)>> qWork;
+    std::vector<std::jthread> workers;
+};
+
+template <typename Pool>
+std::uint64_t runContention(Pool &pool, unsigned jobs)
+{
+    std::vector<std::future<std::uint64_t>> futures;
+    futures.reserve(jobs);
+    for (unsigned i = 0; i < jobs; i++) {
+        futures.push_back(pool.push([i](unsigned) -> std::uint64_t { return i * 2; }));
+    }
+    std::uint64_t sum = 0;
+    for (auto &future: futures) sum += future.get();
+    return sum;
+}
+
+}    // namespace
+
+TEST_CASE("Thread pool runs every job", "[thread_pool]")
+{
+    ThreadPool pool;
+    pool.start(4);
+    REQUIRE(pool.size() == 4);
+
+    std::vector<std::future<unsigned>> futures;
+    for (unsigned i = 0; i < 1000; i++) futures.push_back(pool.push([](unsigned, unsigned v) { return v + 1; }, i));
+    for (unsigned i = 0; i < futures.size(); i++) REQUIRE(futures[i].get() == i + 1);
+}
+
+TEST_CASE("Thread pool runs jobs pushed from a worker", "[thread_pool]")
+{
+    ThreadPool pool;
+    pool.start(2);
+
+    std::atomic_uint counter = 0;
+    auto outer = pool.push([&](unsigned) {
+        std::vector<std::future<void>> inner;
+        for (unsigned i = 0; i < 100; i++) inner.push_back(pool.push([&](unsigned) { counter++; }));
+        // Keep the outer worker busy so the other one has to steal the jobs
+        for (auto &f: inner) f.wait();
+    });
+    outer.get();
+    REQUIRE(counter == 100);
+}
+
+TEST_CASE("Thread pool keeps working after a resize", "[thread_pool]")
+{
+    ThreadPool pool;
+    pool.start(4);
+    pool.resize(1);
+    REQUIRE(pool.size() == 1);
+    REQUIRE(pool.push([](unsigned) { return 42; }).get() == 42);
+
+    pool.resize(3);
+    REQUIRE(pool.size() == 3);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; i++) futures.push_back(pool.push([i](unsigned) { return i; }));
+    int sum = 0;
+    for (auto &f: futures) sum += f.get();
+    REQUIRE(sum == 4950);
+
+    pool.stop();
+    REQUIRE(pool.size() == 0);
+}
+
+TEST_CASE("Thread pool runs frame jobs before background jobs", "[thread_pool]")
+{
+    ThreadPool pool;
+    pool.start(1);
+
+    // Block the only worker, so that every job below is queued before any of them runs
+    std::promise<void> release;
+    auto blocker = pool.push([future = release.get_future().share()](unsigned) { future.wait(); });
+    while (pool.getMetrics(ThreadPool::Lane::Frame).startedJobs == 0) std::this_thread::yield();
+
+    std::mutex mutex;
+    std::vector<ThreadPool::Lane> order;
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 4; i++) {
+        futures.push_back(pool.push(ThreadPool::Lane::Background, [&](unsigned) {
+            std::unique_lock lock(mutex);
+            order.push_back(ThreadPool::Lane::Background);
+        }));
+        futures.push_back(pool.push([&](unsigned) {
+            std::unique_lock lock(mutex);
+            order.push_back(ThreadPool::Lane::Frame);
+        }));
+    }
+    REQUIRE(pool.getMetrics(ThreadPool::Lane::Frame).queueDepth == 4);
+    REQUIRE(pool.getMetrics(ThreadPool::Lane::Background).queueDepth == 4);
+
+    release.set_value();
+    blocker.get();
+    for (auto &f: futures) f.get();
+    REQUIRE(order ==
+            std::vector{ThreadPool::Lane::Frame, ThreadPool::Lane::Frame, ThreadPool::Lane::Frame,
+                        ThreadPool::Lane::Frame, ThreadPool::Lane::Background, ThreadPool::Lane::Background,
+                        ThreadPool::Lane::Background, ThreadPool::Lane::Background});
+
+    const auto metrics = pool.getMetrics(ThreadPool::Lane::Background);
+    REQUIRE(metrics.queueDepth == 0);
+    REQUIRE(metrics.startedJobs == 4);
+    REQUIRE(metrics.maxLatency >= metrics.averageLatency);
+    REQUIRE(metrics.averageLatency > std::chrono::nanoseconds(0));
+    pool.resetMetrics();
+    REQUIRE(pool.getMetrics(ThreadPool::Lane::Background).startedJobs == 0);
+}
+
+TEST_CASE("Thread pool runs background jobs on a share of the workers", "[thread_pool]")
+{
+    ThreadPool pool;
+    pool.start(4);
+    pool.setBackgroundShare(0.5f);
+
+    std::atomic_uint running = 0;
+    std::atomic_uint maxRunning = 0;
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 40; i++) {
+        futures.push_back(pool.push(ThreadPool::Lane::Background, [&](unsigned) {
+            auto current = ++running;
+            auto max = maxRunning.load();
+            while (max < current && !maxRunning.compare_exchange_weak(max, current)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            running--;
+        }));
+    }
+    // The other workers are still available for the frame
+    REQUIRE(pool.push([](unsigned) { return 42; }).get() == 42);
+    for (auto &f: futures) f.get();
+    REQUIRE(maxRunning <= 2);
+
+    // At least one worker always runs the background jobs
+    pool.setBackgroundShare(0.f);
+    REQUIRE(pool.push(ThreadPool::Lane::Background, [](unsigned) { return 1; }).get() == 1);
+}
+
+TEST_CASE("Thread pool frame latency during a background load", "[.][benchmark][thread_pool]")
+{
+    using namespace std::chrono_literals;
+    const unsigned threads = std::max(std::thread::hardware_concurrency(), 2u);
+    constexpr int loads = 200;
+    constexpr int frameJobs = 100;
+
+    auto measure = [&](ThreadPool::Lane loadLane) {
+        ThreadPool pool;
+        pool.start(threads);
+        std::vector<std::future<void>> assets;
+        for (int i = 0; i < loads; i++)
+            assets.push_back(pool.push(loadLane, [](unsigned) { std::this_thread::sleep_for(5ms); }));
+        pool.resetMetrics();
+
+        for (int i = 0; i < frameJobs; i++) {
+            pool.push([](unsigned) {}).get();
+            std::this_thread::sleep_for(1ms);
+        }
+        const auto metrics = pool.getMetrics(ThreadPool::Lane::Frame);
+        for (auto &f: assets) f.get();
+        return metrics;
+    };
+
+    const auto single = measure(ThreadPool::Lane::Frame);
+    const auto lanes = measure(ThreadPool::Lane::Background);
+    std::cout << "Frame job latency with the load in the same lane: average "
+              << std::chrono::duration<double, std::milli>(single.averageLatency).count() << "ms, max "
+              << std::chrono::duration<double, std::milli>(single.maxLatency).count() << "ms" << std::endl;
+    std::cout << "Frame job latency with the load in the background lane: average "
+              << std::chrono::duration<double, std::milli>(lanes.averageLatency).count() << "ms, max "
+              << std::chrono::duration<double, std::milli>(lanes.maxLatency).count() << "ms" << std::endl;
+}
+
+TEST_CASE("Thread pool contention", "[.][benchmark][thread_pool]")
+{
+    constexpr unsigned jobs = 10000;
+    const unsigned maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        {
+            ThreadPool pool;
+            pool.start(threads);
+            BENCHMARK("Work stealing pool, " + std::to_string(threads) + " threads")
+            {
+                return runContention(pool, jobs);
+            };
+        }
+        {
+            LegacyThreadPool legacy(threads);
+            BENCHMARK("Single queue pool, " + std::to_string(threads) + " threads")
+            {
+                return runContention(legacy, jobs);
+            };
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include "pivot/utility/Socket.hxx"
+#include "pivot/utility/TraceStream.hxx"
+
+using namespace pivot;
+using namespace pivot::benchmark;
+
+TEST_CASE("Trace stream messages round-trip", "[trace_stream]")
+{
+    stream::Encoder encoder;
+    encoder.writeHeader();
+    encoder.write(stream::ZoneMessage{7, ZoneType::Counter, "zone name"});
+    encoder.write(stream::ThreadMessage{2, "Main thread"});
+    encoder.write(stream::ScopeMessage{7, 2, 123456789012345ull, 42});
+    encoder.write(stream::ValueMessage{7, 2, 99, -1.5});
+    encoder.write(stream::FrameMessage{100});
+
+    // Feed the bytes one by one, as a socket may split them anywhere
+    stream::Decoder decoder;
+    std::vector<stream::Message> messages;
+    for (std::byte byte: encoder.data()) {
+        decoder.feed(std::span(&byte, 1));
+        while (auto message = decoder.next()) messages.push_back(std::move(*message));
+    }
+    REQUIRE(messages.size() == 5);
+
+    auto zone = std::get<stream::ZoneMessage>(messages[0]);
+    CHECK(zone.id == 7);
+    CHECK(zone.type == ZoneType::Counter);
+    CHECK(zone.name == "zone name");
+    CHECK(std::get<stream::ThreadMessage>(messages[1]).name == "Main thread");
+    auto scope = std::get<stream::ScopeMessage>(messages[2]);
+    CHECK(scope.start == 123456789012345ull);
+    CHECK(scope.duration == 42);
+    CHECK(std::get<stream::ValueMessage>(messages[3]).value == -1.5);
+    CHECK(std::get<stream::FrameMessage>(messages[4]).timestamp == 100);
+}
+
+TEST_CASE("Trace stream rejects foreign data", "[trace_stream]")
+{
+    stream::Decoder decoder;
+    const std::string garbage = "GET / HTTP/1.1\r\n";
+    decoder.feed(std::as_bytes(std::span(garbage)));
+    REQUIRE_THROWS_AS(decoder.next(), stream::Decoder::DecoderError);
+}
+
+TEST_CASE("Instrumentor streams results to a receiver", "[trace_stream]")
+{
+    auto listener = Socket::listen(0);
+    auto &instrumentor = Instrumentor::get();
+    static constinit const Zone scope("streamed scope", __FILE__, __LINE__);
+    static constinit const Zone gauge("streamed gauge", __FILE__, __LINE__, ZoneType::Gauge);
+
+    std::vector<stream::Message> messages;
+    std::jthread receiver([&] {
+        Socket connection = listener.accept();
+        stream::Decoder decoder;
+        std::array<std::byte, 4096> buffer;
+        while (auto size = connection.receive(buffer)) {
+            decoder.feed(std::span(buffer).first(size));
+            while (auto message = decoder.next()) messages.push_back(std::move(*message));
+        }
+    });
+
+    REQUIRE(instrumentor.beginStreaming("127.0.0.1", listener.getPort()));
+    REQUIRE(instrumentor.isStreaming());
+    for (unsigned i = 0; i < 100; i++) { Timer timer(scope); }
+    instrumentor.recordValue(gauge, 3);
+    instrumentor.endFrame();
+    instrumentor.endStreaming();
+    REQUIRE_FALSE(instrumentor.isRecording());
+    receiver.join();
+
+    std::size_t scopes = 0;
+    std::size_t frames = 0;
+    std::optional<std::uint32_t> scopeId;
+    for (const auto &message: messages) {
+        if (auto *zone = std::get_if<stream::ZoneMessage>(&message); zone && zone->name == "streamed scope") {
+            // Zones are described before they are used
+            CHECK(scopes == 0);
+            scopeId = zone->id;
+        }
+        if (auto *event = std::get_if<stream::ScopeMessage>(&message); event && event->zone == scopeId) scopes++;
+        if (auto *value = std::get_if<stream::ValueMessage>(&message)) CHECK(value->value == 3);
+        if (std::holds_alternative<stream::FrameMessage>(message)) frames++;
+    }
+    REQUIRE(scopeId);
+    REQUIRE(scopes == 100);
+    REQUIRE(frames == 1);
+
+    // Nothing is listening anymore
+    listener.close();
+    REQUIRE_FALSE(instrumentor.beginStreaming("127.0.0.1", 1));
+    REQUIRE_FALSE(instrumentor.isStreaming());
+}
@@ -19,7 +19,7 @@ public:
     TagArray(Description d): UniqueComponentArray<Tag>(d) {}
 
     /// Get the id of an Entity by its name
-    std::optional<Entity> getEntityID(const std::string &name)
+    std::optional<Entity> getEntityID(const std::string &name) const
     {
         auto it = m_unique_hash.find(std::hash<Tag>()(Tag{name}));
         if (it == m_unique_hash.end()) {
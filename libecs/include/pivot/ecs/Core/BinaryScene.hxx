@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <pivot/utility/MappedFile.hxx>
+
+#include "pivot/ecs/Core/Scene.hxx"
+
+namespace pivot::ecs
+{
+
+/** \brief A scene stored in the binary scene format
+ *
+ * The binary format stores the same content as the JSON format of Scene::getJson, and converts to and from it
+ * exactly. Instead of guessing the type of every value from its shape, the file starts with a schema giving the
+ * data::Type of every component, followed by one block per component:
+ * - the entities having the component
+ * - one column per basic field of the component type, holding the field of every entity contiguously, as raw
+ *   little-endian numbers, or as offsets into the characters of the strings
+ *
+ * The columns are aligned on 8 bytes, so that the file can be memory-mapped and its columns read in place.
+ */
+class BinaryScene
+{
+public:
+    /// Version of the format, incremented on every incompatible change
+    static constexpr std::uint32_t version = 1;
+    /// Extension of the binary scene files
+    static constexpr const char *extension = ".pvscene";
+
+    /// Error thrown when a binary scene is malformed, or when a scene can't be stored in the binary format
+    class FormatError : public std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
+
+    /// Maps a binary scene file in memory
+    explicit BinaryScene(const std::filesystem::path &path);
+    /// Reads a binary scene in memory, which must outlive the BinaryScene
+    explicit BinaryScene(std::span<const std::byte> data);
+
+    /// Returns whether a file is a binary scene, by its header
+    static bool isBinaryScene(const std::filesystem::path &path);
+
+    /// Name of the scene
+    const std::string &getName() const { return m_name; }
+    /// Systems used by the scene
+    const std::vector<std::string> &getSystems() const { return m_systems; }
+    /// Scripts needed by the scene
+    const std::vector<std::string> &getScripts() const { return m_scripts; }
+    /// Assets needed by the scene
+    const std::vector<std::string> &getAssets() const { return m_assets; }
+    /// Components stored in the scene and the type of their values
+    const std::vector<std::pair<std::string, data::Type>> &getSchema() const { return m_schema; }
+
+    /// Creates the scene, like Scene::load
+    std::unique_ptr<Scene> load(const component::Index &cIndex, const systems::Index &sIndex) const;
+    /// Converts the scene to the JSON format of Scene::getJson
+    nlohmann::json toJson() const;
+
+    /// Encodes a scene in the JSON format of Scene::getJson
+    static std::vector<std::byte> fromJson(const nlohmann::json &scene);
+    /// Encodes the content of Scene::getJson, without going through JSON
+    static std::vector<std::byte> fromScene(const Scene &scene,
+                                            std::optional<Scene::AssetTranslator> assetTranslator = std::nullopt,
+                                            std::optional<Scene::ScriptTranslator> scriptTranslator = std::nullopt);
+    /// Writes an encoded scene to a file
+    static void write(const std::filesystem::path &path, std::span<const std::byte> data);
+
+private:
+    /// Block of a component, stored after the header
+    struct Block {
+        /// Index of the component in the schema
+        std::size_t component;
+        /// Offset of the block in the file
+        std::size_t offset;
+    };
+
+    void readHeader();
+    template <typename F>
+    void forEachBlock(F &&f) const;
+
+    MappedFile m_file;
+    std::span<const std::byte> m_data;
+
+    std::string m_name;
+    std::uint32_t m_entityCount = 0;
+    std::vector<std::string> m_systems;
+    std::vector<std::string> m_scripts;
+    std::vector<std::string> m_assets;
+    std::vector<std::pair<std::string, data::Type>> m_schema;
+    std::vector<Block> m_blocks;
+};
+
+}    // namespace pivot::ecs
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <pivot/ecs/Core/Component/ArchetypeStorage.hxx>
+#include <pivot/ecs/Core/Component/array.hxx>
+#include <pivot/ecs/Core/Component/description_helpers.hxx>
+#include <pivot/ecs/Core/Component/error.hxx>
+#include <pivot/ecs/Core/types.hxx>
+#include <pivot/pivot.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief A component array whose values live in the ArchetypeStorage of the component Manager
+ *
+ * The array is only a view over the storage, it must be attached to it by the Manager before being used.
+ */
+class IArchetypeComponentArray : public IComponentArray
+{
+public:
+    /// Register the component in the storage, and store its values there from now on
+    virtual void attach(ArchetypeStorage &storage, ComponentType component) = 0;
+};
+
+/** \brief A generic implementor of IComponentArray, storing its values in the archetype chunks
+ *
+ * The ArchetypeComponentArray is meant for components iterated together by systems, like the Transform, the
+ * RigidBody and the Gravity. The entities having the same components are packed in the same chunks, so iterating
+ * over them with ArchetypeStorage::each() never reads an entity missing one of the components.
+ */
+template <typename T>
+class ArchetypeComponentArray : public IArchetypeComponentArray
+{
+public:
+    /// Creates an ArchetypeComponentArray from the Description of its component
+    ArchetypeComponentArray(Description description): m_description(std::move(description)) {}
+
+    /// \copydoc pivot::ecs::component::IArchetypeComponentArray::attach()
+    void attach(ArchetypeStorage &storage, ComponentType component) override
+    {
+        storage.registerComponent(component, ArchetypeColumnType::of<T>());
+        m_storage = &storage;
+        m_component = component;
+    }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::getDescription()
+    const Description &getDescription() const override { return m_description; }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::getValueForEntity()
+    std::optional<data::Value> getValueForEntity(Entity entity) const override
+    {
+        const T *value = storage().template get<T>(entity, m_component);
+        if (value == nullptr) return std::nullopt;
+        return helpers::Helpers<T>::createValueFromType(*value);
+    }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::entityHasValue()
+    bool entityHasValue(Entity entity) const override { return storage().contains(entity, m_component); }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::setValueForEntity()
+    void setValueForEntity(Entity entity, std::optional<data::Value> value) override
+    {
+        if (!value.has_value()) {
+            storage().remove(entity, m_component);
+        } else {
+            setEntity(entity, parseValue(value.value()));
+        }
+    }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::maxEntity()
+    Entity maxEntity() const override { return storage().maxEntity(); }
+
+    /// Id of the component in the ArchetypeStorage
+    ComponentType getComponentType() const noexcept { return m_component; }
+
+    /// Parse a pivot value into the type stored in the array
+    T parseValue(data::Value value)
+    {
+        auto value_type = value.type();
+        if (!value_type.isSubsetOf(m_description.type)) {
+            throw InvalidComponentValue(m_description.name, m_description.type, value_type);
+        }
+
+        T parsed;
+        helpers::Helpers<T>::updateTypeWithValue(parsed, value);
+        return parsed;
+    }
+
+    /// Returns the value of the component if it exist for this entity
+    std::optional<T> getEntity(Entity entity) const
+    {
+        const T *value = storage().template get<T>(entity, m_component);
+        if (value == nullptr) return std::nullopt;
+        return std::make_optional(*value);
+    }
+
+    /// Sets the value of an entity
+    void setEntity(Entity entity, std::optional<T> value)
+    {
+        if (!value.has_value()) {
+            storage().remove(entity, m_component);
+        } else if (T *current = storage().template get<T>(entity, m_component)) {
+            *current = std::move(value.value());
+        } else {
+            storage().insert(entity, m_component, std::move(value.value()));
+        }
+    }
+
+protected:
+    /// Description of the component
+    Description m_description;
+
+private:
+    ArchetypeStorage &storage() const
+    {
+        pivotAssertMsg(m_storage != nullptr, "The component array is not attached to a component Manager");
+        return *m_storage;
+    }
+
+    ArchetypeStorage *m_storage = nullptr;
+    ComponentType m_component = 0;
+};
+}    // namespace pivot::ecs::component
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pivot/ecs/Core/types.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief Type-erased operations needed to store a component type in an ArchetypeStorage
+ *
+ * The storage only moves values between chunks, it never needs to know their type.
+ */
+struct ArchetypeColumnType {
+    /// Size of a value
+    std::size_t size;
+    /// Alignment of a value
+    std::size_t alignment;
+    /// Move construct a value at destination, and destroy the source
+    void (*relocate)(void *destination, void *source);
+    /// Destroy a value
+    void (*destroy)(void *value);
+
+    /// Returns the operations of a C++ type
+    template <typename T>
+    requires std::is_nothrow_move_constructible_v<T>
+    static constexpr ArchetypeColumnType of()
+    {
+        return {
+            .size = sizeof(T),
+            .alignment = alignof(T),
+            .relocate =
+                [](void *destination, void *source) {
+                    new (destination) T(std::move(*static_cast<T *>(source)));
+                    static_cast<T *>(source)->~T();
+                },
+            .destroy = [](void *value) { static_cast<T *>(value)->~T(); },
+        };
+    }
+};
+
+/** \brief Stores components grouped by archetype, in chunks with a structure of arrays layout
+ *
+ * An archetype is a set of components. Every entity having exactly the components of an archetype is stored in the
+ * chunks of this archetype. A chunk is a fixed size block of memory, holding a column of values per component, and a
+ * column of entities. Iterating over the entities having some components is therefore a linear walk over the
+ * matching chunks, without any hole nor indirection.
+ *
+ * Adding or removing a component moves the entity to another archetype. Removing an entity from an archetype moves
+ * the last entity of the archetype in its place, so the chunks stay packed.
+ *
+ * Only the components registered in the storage are stored in it. The storage is used by the
+ * ArchetypeComponentArray, and owned by the component Manager.
+ */
+class ArchetypeStorage
+{
+public:
+    /// Size of the memory of a chunk, unless a single row is larger
+    static constexpr std::size_t chunkSize = 16 * 1024;
+
+    /// Entities sharing the same set of components, stored in the same chunk
+    class Chunk
+    {
+    public:
+        /// Amount of entities in the chunk
+        std::size_t size() const noexcept { return m_size; }
+        /// Entities of the chunk
+        std::span<const Entity> entities() const noexcept
+        {
+            return {reinterpret_cast<const Entity *>(m_data.get()), m_size};
+        }
+        /// Column of values of a component, which must be part of the archetype
+        template <typename T>
+        std::span<T> column(std::size_t columnIndex) noexcept
+        {
+            return {reinterpret_cast<T *>(m_data.get() + m_offsets[columnIndex]), m_size};
+        }
+
+    private:
+        struct Deleter {
+            void operator()(std::byte *data) const { ::operator delete[](data, std::align_val_t(64)); }
+        };
+
+        std::unique_ptr<std::byte[], Deleter> m_data;
+        std::span<const std::size_t> m_offsets;
+        std::size_t m_size = 0;
+
+        friend class ArchetypeStorage;
+    };
+
+    /// Every chunk of entities having the same set of components
+    class Archetype
+    {
+    public:
+        /// Components of the archetype
+        const Signature &signature() const noexcept { return m_signature; }
+        /// Chunks of the archetype, only the last one may not be full
+        std::span<const std::unique_ptr<Chunk>> chunks() const noexcept { return m_chunks; }
+        /// Index of the column of a component in the chunks, the component must be part of the archetype
+        std::size_t columnIndex(ComponentType component) const noexcept { return m_columnIndex[component]; }
+        /// Amount of entities in the archetype
+        std::size_t size() const noexcept { return m_size; }
+
+    private:
+        Signature m_signature;
+        std::vector<ComponentType> m_components;
+        std::array<std::size_t, MAX_COMPONENTS> m_columnIndex = {};
+        /// Offset of the entity column, then of each component column, in a chunk
+        std::vector<std::size_t> m_offsets;
+        std::size_t m_chunkCapacity = 0;
+        std::size_t m_chunkBytes = 0;
+        std::vector<std::unique_ptr<Chunk>> m_chunks;
+        std::size_t m_size = 0;
+
+        friend class ArchetypeStorage;
+    };
+
+public:
+    ArchetypeStorage() = default;
+    ~ArchetypeStorage();
+    /// @cond
+    ArchetypeStorage(const ArchetypeStorage &) = delete;
+    ArchetypeStorage &operator=(const ArchetypeStorage &) = delete;
+    /// @endcond
+
+    /// Allow a component to be stored in the archetypes
+    void registerComponent(ComponentType component, ArchetypeColumnType type);
+    /// Is the component stored in the archetypes ?
+    bool isRegistered(ComponentType component) const noexcept { return m_registered.test(component); }
+
+    /// Returns true if the entity has a value of the component
+    bool contains(Entity entity, ComponentType component) const noexcept
+    {
+        return entity < m_locations.size() && m_locations[entity].archetype != noArchetype &&
+               m_archetypes[m_locations[entity].archetype]->m_signature.test(component);
+    }
+    /// Returns the components of the entity stored in the archetypes
+    Signature getSignature(Entity entity) const noexcept;
+
+    /// Returns the value of a component of the entity, or nullptr if it has none
+    void *get(Entity entity, ComponentType component) noexcept;
+    /// \copydoc get
+    const void *get(Entity entity, ComponentType component) const noexcept
+    {
+        return const_cast<ArchetypeStorage *>(this)->get(entity, component);
+    }
+    /// Returns the value of a component of the entity, or nullptr if it has none
+    template <typename T>
+    T *get(Entity entity, ComponentType component) noexcept
+    {
+        return static_cast<T *>(get(entity, component));
+    }
+    /// \copydoc get
+    template <typename T>
+    const T *get(Entity entity, ComponentType component) const noexcept
+    {
+        return static_cast<const T *>(get(entity, component));
+    }
+
+    /** \brief Add a component to the entity, moving it to the archetype with this component
+     *
+     * The value is relocated from source into the chunk of the entity. If the entity already has the component, its
+     * value is replaced.
+     */
+    void insert(Entity entity, ComponentType component, void *source);
+    /// Add a component to the entity, or replace its value
+    template <typename T>
+    void insert(Entity entity, ComponentType component, T value)
+    {
+        // The storage takes ownership of the value, its destructor must not run here
+        alignas(T) std::byte buffer[sizeof(T)];
+        new (buffer) T(std::move(value));
+        insert(entity, component, static_cast<void *>(buffer));
+    }
+    /// Remove a component of the entity, moving it to the archetype without this component
+    void remove(Entity entity, ComponentType component);
+    /// Remove every component of the entity
+    void removeEntity(Entity entity);
+
+    /// Returns the largest entity which can have a value in the storage
+    Entity maxEntity() const noexcept { return m_locations.size(); }
+    /// Every archetype of the storage
+    std::span<const std::unique_ptr<Archetype>> archetypes() const noexcept { return m_archetypes; }
+
+    /** \brief Calls f(archetype, chunk) for every chunk of entities having all the components
+     *
+     * The chunks must not be modified by f, other than the values of their components.
+     */
+    template <typename F>
+    void forEachChunk(const Signature &components, F &&f)
+    {
+        for (auto &archetype: m_archetypes) {
+            if ((archetype->m_signature & components) != components) continue;
+            for (auto &chunk: archetype->m_chunks) f(*archetype, *chunk);
+        }
+    }
+
+    /** \brief Calls f(entity, T &...) for every entity having all the components
+     *
+     * The components are given as pairs of a type and an id, for example
+     * `each<RigidBody, Gravity>({rigidBodyId, gravityId}, f)`.
+     */
+    template <typename... Ts, typename F>
+    void each(const std::array<ComponentType, sizeof...(Ts)> &components, F &&f)
+    {
+        Signature signature;
+        for (auto component: components) signature.set(component);
+        forEachChunk(signature, [&](const Archetype &archetype, Chunk &chunk) {
+            eachInChunk<Ts...>(archetype, chunk, components, f, std::index_sequence_for<Ts...>());
+        });
+    }
+
+private:
+    template <typename... Ts, typename F, std::size_t... I>
+    static void eachInChunk(const Archetype &archetype, Chunk &chunk,
+                            const std::array<ComponentType, sizeof...(Ts)> &components, F &f,
+                            std::index_sequence<I...>)
+    {
+        auto columns = std::make_tuple(chunk.column<Ts>(archetype.columnIndex(components[I]))...);
+        auto entities = chunk.entities();
+        for (std::size_t row = 0; row < entities.size(); row++) f(entities[row], std::get<I>(columns)[row]...);
+    }
+
+    static constexpr std::uint32_t noArchetype = std::numeric_limits<std::uint32_t>::max();
+
+    /// Position of an entity in the storage
+    struct Location {
+        std::uint32_t archetype = noArchetype;
+        std::uint32_t chunk = 0;
+        std::uint32_t row = 0;
+    };
+
+    std::uint32_t getArchetype(const Signature &signature);
+    /// Reserve a row at the end of the archetype, the values must be constructed by the caller
+    Location pushRow(std::uint32_t archetypeIndex, Entity entity);
+    /// Remove a row whose values were already relocated or destroyed, moving the last row in its place
+    void eraseRow(const Location &location);
+    void *value(const Location &location, std::size_t columnIndex) noexcept;
+
+    Signature m_registered;
+    std::array<ArchetypeColumnType, MAX_COMPONENTS> m_types = {};
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;
+    std::unordered_map<Signature, std::uint32_t> m_archetypeIndex;
+    std::vector<Location> m_locations;
+};
+
+}    // namespace pivot::ecs::component
@@ -2,6 +2,7 @@
 
 #include <span>
 
+#include <pivot/ecs/Core/Component/EntityBitmap.hxx>
 #include <pivot/ecs/Core/Component/array.hxx>
 #include <pivot/ecs/Core/Component/description_helpers.hxx>
 #include <pivot/ecs/Core/Component/error.hxx>
@@ -10,6 +11,18 @@
 namespace pivot::ecs::component
 {
 
+/** \brief A component array storing whether each entity has a value in an EntityBitmap
+ *
+ * The bitmaps of several arrays can be intersected a word at a time, which allows an ArrayCombination to skip 64
+ * entities missing a component at once.
+ */
+class IDenseComponentArray : public IComponentArray
+{
+public:
+    /// Returns the bits specifying whether an entity has the component
+    virtual const EntityBitmap &getExistence() const = 0;
+};
+
 /** \brief A generic implementor of IComponentArray, optimized for components
  * used for nearly every entity.
  *
@@ -18,7 +31,7 @@ namespace pivot::ecs::component
  * Scene.
  */
 template <typename T>
-class DenseTypedComponentArray : public IComponentArray
+class DenseTypedComponentArray : public IDenseComponentArray
 {
 public:
     /// Creates a DenseTypedComponentArray from the Description of its component
@@ -73,8 +86,8 @@ public:
     /// miss this component.
     std::span<const T> getData() const { return this->m_components; }
 
-    /// Returns the booleans specifying whether an an entity has the component
-    const std::vector<bool> &getExistence() const { return this->m_component_exist; }
+    /// \copydoc pivot::ecs::component::IDenseComponentArray::getExistence()
+    const EntityBitmap &getExistence() const override { return this->m_component_exist; }
 
     /// Returns the vector containing the component data
     const std::vector<T> &getComponents() const { return this->m_components; }
@@ -105,6 +118,13 @@ public:
         }
     }
 
+    /// Returns a pointer to the value of the component if it exist for this entity, without conversion
+    T *findEntity(Entity entity)
+    {
+        if (!entityHasValue(entity)) return nullptr;
+        return &m_components[entity];
+    }
+
     /// Sets the value of an entity
     void setEntity(Entity entity, std::optional<T> value)
     {
@@ -124,13 +144,13 @@ protected:
     /// Description of the component
     Description m_description;
 
-    /** \brief Vector of booleans indicating whether an entity has a component or not
+    /** \brief Bitmap indicating whether an entity has a component or not
      *
      * If m_component_exist[entityId] is true, then the entity has a value of the component in m_components[entityId].
      *
      * Otherwise, the entity has no value of the component, and the content of m_components[entityId] is undefined.
      */
-    std::vector<bool> m_component_exist;
+    EntityBitmap m_component_exist;
 
     /// The storage containing the values of the components for each entity.
     std::vector<T> m_components;
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <pivot/ecs/Core/types.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief A bit per entity, stored in 64 bits words
+ *
+ * It has the same interface as the std::vector<bool> it replaces, but its words can be read directly, so that the
+ * existence bitmaps of several arrays can be intersected 64 entities at a time.
+ */
+class EntityBitmap
+{
+public:
+    /// Type of the words of the bitmap
+    using Word = std::uint64_t;
+    /// Amount of bits in a word
+    static constexpr std::size_t wordBits = 64;
+
+    /// Proxy to a single bit of the bitmap
+    class reference
+    {
+    public:
+        /// @cond
+        reference(Word &word, Word mask) noexcept: m_word(word), m_mask(mask) {}
+        operator bool() const noexcept { return (m_word & m_mask) != 0; }
+        reference &operator=(bool value) noexcept
+        {
+            if (value) {
+                m_word |= m_mask;
+            } else {
+                m_word &= ~m_mask;
+            }
+            return *this;
+        }
+        reference &operator=(const reference &other) noexcept { return *this = bool(other); }
+        /// @endcond
+
+    private:
+        Word &m_word;
+        Word m_mask;
+    };
+
+    /// Amount of bits in the bitmap
+    std::size_t size() const noexcept { return m_size; }
+
+    /// Resize the bitmap, the new bits are set to value
+    void resize(std::size_t size, bool value = false)
+    {
+        const std::size_t oldSize = m_size;
+        m_words.resize((size + wordBits - 1) / wordBits, 0);
+        m_size = size;
+        if (size < oldSize) {
+            // Keep the bits after the end cleared, the words are read as is
+            if (size % wordBits != 0) m_words.back() &= (Word(1) << (size % wordBits)) - 1;
+        } else if (value) {
+            for (std::size_t i = oldSize; i < size; i++) (*this)[i] = true;
+        }
+    }
+
+    /// @cond
+    bool operator[](std::size_t i) const noexcept { return (m_words[i / wordBits] >> (i % wordBits)) & 1; }
+    reference operator[](std::size_t i) noexcept { return {m_words[i / wordBits], Word(1) << (i % wordBits)}; }
+    bool at(std::size_t i) const
+    {
+        if (i >= m_size) throw std::out_of_range("EntityBitmap::at");
+        return (*this)[i];
+    }
+    reference at(std::size_t i)
+    {
+        if (i >= m_size) throw std::out_of_range("EntityBitmap::at");
+        return (*this)[i];
+    }
+    /// @endcond
+
+    /// Words of the bitmap, the bits past size() are always cleared
+    std::span<const Word> words() const noexcept { return m_words; }
+
+private:
+    std::vector<Word> m_words;
+    std::size_t m_size = 0;
+};
+
+}    // namespace pivot::ecs::component
@@ -1,13 +1,12 @@
 #pragma once
 
-#include <set>
-
-#include <pivot/ecs/Core/Component/array.hxx>
+#include <pivot/ecs/Core/Component/SparseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/SparseSet.hxx>
 
 namespace pivot::ecs::component
 {
 /// Storage class for components without content, which only serve to "flag" entities
-class FlagComponentStorage : public IComponentArray
+class FlagComponentStorage : public ISparseComponentArray
 {
 public:
     /// Creates a FlagComponentStorage from the Description of its component
@@ -28,14 +27,17 @@ public:
     /// \copydoc pivot::ecs::component::IComponentArray::maxEntity()
     Entity maxEntity() const override;
 
-    /// Get acces to the set storing whether an entity has the component
-    const std::set<Entity> &getData();
+    /// \copydoc pivot::ecs::component::ISparseComponentArray::getEntities()
+    std::span<const Entity> getEntities() const override;
+
+    /// Get access to the entities having the component, in no particular order
+    std::span<const Entity> getData() const;
 
 private:
     /// Description of the component
     Description m_description;
     /// Storage of the component existence or not
-    std::set<Entity> m_entity_having_component;
+    SparseSet m_entity_having_component;
     /// The maximum entity id that ever had a value in this storage
     Entity m_max_entity = 0;
 };
@@ -1,17 +1,20 @@
 #pragma once
 
-#include "pivot/ecs/Core/Component/array.hxx"
+#include <vector>
+
+#include "pivot/ecs/Core/Component/SparseComponentArray.hxx"
+#include "pivot/ecs/Core/Component/SparseSet.hxx"
 
 namespace pivot::ecs::component
 {
 
 /** \brief A generic implementor of IComponentArray, optimized for script components.
  *
- * The ScriptingComponentArray stores the values of a script component in a contiguous
- * array. It is optimized for components which are present on most entities in a
- * Scene.
+ * The ScriptingComponentArray stores the values of a script component packed in a
+ * contiguous array, indexed by a SparseSet. Script components are usually present on
+ * few entities, so only those entities are stored and iterated.
  */
-class ScriptingComponentArray : public IComponentArray
+class ScriptingComponentArray : public ISparseComponentArray
 {
 public:
     /// Creates a ScriptingComponentArray from the Description of its component
@@ -28,11 +31,19 @@ public:
 
     Entity maxEntity() const override;
 
+    /// \copydoc pivot::ecs::component::ISparseComponentArray::getEntities()
+    std::span<const Entity> getEntities() const override;
+
+    /// Returns the values of the component, in the same order as getEntities()
+    std::span<data::Value> getData() { return m_components; }
+
 protected:
     /// Description of the component
     Description m_description;
-    /// The storage containing the values of the components for each entity.
-    std::unordered_map<Entity, data::Value> m_components;
+    /// Entities having a value, m_entities.entities()[i] has the value m_components[i]
+    SparseSet m_entities;
+    /// The storage containing the values of the components, packed
+    std::vector<data::Value> m_components;
     /// The maximum entity id that ever had a value in this array
     Entity m_max_entity = 0;
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <pivot/ecs/Core/Component/SparseSet.hxx>
+#include <pivot/ecs/Core/Component/array.hxx>
+#include <pivot/ecs/Core/Component/description_helpers.hxx>
+#include <pivot/ecs/Core/Component/error.hxx>
+#include <pivot/ecs/Core/types.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief A component array storing the entities having a value in a SparseSet
+ *
+ * The entities can be iterated without probing every entity id, which allows an ArrayCombination to iterate only
+ * over the entities of its smallest array.
+ */
+class ISparseComponentArray : public IComponentArray
+{
+public:
+    /// Entities having a value in the array, in no particular order
+    virtual std::span<const Entity> getEntities() const = 0;
+};
+
+/** \brief A generic implementor of IComponentArray, optimized for components used by few entities
+ *
+ * The SparseComponentArray stores the values of a component packed in a contiguous array, in the same order as the
+ * entities of its SparseSet. Unlike the DenseTypedComponentArray, its memory and iteration cost only depend on the
+ * amount of entities having the component.
+ */
+template <typename T>
+class SparseComponentArray : public ISparseComponentArray
+{
+public:
+    /// Creates a SparseComponentArray from the Description of its component
+    SparseComponentArray(Description description): m_description(std::move(description)) {}
+
+    /// \copydoc pivot::ecs::component::IComponentArray::getDescription()
+    const Description &getDescription() const override { return m_description; }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::getValueForEntity()
+    std::optional<data::Value> getValueForEntity(Entity entity) const override
+    {
+        auto index = m_entities.find(entity);
+        if (!index) return std::nullopt;
+        return helpers::Helpers<T>::createValueFromType(m_components[*index]);
+    }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::entityHasValue()
+    bool entityHasValue(Entity entity) const override { return m_entities.contains(entity); }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::setValueForEntity()
+    void setValueForEntity(Entity entity, std::optional<data::Value> value) override
+    {
+        if (!value.has_value()) {
+            setEntity(entity, std::nullopt);
+        } else {
+            auto value_type = value->type();
+            if (!value_type.isSubsetOf(m_description.type)) {
+                throw InvalidComponentValue(m_description.name, m_description.type, value_type);
+            }
+            T parsed;
+            helpers::Helpers<T>::updateTypeWithValue(parsed, value.value());
+            setEntity(entity, std::move(parsed));
+        }
+    }
+
+    /// \copydoc pivot::ecs::component::IComponentArray::maxEntity()
+    Entity maxEntity() const override { return m_max_entity; }
+
+    /// \copydoc pivot::ecs::component::ISparseComponentArray::getEntities()
+    std::span<const Entity> getEntities() const override { return m_entities.entities(); }
+
+    /// Returns a mutable view into the components values, in the same order as getEntities()
+    std::span<T> getData() { return m_components; }
+
+    /// Returns a constant view into the components values, in the same order as getEntities()
+    std::span<const T> getData() const { return m_components; }
+
+    /// Returns the value of the component if it exist for this entity
+    std::optional<T> getEntity(Entity entity) const
+    {
+        auto index = m_entities.find(entity);
+        if (!index) return std::nullopt;
+        return std::make_optional(m_components[*index]);
+    }
+
+    /// Returns a pointer to the value of the component if it exist for this entity, without conversion
+    T *findEntity(Entity entity)
+    {
+        auto index = m_entities.find(entity);
+        if (!index) return nullptr;
+        return &m_components[*index];
+    }
+
+    /// Sets the value of an entity
+    void setEntity(Entity entity, std::optional<T> value)
+    {
+        if (!value.has_value()) {
+            auto removed = m_entities.erase(entity);
+            if (!removed) return;
+            if (*removed + 1 != m_components.size()) m_components[*removed] = std::move(m_components.back());
+            m_components.pop_back();
+        } else if (auto index = m_entities.find(entity)) {
+            m_components[*index] = std::move(value.value());
+        } else {
+            m_entities.insert(entity);
+            m_components.push_back(std::move(value.value()));
+            m_max_entity = std::max(m_max_entity, entity);
+        }
+    }
+
+protected:
+    /// Description of the component
+    Description m_description;
+    /// Entities having a value, m_entities.entities()[i] has the value m_components[i]
+    SparseSet m_entities;
+    /// Values of the component, packed
+    std::vector<T> m_components;
+    /// The maximum entity id that ever had a value in this array
+    Entity m_max_entity = 0;
+};
+
+}    // namespace pivot::ecs::component
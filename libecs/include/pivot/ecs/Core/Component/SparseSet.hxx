@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <pivot/ecs/Core/types.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief Set of entities, packed in a dense array
+ *
+ * The entities are stored contiguously, in no particular order, so iterating over the set never reads a missing
+ * entity. A sparse array, allocated by pages, maps every entity to its index in the dense array, so looking up,
+ * adding and removing an entity are constant time.
+ *
+ * Containers storing a value per entity keep their values in a vector in the same order as entities(), and mirror
+ * the swap of erase() on it.
+ */
+class SparseSet
+{
+public:
+    /// Amount of entities mapped by a page of the sparse array
+    static constexpr std::size_t pageSize = 4096;
+
+    /// Returns true if the entity is in the set
+    bool contains(Entity entity) const noexcept
+    {
+        const auto page = entity / pageSize;
+        return page < m_pages.size() && m_pages[page] && (*m_pages[page])[entity % pageSize] != noIndex;
+    }
+
+    /// Returns the index of the entity in entities(), which must be in the set
+    std::size_t index(Entity entity) const noexcept { return (*m_pages[entity / pageSize])[entity % pageSize]; }
+
+    /// Returns the index of the entity in entities(), if it is in the set
+    std::optional<std::size_t> find(Entity entity) const noexcept
+    {
+        if (!contains(entity)) return std::nullopt;
+        return index(entity);
+    }
+
+    /// Add the entity at the end of entities(), and returns its index. The entity must not be in the set.
+    std::size_t insert(Entity entity);
+
+    /** \brief Remove the entity, and returns the index it had
+     *
+     * The last entity is moved to this index, the caller must do the same with its values.
+     */
+    std::optional<std::size_t> erase(Entity entity) noexcept;
+
+    /// Remove every entity, keeping the allocated pages
+    void clear() noexcept;
+
+    /// Entities of the set
+    std::span<const Entity> entities() const noexcept { return m_dense; }
+    /// Amount of entities in the set
+    std::size_t size() const noexcept { return m_dense.size(); }
+    /// Returns true if the set is empty
+    bool empty() const noexcept { return m_dense.empty(); }
+
+private:
+    static constexpr std::uint32_t noIndex = std::numeric_limits<std::uint32_t>::max();
+    using Page = std::array<std::uint32_t, pageSize>;
+
+    std::vector<Entity> m_dense;
+    std::vector<std::unique_ptr<Page>> m_pages;
+};
+
+}    // namespace pivot::ecs::component
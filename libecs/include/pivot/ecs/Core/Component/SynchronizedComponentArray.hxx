@@ -78,8 +78,8 @@ public:
         return internalComponentArray.getData();
     }
 
-    /// Returns the booleans specifying whether an an entity has the component
-    const std::vector<bool> &getExistence() const
+    /// Returns the bits specifying whether an an entity has the component
+    const EntityBitmap &getExistence() const
     {
         pivotAssert(!accessMutex.try_lock());
         return internalComponentArray.getExistence();
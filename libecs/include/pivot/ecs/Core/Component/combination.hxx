@@ -2,7 +2,12 @@
 
 #include <algorithm>
 #include <span>
+#include <vector>
 
+#include <pivot/pivot.hxx>
+
+#include <pivot/ecs/Core/Component/EntityBitmap.hxx>
+#include <pivot/ecs/Core/Component/query.hxx>
 #include <pivot/ecs/Core/Component/ref.hxx>
 
 namespace pivot::ecs::component
@@ -12,12 +17,29 @@ namespace pivot::ecs::component
  *
  * This class is a range which allows iterating over the component values
  * for each entity which is present in every array.
+ *
+ * The entities are visited in increasing order, without probing every entity id
+ * when possible:
+ * - if a sparse array is small enough, only its entities are visited,
+ * - otherwise the existence bitmaps of the dense arrays, and bitmaps built from the
+ *   sparse arrays, are intersected a word at a time, and only the entities present
+ *   in all of them are visited.
+ *
+ * In both cases, the other arrays are only probed for the visited entities.
+ *
+ * When the combination is built from a Query kept up to date by the component
+ * Manager, the entities of the query are visited in its order, without probing.
  */
 class ArrayCombination
 {
 public:
     /// Default constructor
     ArrayCombination(std::vector<std::reference_wrapper<IComponentArray>> arrays): m_arrays(arrays) {}
+    /// Combination visiting the entities of a query, which must have the components of every array
+    ArrayCombination(std::vector<std::reference_wrapper<IComponentArray>> arrays, const Query &query)
+        : m_arrays(arrays), m_query(&query)
+    {
+    }
 
     /** \brief One combination of components on an entity
      *
@@ -63,6 +85,16 @@ public:
         }
     };
 
+    /// Position of an iterator in the entities visited by the combination
+    struct Cursor {
+        /// Next entity id, next index in the entities of the sparse array, or next bitmap word to visit
+        std::size_t position = 0;
+        /// Bits of the current bitmap word which were not visited yet
+        EntityBitmap::Word bits = 0;
+        /// Entities visited so far, counted by the profiler once the iteration ends
+        std::size_t visited = 0;
+    };
+
     /// Iterator over all entity having components in each array
     class iterator
     {
@@ -71,7 +103,8 @@ public:
         explicit iterator(ArrayCombination &intersection)
             : m_max_entity(intersection.maxEntity()), m_combination(intersection, 0)
         {
-            if (!m_combination.isValid()) { goToNextValidEntity(); }
+            intersection.prepare();
+            goToNextValidEntity();
         }
         /// End constructor
         explicit iterator(ArrayCombination &intersection, bool)
@@ -100,15 +133,16 @@ public:
     private:
         void goToNextValidEntity()
         {
-            Entity &entity = m_combination.entity;
-            while (entity <= m_max_entity) {
-                entity++;
-                if (m_combination.isValid()) { return; }
-            }
+            m_combination.entity = m_combination.intersection.next(m_cursor, m_max_entity);
+            if (m_combination.entity <= m_max_entity)
+                m_cursor.visited++;
+            else
+                PROFILE_COUNTER("Entities iterated", m_cursor.visited);
         }
 
         Entity m_max_entity;
         ComponentCombination m_combination;
+        Cursor m_cursor;
     };
 
     /// Begin iterator
@@ -120,11 +154,39 @@ public:
     std::span<std::reference_wrapper<IComponentArray>> arrays() { return m_arrays; }
     /// Access the arrays (const)
     std::span<const std::reference_wrapper<IComponentArray>> arrays() const { return m_arrays; }
+    /// Query whose entities are visited, if any
+    const Query *query() const { return m_query; }
 
 private:
+    /// How the entities are visited
+    enum class Strategy {
+        /// Probe every entity id
+        Probe,
+        /// Visit the entities of the smallest sparse array
+        Sparse,
+        /// Visit the entities present in every existence bitmap
+        Bitmap,
+        /// Visit the entities of the query
+        Cached,
+    };
+
     Entity maxEntity() const;
     bool entityHasValue(Entity entity) const;
+    /// Choose how to visit the entities, before iterating
+    void prepare();
+    /// Returns the next entity present in every array, or maxEntity + 1
+    Entity next(Cursor &cursor, Entity maxEntity) const;
 
     std::vector<std::reference_wrapper<IComponentArray>> m_arrays;
+    Strategy m_strategy = Strategy::Probe;
+    const component::Query *m_query = nullptr;
+    /// Entities of the smallest sparse array sorted, or entities of the query
+    std::vector<Entity> m_sparseEntities;
+    /// Existence bitmaps of the dense arrays
+    std::vector<const EntityBitmap *> m_bitmaps;
+    /// Bitmaps built from the entities of the sparse arrays
+    std::vector<EntityBitmap> m_snapshots;
+    /// Arrays which are not dense, and must still be probed for the entities present in every bitmap
+    std::vector<const IComponentArray *> m_probed;
 };
 }    // namespace pivot::ecs::component
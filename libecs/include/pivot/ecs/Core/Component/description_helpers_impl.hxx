@@ -1,7 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <numeric>
+#include <ranges>
 #include <set>
+#include <utility>
 
 #include <boost/fusion/include/adapt_struct.hpp>
 #include <boost/fusion/include/for_each.hpp>
@@ -37,10 +42,40 @@ concept ComponentType = ComponentBaseType<T> || ComponentComplexType<T>;
 
 template <ComponentComplexType T>
 struct Helpers<T> {
+    static constexpr std::size_t fieldCount = boost::fusion::result_of::size<T>::value;
+    using Indices = boost::mpl::range_c<unsigned, 0, fieldCount>;
+
+    /// Names of the members, interned once, and where they are in a Record, whose fields are sorted by name
+    struct Layout {
+        /// In declaration order
+        std::array<data::FieldName, fieldCount> names;
+        /// Index in the record of every member
+        std::array<std::size_t, fieldCount> recordIndex;
+        /// Member at every index of the record
+        std::array<std::size_t, fieldCount> members;
+    };
+
+    static const Layout &layout()
+    {
+        static const Layout layout = [] {
+            auto names = [&]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                return std::array<data::FieldName, fieldCount>{
+                    data::FieldName(boost::fusion::extension::struct_member_name<T, I>::call())...};
+            }
+            (std::make_index_sequence<fieldCount>{});
+            Layout result{.names = names, .recordIndex = {}, .members = {}};
+            std::iota(result.members.begin(), result.members.end(), 0);
+            std::ranges::sort(result.members, {}, [&](std::size_t member) { return names[member]; });
+            for (std::size_t i = 0; i < fieldCount; i++) result.recordIndex[result.members[i]] = i;
+            return result;
+        }();
+        return layout;
+    }
+
     static data::Type getType()
     {
         data::RecordType record;
-        using Indices = boost::mpl::range_c<unsigned, 0, boost::fusion::result_of::size<T>::value>;
         boost::fusion::for_each(Indices(), [&](auto i) {
             std::string field_name = boost::fusion::extension::struct_member_name<T, decltype(i)::value>::call();
             using value_type = typename boost::fusion::result_of::value_at_c<T, decltype(i)::value>::type;
@@ -52,30 +87,37 @@ struct Helpers<T> {
 
     static data::Value createValueFromType(const T &v)
     {
-        data::Record record;
-        using Indices = boost::mpl::range_c<unsigned, 0, boost::fusion::result_of::size<T>::value>;
+        std::array<data::Value, fieldCount> values;
         boost::fusion::for_each(Indices(), [&](auto i) {
-            std::string field_name = boost::fusion::extension::struct_member_name<T, decltype(i)::value>::call();
             using value_type = typename boost::fusion::result_of::value_at_c<T, decltype(i)::value>::type;
             auto it = boost::fusion::advance_c<decltype(i)::value>(boost::fusion::begin(v));
-            record.insert({field_name, Helpers<value_type>::createValueFromType(*it)});
+            values[decltype(i)::value] = Helpers<value_type>::createValueFromType(*it);
         });
-        return {record};
+
+        // The fields are moved straight into the record, in name order
+        const auto &fields = layout();
+        auto record = fields.members | std::views::transform([&](std::size_t member) {
+                          return data::Record::value_type(fields.names[member], std::move(values[member]));
+                      });
+        return {data::Record(record.begin(), record.end())};
     }
 
     static void updateTypeWithValue(T &data, const data::Value &value)
     {
         data = T{};
         auto &record = std::get<data::Record>(value);
-        using Indices = boost::mpl::range_c<unsigned, 0, boost::fusion::result_of::size<T>::value>;
+        const auto &fields = layout();
         boost::fusion::for_each(Indices(), [&](auto i) {
-            std::string field_name = boost::fusion::extension::struct_member_name<T, decltype(i)::value>::call();
             using value_type = typename boost::fusion::result_of::value_at_c<T, decltype(i)::value>::type;
             auto it = boost::fusion::advance_c<decltype(i)::value>(boost::fusion::begin(data));
             value_type &member = *it;
-            if (record.contains(field_name)) {
-                const data::Value &member_value = record.at(field_name);
-                Helpers<value_type>::updateTypeWithValue(member, member_value);
+            const auto &name = fields.names[decltype(i)::value];
+            const auto index = fields.recordIndex[decltype(i)::value];
+            // A record with every field of the type has this one at the same index
+            if (index < record.size() && record.field(index).first == name) {
+                Helpers<value_type>::updateTypeWithValue(member, record.field(index).second);
+            } else if (auto field = record.find(name.str()); field != record.end()) {
+                Helpers<value_type>::updateTypeWithValue(member, field->second);
             }
         });
     }
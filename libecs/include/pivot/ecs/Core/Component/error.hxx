@@ -33,4 +33,12 @@ struct InvalidComponentValue : public std::logic_error {
                            received.toString() + " but expected " + expected.toString() + "."){};
 };
 
+/// Error thrown when typed access is requested to a component array which does not store this C++ type
+struct InvalidComponentArray : public std::logic_error {
+    /// Creates an InvalidComponentArray error
+    InvalidComponentArray(const std::string &component_name, const std::type_info &requested)
+        : std::logic_error(std::string("Component ") + component_name + " is not stored as " + requested.name() +
+                           "."){};
+};
+
 }    // namespace pivot::ecs::component
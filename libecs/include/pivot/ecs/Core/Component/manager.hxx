@@ -8,9 +8,12 @@
 #include <any>
 #include <memory>
 
+#include "pivot/ecs/Core/Component/ArchetypeStorage.hxx"
 #include "pivot/ecs/Core/Component/array.hxx"
+#include "pivot/ecs/Core/Component/query.hxx"
 #include "pivot/ecs/Core/Component/ref.hxx"
 #include "pivot/ecs/Core/EcsException.hxx"
+#include "pivot/ecs/Core/EntityManager.hxx"
 #include "pivot/ecs/Core/types.hxx"
 
 namespace pivot::ecs::component
@@ -21,6 +24,9 @@ namespace pivot::ecs::component
  * The Manager stores all the IComponentArray of all the components registered
  * in the scene. It assigns a ComponentId to each component type registered in
  * the Scene.
+ *
+ * It also keeps the Signature of every entity, and the entities of each Query, up to date when components are added
+ * or removed. When an EntityManager is given, the signatures are mirrored to it.
  */
 class Manager
 {
@@ -28,9 +34,14 @@ public:
     /// Numerical id associated to a component type when it is first registered in the Scene.
     using ComponentId = ComponentType;
 
+    /// Creates a Manager which does not update any EntityManager
+    Manager() = default;
+    /// Creates a Manager which keeps the signatures of the EntityManager up to date
+    explicit Manager(EntityManager &entityManager): m_entityManager(&entityManager) {}
+
     /** \brief Registers a component in the scene.
      *
-     * Its corresponsing IComponentArray is created.
+     * Its corresponsing IComponentArray is created. At most MAX_COMPONENTS can be registered.
      */
     ComponentId RegisterComponent(const Description &componentDescription);
 
@@ -52,12 +63,34 @@ public:
     /// Get the component array of ComponentId.
     IComponentArray &GetComponentArray(ComponentId index);
 
+    /// Returns the components of the entity
+    Signature GetSignature(Entity entity) const;
+
+    /** \brief Returns the Query of the entities having every component of the signature
+     *
+     * The query is created on the first call, and stays valid as long as the Manager.
+     */
+    const Query &GetQuery(const Signature &signature);
+
+    /// Get the storage of the components stored in archetypes
+    ArchetypeStorage &GetArchetypeStorage() { return *m_archetypes; }
+    /// \copydoc GetArchetypeStorage
+    const ArchetypeStorage &GetArchetypeStorage() const { return *m_archetypes; }
+
 private:
     using component_array_type = std::vector<std::unique_ptr<IComponentArray>>;
     using value_type = std::pair<const Description &, std::optional<data::Value>>;
 
     component_array_type m_componentArrays;
     std::map<std::string, ComponentId, std::less<>> m_componentNameToIndex;
+    // Heap allocated so that the arrays attached to it stay valid when the Manager is moved
+    std::unique_ptr<ArchetypeStorage> m_archetypes = std::make_unique<ArchetypeStorage>();
+    EntityManager *m_entityManager = nullptr;
+    std::vector<Signature> m_signatures;
+    // Heap allocated so that the references returned by GetQuery stay valid
+    std::vector<std::unique_ptr<Query>> m_queries;
+
+    void setSignature(Entity entity, const Signature &signature);
 
 public:
     /// Returns a range containing all components of the entity
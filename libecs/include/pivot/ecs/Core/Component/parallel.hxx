@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <initializer_list>
+
+#include <pivot/Threading/ParallelAlgorithms.hxx>
+#include <pivot/ecs/Core/Component/EntityBitmap.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief Call f(entity) in parallel for every entity present in all the existence bitmaps
+ *
+ * This is meant for systems iterating over dense component spans, indexed by entity. The entities are split in chunks
+ * of a multiple of EntityBitmap::wordBits entities: a chunk reads whole words of the bitmaps, and its part of every
+ * component span is a multiple of 64 bytes, so two chunks do not write to the same cache lines but at their borders.
+ *
+ * f must be safe to call concurrently for different entities. Without a pool, or on a pool without threads, every
+ * entity is visited on the calling thread, in increasing order.
+ *
+ * \param grain Amount of entities in a chunk, rounded up to a multiple of EntityBitmap::wordBits. 0 for automatic.
+ */
+template <typename F>
+requires std::is_invocable_v<F, Entity>
+void parallelForEach(ThreadPool *pool, std::initializer_list<std::reference_wrapper<const EntityBitmap>> existence,
+                     F &&f, std::size_t grain = 0)
+{
+    if (existence.size() == 0) return;
+    const std::size_t wordCount =
+        std::ranges::min(existence, {}, [](const EntityBitmap &bitmap) { return bitmap.words().size(); })
+            .get()
+            .words()
+            .size();
+
+    auto visitWords = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            EntityBitmap::Word word = ~EntityBitmap::Word(0);
+            for (const EntityBitmap &bitmap: existence) word &= bitmap.words()[i];
+            for (; word != 0; word &= word - 1) f(Entity(i * EntityBitmap::wordBits + std::countr_zero(word)));
+        }
+    };
+    if (!pool) return visitWords(0, wordCount);
+    const std::size_t wordGrain = (grain + EntityBitmap::wordBits - 1) / EntityBitmap::wordBits;
+    parallel_for_chunks(*pool, 0, wordCount, visitWords, wordGrain);
+}
+
+}    // namespace pivot::ecs::component
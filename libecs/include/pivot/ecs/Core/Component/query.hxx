@@ -0,0 +1,55 @@
+#pragma once
+
+#include <span>
+
+#include <pivot/ecs/Core/Component/SparseSet.hxx>
+#include <pivot/ecs/Core/types.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief Cached list of the entities having a set of components
+ *
+ * A Query is created by the component Manager, which keeps it up to date when components are added to or removed
+ * from an entity. Iterating over its entities never visits an entity missing one of the components.
+ *
+ * The components must be added and removed through the Manager for the Query to see the change.
+ */
+class Query
+{
+public:
+    /// Creates an empty query, the Manager fills it
+    explicit Query(const Signature &signature): m_signature(signature) {}
+
+    /// Components the entities must have
+    const Signature &signature() const noexcept { return m_signature; }
+    /// Returns true if an entity with this signature is part of the query
+    bool matches(const Signature &signature) const noexcept { return (signature & m_signature) == m_signature; }
+
+    /// Entities having every component of the query, packed in no particular order
+    std::span<const Entity> entities() const noexcept { return m_entities.entities(); }
+    /// Returns true if the entity has every component of the query
+    bool contains(Entity entity) const noexcept { return m_entities.contains(entity); }
+
+private:
+    /// Update the membership of an entity after its signature changed
+    void update(Entity entity, const Signature &oldSignature, const Signature &newSignature)
+    {
+        // Entities without any component are not part of any query
+        const bool wasMatching = oldSignature.any() && matches(oldSignature);
+        const bool isMatching = newSignature.any() && matches(newSignature);
+        if (wasMatching == isMatching) return;
+        if (isMatching) {
+            m_entities.insert(entity);
+        } else {
+            m_entities.erase(entity);
+        }
+    }
+
+    Signature m_signature;
+    SparseSet m_entities;
+
+    friend class Manager;
+};
+
+}    // namespace pivot::ecs::component
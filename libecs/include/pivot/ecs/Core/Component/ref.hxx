@@ -34,6 +34,9 @@ public:
     /// Retrieve the entity number of this component ref
     Entity entity() const { return m_entity; }
 
+    /// Retrieve the array containing the component
+    IComponentArray &array() const { return m_array; }
+
     /// Error thrown when a component ref not refering to an existing compoent is dereference
     struct MissingComponent : std::logic_error {
         /// Creates a MissingComponent error
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+
+#include <pivot/ecs/Core/Component/DenseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/SparseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/combination.hxx>
+#include <pivot/ecs/Core/Component/error.hxx>
+#include <pivot/ecs/Core/Component/manager.hxx>
+
+namespace pivot::ecs::component
+{
+
+/** \brief Typed access to the values of a component array storing T natively
+ *
+ * The values are accessed as T directly, without converting them to and from data::Value like IComponentArray does.
+ * The DenseTypedComponentArray and SparseComponentArray of T are supported. Their subclasses, which may keep an index
+ * of the values like TagArray, can only be accessed through a const T.
+ *
+ * The SynchronizedTypedComponentArray are not supported, as their values may only be accessed with their mutex locked:
+ * lock them and use their getData() instead.
+ */
+template <typename T>
+class TypedArray
+{
+public:
+    /// Type of the values stored in the array
+    using Stored = std::remove_const_t<T>;
+
+    /// Throws InvalidComponentArray if the array does not store T natively
+    explicit TypedArray(IComponentArray &array)
+        : m_dense(dynamic_cast<DenseTypedComponentArray<Stored> *>(&array)),
+          m_sparse(dynamic_cast<SparseComponentArray<Stored> *>(&array))
+    {
+        if constexpr (!std::is_const_v<T>) {
+            if (m_dense && typeid(array) != typeid(DenseTypedComponentArray<Stored>)) m_dense = nullptr;
+            if (m_sparse && typeid(array) != typeid(SparseComponentArray<Stored>)) m_sparse = nullptr;
+        }
+        if (!m_dense && !m_sparse) throw InvalidComponentArray(array.getDescription().name, typeid(T));
+    }
+
+    /// Returns a pointer to the value of the entity, or nullptr if it has none
+    T *find(Entity entity) const { return m_dense ? m_dense->findEntity(entity) : m_sparse->findEntity(entity); }
+
+    /// Returns the value of an entity which has one, without checking it
+    T &operator[](Entity entity) const
+    {
+        if (m_dense) return m_dense->getData()[entity];
+        return *m_sparse->findEntity(entity);
+    }
+
+private:
+    DenseTypedComponentArray<Stored> *m_dense;
+    SparseComponentArray<Stored> *m_sparse;
+};
+
+/** \brief A typed reference to a component of an entity
+ *
+ * Like ComponentRef, but the value is accessed as a T & instead of being converted to a data::Value.
+ */
+template <typename T>
+class TypedRef
+{
+public:
+    /// Throws InvalidComponentArray if the array does not store T, and MissingComponent if the entity has no value
+    TypedRef(IComponentArray &array, Entity entity): m_value(TypedArray<T>(array).find(entity)), m_entity(entity)
+    {
+        if (!m_value) throw ComponentRef::MissingComponent(array.getDescription(), entity);
+    }
+    /// Typed reference to the same component as a ComponentRef
+    explicit TypedRef(const ComponentRef &ref): TypedRef(ref.array(), ref.entity()) {}
+
+    /// Value of the component
+    T &get() const { return *m_value; }
+    /// Same as get()
+    T &operator*() const { return *m_value; }
+    /// Access the members of the value
+    T *operator->() const { return m_value; }
+
+    /// Retrieve the entity number of this component ref
+    Entity entity() const { return m_entity; }
+
+private:
+    T *m_value;
+    Entity m_entity;
+};
+
+/** \brief Iterates over the entities having every component T..., with typed access to their values
+ *
+ * The entities are visited like by the ArrayCombination of the arrays, and every element is a
+ * std::tuple<Entity, T &...>.
+ */
+template <typename... T>
+class View
+{
+public:
+    /// Arrays storing each of the components, in the same order as T...
+    using Arrays = std::array<std::reference_wrapper<IComponentArray>, sizeof...(T)>;
+
+    /// Throws InvalidComponentArray if one of the arrays does not store its type natively
+    explicit View(Arrays arrays)
+        : m_arrays(makeArrays(arrays, std::index_sequence_for<T...>{})),
+          m_combination(std::vector<std::reference_wrapper<IComponentArray>>(arrays.begin(), arrays.end()))
+    {
+    }
+    /// View over the entities of an ArrayCombination, whose first arrays store T...
+    explicit View(const ArrayCombination &combination)
+        : m_arrays(makeArrays(combination.arrays(), std::index_sequence_for<T...>{})),
+          m_combination(combination.query() ? ArrayCombination(copyArrays(combination), *combination.query())
+                                            : ArrayCombination(copyArrays(combination)))
+    {
+    }
+
+    /// Iterator over the components of every entity
+    class iterator
+    {
+    public:
+        /// @cond
+        using value_type = std::tuple<Entity, T &...>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator(const View &view, ArrayCombination::iterator combination): m_view(&view), m_combination(combination)
+        {
+        }
+
+        iterator &operator++()
+        {
+            ++m_combination;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+        bool operator==(const iterator &other) const { return m_combination == other.m_combination; }
+        value_type operator*() const
+        {
+            const Entity entity = m_combination->entity;
+            return std::apply(
+                [entity](const TypedArray<T> &...arrays) { return value_type(entity, arrays[entity]...); },
+                m_view->m_arrays);
+        }
+        /// @endcond
+
+    private:
+        const View *m_view;
+        ArrayCombination::iterator m_combination;
+    };
+
+    /// Begin iterator
+    iterator begin() { return {*this, m_combination.begin()}; }
+    /// End iterator
+    iterator end() { return {*this, m_combination.end()}; }
+
+private:
+    template <std::size_t... I>
+    static std::tuple<TypedArray<T>...> makeArrays(std::span<const std::reference_wrapper<IComponentArray>> arrays,
+                                                   std::index_sequence<I...>)
+    {
+        if (arrays.size() < sizeof...(T)) throw std::out_of_range("Not enough component arrays for the view");
+        return {TypedArray<T>(arrays[I].get())...};
+    }
+    static std::vector<std::reference_wrapper<IComponentArray>> copyArrays(const ArrayCombination &combination)
+    {
+        return {combination.arrays().begin(), combination.arrays().end()};
+    }
+
+    std::tuple<TypedArray<T>...> m_arrays;
+    ArrayCombination m_combination;
+};
+
+/** \brief View over the entities of a component Manager having every component T...
+ *
+ * Every T must be registered with its T::description, in an array supported by TypedArray.
+ */
+template <typename... T>
+View<T...> view(Manager &manager)
+{
+    auto getArray = [&manager](const Description &description) -> std::reference_wrapper<IComponentArray> {
+        const auto id = manager.GetComponentId(description.name);
+        if (!id) throw EcsException("Component " + description.name + " is not registered.");
+        return manager.GetComponentArray(id.value());
+    };
+    return View<T...>(typename View<T...>::Arrays{getArray(std::remove_const_t<T>::description)...});
+}
+
+}    // namespace pivot::ecs::component
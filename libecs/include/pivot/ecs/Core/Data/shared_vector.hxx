@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pivot::ecs::data
+{
+
+/** \brief A vector whose elements are shared between its copies until one of them is modified
+ *
+ * Copying a SharedVector only increments a reference count, the elements are copied by the first modification of a
+ * vector sharing them. The reference count and the elements are stored in a single allocation, and the vector itself
+ * is a single pointer.
+ *
+ * Once a vector has handed out a mutable reference or iterator to its elements, it is not shared by its next copies
+ * anymore, so that the reference keeps pointing to its own elements only. Read the elements through a const vector,
+ * and modify them with push_back(), modify() or eraseAt(), which do not hand out references, to keep it shareable.
+ *
+ * An empty SharedVector does not allocate. The elements are read through the same const interface as std::vector.
+ */
+template <typename T>
+class SharedVector
+{
+public:
+    /// @cond
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+    /// @endcond
+
+    /// Creates an empty vector
+    SharedVector() = default;
+    /// Creates a vector containing the values
+    SharedVector(std::initializer_list<T> values): SharedVector(values.begin(), values.end()) {}
+    /// Takes the values, moving them into the storage of the vector
+    SharedVector(std::vector<T> values)
+        : SharedVector(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()))
+    {
+    }
+    /// Creates a vector containing the values of a range of known size, in a single allocation
+    template <std::input_iterator Iterator>
+    requires std::sized_sentinel_for<Iterator, Iterator>
+    SharedVector(Iterator first, Iterator last)
+    {
+        const auto count = static_cast<size_type>(last - first);
+        if (count == 0) return;
+        m_storage = Storage::create(count);
+        for (; first != last; ++first) m_storage->emplace(*first);
+    }
+
+    /// Shares the elements of other, unless mutable references to them may exist
+    SharedVector(const SharedVector &other)
+    {
+        if (!other.m_storage) return;
+        if (other.m_storage->unshareable) {
+            m_storage = Storage::copy(*other.m_storage, other.m_storage->size);
+        } else {
+            other.m_storage->references.fetch_add(1, std::memory_order_relaxed);
+            m_storage = other.m_storage;
+        }
+    }
+    /// Takes the elements of other
+    SharedVector(SharedVector &&other) noexcept: m_storage(std::exchange(other.m_storage, nullptr)) {}
+    /// Shares the elements of other, unless mutable references to them may exist
+    SharedVector &operator=(const SharedVector &other)
+    {
+        if (this != &other) *this = SharedVector(other);
+        return *this;
+    }
+    /// Takes the elements of other
+    SharedVector &operator=(SharedVector &&other) noexcept
+    {
+        if (this != &other) Storage::release(std::exchange(m_storage, std::exchange(other.m_storage, nullptr)));
+        return *this;
+    }
+    /// Releases the elements, they are destroyed with their last copy
+    ~SharedVector() { Storage::release(m_storage); }
+
+    /// @cond
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+    const T *data() const noexcept { return m_storage ? m_storage->elements() : nullptr; }
+    size_type size() const noexcept { return m_storage ? m_storage->size : 0; }
+    size_type capacity() const noexcept { return m_storage ? m_storage->capacity : 0; }
+    bool empty() const noexcept { return size() == 0; }
+    const T &operator[](size_type index) const noexcept { return data()[index]; }
+    const T &at(size_type index) const
+    {
+        if (index >= size()) throw std::out_of_range("SharedVector index out of range");
+        return data()[index];
+    }
+    const T &front() const noexcept { return data()[0]; }
+    const T &back() const noexcept { return data()[size() - 1]; }
+
+    iterator begin() { return mut(); }
+    iterator end() { return mut() + size(); }
+    T *data() { return mut(); }
+    T &operator[](size_type index) { return mut()[index]; }
+    T &at(size_type index)
+    {
+        std::as_const(*this).at(index);
+        return mut()[index];
+    }
+    T &front() { return mut()[0]; }
+    T &back() { return mut()[size() - 1]; }
+
+    void push_back(T value)
+    {
+        grow(size() + 1);
+        m_storage->emplace(std::move(value));
+    }
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        push_back(T(std::forward<Args>(args)...));
+        return back();
+    }
+    void pop_back()
+    {
+        detach();
+        std::destroy_at(&m_storage->elements()[--m_storage->size]);
+    }
+    iterator insert(const_iterator position, T value)
+    {
+        const auto index = static_cast<size_type>(position - std::as_const(*this).data());
+        grow(size() + 1);
+        T *elements = m_storage->elements();
+        if (index == m_storage->size) {
+            m_storage->emplace(std::move(value));
+        } else {
+            m_storage->emplace(std::move(elements[m_storage->size - 1]));
+            std::move_backward(elements + index, elements + m_storage->size - 2, elements + m_storage->size - 1);
+            elements[index] = std::move(value);
+        }
+        return begin() + index;
+    }
+    iterator erase(const_iterator position)
+    {
+        const auto index = static_cast<size_type>(position - std::as_const(*this).data());
+        eraseAt(index);
+        return begin() + index;
+    }
+    void reserve(size_type size)
+    {
+        if (size > capacity()) reallocate(size);
+    }
+    void resize(size_type size)
+    {
+        if (size > capacity()) {
+            reallocate(size);
+        } else {
+            detach();
+        }
+        while (m_storage && m_storage->size < size) m_storage->emplace();
+        while (m_storage && m_storage->size > size) std::destroy_at(&m_storage->elements()[--m_storage->size]);
+    }
+    void clear() noexcept { Storage::release(std::exchange(m_storage, nullptr)); }
+    /// @endcond
+
+    /// Modifies an element in place, through a reference which must not outlive the call
+    ///
+    /// Unlike the non-const accessors, this keeps the elements shareable by the next copies of the vector.
+    template <typename F>
+    decltype(auto) modify(size_type index, F &&f)
+    {
+        detach();
+        return std::forward<F>(f)(m_storage->elements()[index]);
+    }
+
+    /// Removes an element, without handing out an iterator like erase()
+    void eraseAt(size_type index)
+    {
+        detach();
+        T *elements = m_storage->elements();
+        std::move(elements + index + 1, elements + m_storage->size, elements + index);
+        std::destroy_at(&elements[--m_storage->size]);
+    }
+
+    /// Compares the elements
+    bool operator==(const SharedVector &other) const
+    {
+        return m_storage == other.m_storage || std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+    /// Returns whether the elements are shared with another vector
+    bool shared() const noexcept { return m_storage && !m_storage->unique(); }
+
+private:
+    /// Reference count and size of the elements, which are stored right after it in the same allocation
+    struct alignas(T) alignas(std::atomic_size_t) Storage {
+        std::atomic_size_t references = 1;
+        /// Mutable references to the elements may exist
+        bool unshareable = false;
+        size_type size = 0;
+        size_type capacity;
+
+        explicit Storage(size_type capacity) noexcept: capacity(capacity) {}
+
+        static Storage *create(size_type capacity)
+        {
+            static_assert(alignof(Storage) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            void *memory = ::operator new(sizeof(Storage) + capacity * sizeof(T));
+            return ::new (memory) Storage(capacity);
+        }
+
+        /// Copies the elements in a new storage, with room for capacity elements
+        static Storage *copy(const Storage &other, size_type capacity)
+        {
+            Storage *storage = create(capacity);
+            try {
+                for (size_type i = 0; i < other.size; i++) storage->emplace(other.elements()[i]);
+            } catch (...) {
+                destroy(storage);
+                throw;
+            }
+            return storage;
+        }
+
+        /// Drops a reference to the storage, and destroys it with the last one
+        static void release(Storage *storage) noexcept
+        {
+            if (storage && storage->references.fetch_sub(1, std::memory_order_acq_rel) == 1) destroy(storage);
+        }
+
+        static void destroy(Storage *storage) noexcept
+        {
+            std::destroy_n(storage->elements(), storage->size);
+            storage->~Storage();
+            ::operator delete(storage);
+        }
+
+        /// The acquire load orders the reads of the copies which were released before the writes which follow
+        bool unique() const noexcept { return references.load(std::memory_order_acquire) == 1; }
+
+        T *elements() noexcept { return reinterpret_cast<T *>(this + 1); }
+        const T *elements() const noexcept { return reinterpret_cast<const T *>(this + 1); }
+
+        /// Constructs an element at the end, there must be room for it
+        template <typename... Args>
+        void emplace(Args &&...args)
+        {
+            std::construct_at(elements() + size, std::forward<Args>(args)...);
+            size++;
+        }
+    };
+
+    /// Replaces the storage by a new one with room for capacity elements, moving the elements unless they are shared
+    void reallocate(size_type capacity)
+    {
+        if (!m_storage || !m_storage->unique()) {
+            Storage *storage = m_storage ? Storage::copy(*m_storage, capacity) : Storage::create(capacity);
+            Storage::release(std::exchange(m_storage, storage));
+            return;
+        }
+        Storage *storage = Storage::create(capacity);
+        for (size_type i = 0; i < m_storage->size; i++) storage->emplace(std::move(m_storage->elements()[i]));
+        Storage::destroy(std::exchange(m_storage, storage));
+    }
+
+    /// Makes room for size elements in storage owned by this vector only
+    void grow(size_type size)
+    {
+        if (size > capacity()) {
+            reallocate(std::max(size, capacity() * 2));
+        } else {
+            detach();
+        }
+    }
+
+    /// Copies the elements if they are shared, before they are modified
+    void detach()
+    {
+        if (m_storage && !m_storage->unique()) reallocate(m_storage->capacity);
+    }
+
+    /// Same as detach(), for a vector whose elements may be modified through a reference after the call
+    T *mut()
+    {
+        if (!m_storage) return nullptr;
+        detach();
+        m_storage->unshareable = true;
+        return m_storage->elements();
+    }
+
+    Storage *m_storage = nullptr;
+};
+
+}    // namespace pivot::ecs::data
@@ -1,10 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <compare>
+#include <cstdint>
 #include <glm/vec3.hpp>
+#include <initializer_list>
+#include <iterator>
 #include <map>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
+#include <vector>
 
+#include <pivot/ecs/Core/Data/shared_vector.hxx>
 #include <pivot/ecs/Core/Data/type.hxx>
 
 namespace pivot::ecs::data
@@ -12,15 +22,141 @@ namespace pivot::ecs::data
 
 struct Value;
 
+/// Id of an interned field name
+using FieldId = std::uint32_t;
+
+/** \brief Name of a field of a Record, interned
+ *
+ * Every distinct name is stored once for the whole program, and identified by its FieldId: copying a FieldName never
+ * allocates, and comparing two of them for equality compares their ids. Creating one from a string looks it up in the
+ * table of the names, which is thread safe.
+ */
+class FieldName
+{
+public:
+    /// Interns the name
+    FieldName(std::string_view name);
+    /// Interns the name
+    FieldName(const std::string &name): FieldName(std::string_view(name)) {}
+    /// Interns the name
+    FieldName(const char *name): FieldName(std::string_view(name)) {}
+
+    /// Id of the name
+    FieldId id() const noexcept { return m_id; }
+    /// The name itself
+    const std::string &str() const noexcept { return *m_name; }
+    /// Same as str()
+    operator const std::string &() const noexcept { return *m_name; }
+
+    /// Compares the ids
+    bool operator==(const FieldName &other) const noexcept { return m_id == other.m_id; }
+    /// Compares the name
+    bool operator==(const std::string &other) const noexcept { return *m_name == other; }
+    /// Compares the name
+    bool operator==(const char *other) const noexcept { return *m_name == other; }
+    /// Orders the names alphabetically
+    std::strong_ordering operator<=>(const FieldName &other) const noexcept
+    {
+        return m_id == other.m_id ? std::strong_ordering::equal : m_name->compare(*other.m_name) <=> 0;
+    }
+
+private:
+    const std::string *m_name;
+    FieldId m_id;
+};
+
+/// Prints the name
+std::ostream &operator<<(std::ostream &stream, const FieldName &name);
+
 /** \brief A record containg a mapping between property names and values
  *
  * This is equivalent to a JSON object
+ *
+ * The fields are stored contiguously, sorted by name like the RecordType describing them, so the field at an index of
+ * the RecordType of a record is at the same index in the record. Looking up a field by name compares the names of the
+ * fields one after the other, which is fast enough for the few fields of a component. The interface is the subset of
+ * std::map used on records.
+ *
+ * The fields are shared by the copies of a record until one of them is modified, see SharedVector. The non-const
+ * lookups hand out mutable references, after which the fields are not shared by the next copies of the record: read
+ * through a const record, and modify a field with modify() to keep them shared.
  */
-struct Record : public std::map<std::string, Value> {
-    using map::map;
+struct Record {
+    /// A field of the record
+    using value_type = std::pair<FieldName, Value>;
+    /// Mutable iterator over the fields, in name order
+    using iterator = SharedVector<value_type>::iterator;
+    /// Constant iterator over the fields, in name order
+    using const_iterator = SharedVector<value_type>::const_iterator;
+
+    /// Creates an empty record
+    Record() = default;
+    /// Creates a record from its fields, only the first field of a name is kept
+    Record(std::initializer_list<value_type> fields);
+    /// Creates a record from its fields, only the first field of a name is kept. Sorted fields are not reordered.
+    explicit Record(std::vector<value_type> fields);
+    /// Creates a record from a range of fields, only the first field of a name is kept
+    ///
+    /// Each field is read once, and fields sorted by name are stored in a single allocation.
+    template <std::input_iterator Iterator>
+    requires std::sized_sentinel_for<Iterator, Iterator>
+    Record(Iterator first, Iterator last);
 
     /// Returns the RecordType corresponding to this Record
     RecordType type() const;
+
+    /// @cond
+    iterator begin() { return m_fields.begin(); }
+    iterator end() { return m_fields.end(); }
+    const_iterator begin() const noexcept { return m_fields.begin(); }
+    const_iterator end() const noexcept { return m_fields.end(); }
+    std::size_t size() const noexcept { return m_fields.size(); }
+    bool empty() const noexcept { return m_fields.empty(); }
+    void clear() noexcept { m_fields.clear(); }
+    void reserve(std::size_t size) { m_fields.reserve(size); }
+    /// @endcond
+
+    /// Field at an index, in name order, without checking it
+    value_type &field(std::size_t index) { return m_fields[index]; }
+    /// Field at an index, in name order, without checking it
+    const value_type &field(std::size_t index) const noexcept { return m_fields[index]; }
+
+    /// Finds a field by name, or returns end()
+    iterator find(std::string_view name);
+    /// Finds a field by name, or returns end()
+    const_iterator find(std::string_view name) const noexcept;
+    /// Returns whether the record has a field
+    bool contains(std::string_view name) const noexcept;
+    /// Returns 1 if the record has a field, 0 otherwise
+    std::size_t count(std::string_view name) const noexcept;
+    /// Value of a field, throws std::out_of_range if there is none
+    Value &at(std::string_view name);
+    /// Value of a field, throws std::out_of_range if there is none
+    const Value &at(std::string_view name) const;
+    /// Value of a field, which is inserted with a default Value if there is none
+    Value &operator[](const FieldName &name);
+
+    /// Modifies a field in place, through a reference which must not outlive the call. Returns false if there is none.
+    ///
+    /// Unlike the non-const lookups, this keeps the fields shareable by the next copies of the record.
+    template <typename F>
+    bool modify(std::string_view name, F &&f);
+
+    /// Inserts a field if there is none with its name
+    std::pair<iterator, bool> insert(value_type field);
+    /// Inserts a field, hint is where it would be inserted to keep the name order, the insertion is O(1) if it is right
+    iterator insert(const_iterator hint, value_type field);
+    /// Inserts a field, or assigns it if there is one with this name
+    std::pair<iterator, bool> insert_or_assign(const FieldName &name, Value value);
+    /// Removes a field, returns the amount of fields removed
+    std::size_t erase(std::string_view name);
+
+    /// Compares the fields
+    bool operator==(const Record &other) const;
+
+private:
+    /// Sorted by name
+    SharedVector<value_type> m_fields;
 };
 
 /// Value containing an entity record and id
@@ -39,8 +175,8 @@ struct ScriptEntity {
 
 /// Value containing a list
 struct List {
-    /// List of values
-    std::vector<data::Value> items;
+    /// List of values, shared by the copies of the list until one of them is modified
+    SharedVector<data::Value> items;
 
     /// List equal List
     bool operator==(const List &rhs) const;
@@ -84,6 +220,110 @@ struct Value : public std::variant<std::string, double, int, bool, glm::vec3, gl
     }
 };
 
+/// @cond
+inline Record::Record(std::initializer_list<value_type> fields): Record(std::vector<value_type>(fields)) {}
+
+inline Record::Record(std::vector<value_type> fields)
+{
+    if (!std::ranges::is_sorted(fields, {}, &value_type::first))
+        std::ranges::stable_sort(fields, {}, &value_type::first);
+    const auto duplicates = std::ranges::unique(fields, {}, &value_type::first);
+    fields.erase(duplicates.begin(), duplicates.end());
+    m_fields = std::move(fields);
+}
+
+template <std::input_iterator Iterator>
+requires std::sized_sentinel_for<Iterator, Iterator>
+Record::Record(Iterator first, Iterator last): m_fields(first, last)
+{
+    const auto &fields = std::as_const(m_fields);
+    const auto sameName = [](const value_type &a, const value_type &b) { return a.first == b.first; };
+    if (std::ranges::is_sorted(fields, {}, &value_type::first) &&
+        std::ranges::adjacent_find(fields, sameName) == fields.end())
+        return;
+    *this = Record(std::vector<value_type>(fields.begin(), fields.end()));
+}
+
+inline Record::iterator Record::find(std::string_view name)
+{
+    return std::ranges::find_if(m_fields, [name](const value_type &field) { return field.first.str() == name; });
+}
+
+inline Record::const_iterator Record::find(std::string_view name) const noexcept
+{
+    return std::ranges::find_if(m_fields, [name](const value_type &field) { return field.first.str() == name; });
+}
+
+inline bool Record::contains(std::string_view name) const noexcept { return find(name) != end(); }
+
+inline std::size_t Record::count(std::string_view name) const noexcept { return contains(name) ? 1 : 0; }
+
+inline Value &Record::at(std::string_view name)
+{
+    auto field = find(name);
+    if (field == end()) throw std::out_of_range("Record has no field " + std::string(name));
+    return field->second;
+}
+
+inline const Value &Record::at(std::string_view name) const
+{
+    auto field = find(name);
+    if (field == end()) throw std::out_of_range("Record has no field " + std::string(name));
+    return field->second;
+}
+
+template <typename F>
+bool Record::modify(std::string_view name, F &&f)
+{
+    const auto &fields = std::as_const(m_fields);
+    const auto field = std::as_const(*this).find(name);
+    if (field == fields.end()) return false;
+    m_fields.modify(field - fields.begin(), [&](value_type &field) { std::forward<F>(f)(field.second); });
+    return true;
+}
+
+inline Value &Record::operator[](const FieldName &name) { return insert({name, Value{}}).first->second; }
+
+inline std::pair<Record::iterator, bool> Record::insert(value_type field)
+{
+    const auto &fields = std::as_const(m_fields);
+    auto position = std::ranges::lower_bound(fields, field.first, {}, &value_type::first);
+    if (position != fields.end() && position->first == field.first) {
+        // begin() may copy the fields, so position must not be used after it
+        const auto index = position - fields.begin();
+        return {begin() + index, false};
+    }
+    return {m_fields.insert(position, std::move(field)), true};
+}
+
+inline Record::iterator Record::insert(const_iterator hint, value_type field)
+{
+    const auto &fields = std::as_const(m_fields);
+    const bool afterPrevious = hint == fields.begin() || std::prev(hint)->first < field.first;
+    const bool beforeNext = hint == fields.end() || field.first < hint->first;
+    if (afterPrevious && beforeNext) return m_fields.insert(hint, std::move(field));
+    return insert(std::move(field)).first;
+}
+
+inline std::pair<Record::iterator, bool> Record::insert_or_assign(const FieldName &name, Value value)
+{
+    auto [field, inserted] = insert({name, Value{}});
+    field->second = std::move(value);
+    return {field, inserted};
+}
+
+inline std::size_t Record::erase(std::string_view name)
+{
+    const auto &fields = std::as_const(m_fields);
+    const auto field = std::as_const(*this).find(name);
+    if (field == fields.end()) return 0;
+    m_fields.eraseAt(field - fields.begin());
+    return 1;
+}
+
+inline bool Record::operator==(const Record &other) const { return m_fields == other.m_fields; }
+/// @endcond
+
 }    // namespace pivot::ecs::data
 
 namespace std
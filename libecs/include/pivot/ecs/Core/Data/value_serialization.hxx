@@ -12,6 +12,12 @@ void to_json(nlohmann::json &json, const Value &value);
 /// Deserialize a Value from json
 void from_json(const nlohmann::json &json, Value &value);
 
+/// Serialize a Record to a json object
+void to_json(nlohmann::json &json, const Record &value);
+
+/// Deserialize a Record from a json object
+void from_json(const nlohmann::json &json, Record &value);
+
 std::ostream &operator<<(std::ostream &stream, const Record &type);
 std::ostream &operator<<(std::ostream &stream, const Value &type);
 
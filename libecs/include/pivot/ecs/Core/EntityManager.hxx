@@ -2,27 +2,123 @@
 
 #include "pivot/ecs/Core/EcsException.hxx"
 #include "pivot/ecs/Core/types.hxx"
-#include <array>
-#include <queue>
-#include <unordered_map>
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
 
 /*! \cond
  */
+/// Allocates the entity ids of a scene
+///
+/// Ids are only created when needed: the slots grow with the amount of entities alive at once. Destroyed ids are
+/// reused in the order they were destroyed, once minimumFreeEntities of them are free, so that a bare Entity kept
+/// after its destruction does not point to the next created entity. Each slot counts how many times its id was
+/// destroyed, so that a Handle taken before the id was reused can be detected as stale.
 class EntityManager
 {
 public:
-    EntityManager();
+    /// Number of destroyed ids kept free before they are reused
+    static constexpr std::size_t minimumFreeEntities = 1024;
+
+    /// An entity id and the generation of its slot when the handle was taken
+    struct Handle {
+        Entity entity = pivot::NULL_ENTITY;
+        std::uint32_t generation = 0;
+
+        auto operator<=>(const Handle &) const = default;
+    };
+
+    /// Non owning view over the living entities and their signatures, in increasing id order
+    ///
+    /// The view reads the manager while iterating, so it stays valid when entities are created or destroyed: destroyed
+    /// entities not reached yet are skipped, and created entities are visited if their id is after the current one.
+    class EntityView
+    {
+    public:
+        class iterator
+        {
+        public:
+            using value_type = std::pair<Entity, const Signature &>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const EntityManager &manager, Entity entity): m_manager(&manager), m_entity(entity) { skipDead(); }
+
+            value_type operator*() const { return {m_entity, m_manager->mSlots[m_entity].signature}; }
+            iterator &operator++()
+            {
+                m_entity++;
+                skipDead();
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+            bool operator==(const iterator &other) const noexcept { return m_entity == other.m_entity; }
+            bool operator==(std::default_sentinel_t) const noexcept { return m_entity >= m_manager->mSlots.size(); }
+
+        private:
+            void skipDead()
+            {
+                while (m_entity < m_manager->mSlots.size() && !m_manager->isAlive(m_entity)) m_entity++;
+            }
+
+            const EntityManager *m_manager = nullptr;
+            Entity m_entity = 0;
+        };
+
+        explicit EntityView(const EntityManager &manager): m_manager(&manager) {}
+
+        iterator begin() const { return {*m_manager, 0}; }
+        std::default_sentinel_t end() const noexcept { return {}; }
+        std::size_t size() const noexcept { return m_manager->getLivingEntityCount(); }
+        bool empty() const noexcept { return size() == 0; }
+
+    private:
+        const EntityManager *m_manager;
+    };
+
     Entity CreateEntity();
     void DestroyEntity(Entity entity);
     void SetSignature(Entity entity, Signature signature);
-    Signature GetSignature(Entity entity);
-    std::unordered_map<Entity, Signature> getEntities() const;
-    uint32_t getLivingEntityCount();
+    Signature GetSignature(Entity entity) const;
+    EntityView getEntities() const noexcept { return EntityView(*this); }
+    uint32_t getLivingEntityCount() const noexcept { return mLivingEntities.size(); }
+
+    /// Living entities, packed in no particular order. Invalidated by CreateEntity and DestroyEntity.
+    std::span<const Entity> getLivingEntities() const noexcept { return mLivingEntities; }
+    bool isAlive(Entity entity) const noexcept
+    {
+        return entity < mSlots.size() && mSlots[entity].livingIndex != noIndex;
+    }
+    /// Returns true if the entity of the handle was not destroyed since the handle was taken
+    bool isAlive(Handle handle) const noexcept
+    {
+        return isAlive(handle.entity) && mSlots[handle.entity].generation == handle.generation;
+    }
+    Handle getHandle(Entity entity) const;
 
 private:
-    std::queue<Entity> mAvailableEntities{};
-    std::unordered_map<Entity, Signature> mEntities;
-    uint32_t mLivingEntityCount{};
+    static constexpr std::uint32_t noIndex = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot {
+        Signature signature;
+        std::uint32_t generation = 0;
+        // Index of the entity in mLivingEntities
+        std::uint32_t livingIndex = noIndex;
+    };
+
+    std::vector<Slot> mSlots;
+    std::deque<Entity> mFreeEntities;
+    std::vector<Entity> mLivingEntities;
 };
 /*! \endcond
  */
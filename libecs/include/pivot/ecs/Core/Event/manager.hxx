@@ -6,26 +6,80 @@
 #include "pivot/ecs/Core/types.hxx"
 
 #include <any>
+#include <limits>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace pivot::ecs::event
 {
 
+/// How the queued events of a same type are merged before being dispatched
+enum class Coalescing {
+    /// Every event is dispatched
+    None,
+    /// Only the last event queued is dispatched
+    Latest,
+    /// Only the last event queued for each list of entities is dispatched
+    LatestPerEntities,
+};
+
 /** \brief Manages all the events in a Scene
  *
  * The Manager send event and execute systems listing this event
+ *
+ * Events are queued, then dispatched by type: the events of a type are handed to the systems as a single batch, in the
+ * order the types were first queued. The child events emitted by the systems are queued in the same way and
+ * dispatched as the next generation, breadth first, up to getMaxDepth() generations. Deeper events stay queued until
+ * the next dispatch.
+ *
+ * The type of an event is resolved to its id in the system dispatch tables when it is queued, events which no system
+ * listens to are dropped.
  */
 class Manager
 {
 public:
+    /// Position of the event ids without a batch in the queue
+    static constexpr std::size_t noBatch = std::numeric_limits<std::size_t>::max();
+    /// Default amount of generations of child events dispatched at once
+    static constexpr std::size_t defaultMaxDepth = 32;
+
     /// Manager constructor take the scene system manager to execute systems
     Manager(systems::Manager &systemManager);
 
-    /// Send event with event::Event Object
+    /// Send event with event::Event Object, dispatching it with every event already queued
     void sendEvent(const Event &event);
+    /// Queue an event, to be dispatched by the next sendEvent or dispatchEvents
+    void queueEvent(Event event);
+    /// Dispatch the queued events and their child events
+    void dispatchEvents();
+    /// Amount of events waiting to be dispatched
+    std::size_t getQueuedEventCount() const noexcept;
+
+    /// Set how the queued events of a type are merged, Coalescing::None by default
+    void setCoalescing(const std::string &eventName, Coalescing coalescing);
+    /// Set the amount of generations of child events dispatched at once
+    void setMaxDepth(std::size_t maxDepth) noexcept { m_maxDepth = maxDepth; }
+    /// Get the amount of generations of child events dispatched at once
+    std::size_t getMaxDepth() const noexcept { return m_maxDepth; }
 
 private:
+    /// Queued events of a type
+    struct Batch {
+        systems::Manager::EventId eventId;
+        Coalescing coalescing;
+        std::vector<Event> events;
+        /// Position of the event of every entity list, for Coalescing::LatestPerEntities
+        std::map<std::vector<Entity>, std::size_t> entityIndex;
+    };
+
     systems::Manager &m_systemManager;
+    std::unordered_map<std::string, Coalescing> m_coalescing;
+    std::vector<Batch> m_queue;
+    /// Position in the queue of the batch of every event id
+    std::vector<std::size_t> m_batchIndex;
+    std::size_t m_maxDepth = defaultMaxDepth;
+    bool m_dispatching = false;
 };
 
-}    // namespace pivot::ecs::event
\ No newline at end of file
+}    // namespace pivot::ecs::event
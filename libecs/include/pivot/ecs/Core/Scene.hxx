@@ -68,8 +68,8 @@ public:
     /// Create e named entity
     Entity CreateEntity(std::string newName);
 
-    /// Get entity list
-    std::unordered_map<Entity, Signature> getEntities() const;
+    /// Get a view over the living entities and their signatures, without copying them
+    EntityManager::EntityView getEntities() const;
 
     /// @param[in] entity  Entity to remove.
     void DestroyEntity(Entity entity);
@@ -103,6 +103,9 @@ public:
     void registerSystem(const systems::Description &description,
                         pivot::OptionalRef<const component::Index> cIndex = std::nullopt);
 
+    /// Run the systems of the scene on a thread pool, see systems::Manager::setThreadPool
+    void setThreadPool(ThreadPool *threadPool) { mSystemManager.setThreadPool(threadPool); }
+
     /// Get the Entity manager
     EntityManager &getEntityManager();
 
@@ -121,22 +124,41 @@ public:
     using AssetTranslator = std::function<std::optional<std::string>(const std::string &)>;
     /// Function used to retrieve the real path of an external ressource
     using ScriptTranslator = std::function<std::optional<std::string>(const std::string &)>;
+    /// Get the systems used by the scene and the scripts and assets it needs, as stored by getJson
+    nlohmann::json getResources(std::optional<AssetTranslator> assetTranslator = std::nullopt,
+                                std::optional<ScriptTranslator> scriptTranslator = std::nullopt) const;
     /// Get scene as json format
     nlohmann::json getJson(std::optional<AssetTranslator> assetTranslator = std::nullopt,
                            std::optional<ScriptTranslator> scriptTranslator = std::nullopt) const;
     /// Save scene in json file
     void save(const std::filesystem::path &path, std::optional<AssetTranslator> assetTranslator = std::nullopt,
               std::optional<ScriptTranslator> scriptTranslator = std::nullopt) const;
+    /// Save scene in a binary scene file, see BinaryScene
+    void saveBinary(const std::filesystem::path &path, std::optional<AssetTranslator> assetTranslator = std::nullopt,
+                    std::optional<ScriptTranslator> scriptTranslator = std::nullopt) const;
 
     // Load
     /// Load a scene from JSON object
     static std::unique_ptr<Scene> load(const nlohmann::json &obj, const pivot::ecs::component::Index &cIndex,
                                        const pivot::ecs::systems::Index &sIndex);
+    /// Load a scene from a JSON stream, without holding the JSON of the whole scene in memory
+    static std::unique_ptr<Scene> loadStream(std::istream &input, const pivot::ecs::component::Index &cIndex,
+                                             const pivot::ecs::systems::Index &sIndex);
+
+    /// Scripts and assets needed by a scene
+    struct Resources {
+        /// Paths of the scripts, relative to the scene
+        std::vector<std::string> scripts;
+        /// Paths of the assets, relative to the scene
+        std::vector<std::string> assets;
+    };
+    /// Read the scripts and assets needed by a JSON scene, without loading it
+    static Resources readResources(std::istream &input);
 
 private:
     std::string name;
-    pivot::ecs::component::Manager mComponentManager;
     EntityManager mEntityManager;
+    pivot::ecs::component::Manager mComponentManager;
     pivot::ecs::systems::Manager mSystemManager;
     pivot::ecs::event::Manager mEventManager;
     pivot::ecs::component::Manager::ComponentId mTagId;
@@ -29,12 +29,23 @@ struct Description {
     event::Description eventListener;
     /// Needed component for event
     std::vector<std::vector<std::string>> eventComponents;
+    /** \brief Components of the system only read by it
+     *
+     * Together with writeComponents, this tells the systems::Manager which systems can run at the same time. When
+     * given, the two lists must contain every component of systemComponents and eventComponents exactly once. A
+     * system without any of them may do anything, so it never runs alongside another system.
+     */
+    std::vector<std::string> readComponents;
+    /// Components of the system which it modifies, see readComponents
+    std::vector<std::string> writeComponents;
     /// Event provenance
     Provenance provenance;
     /// System function
     std::function<std::vector<event::Event>(const Description &, component::ArrayCombination &,
                                             event::EventWithComponent &)>
         system;
+    /// Returns true if the system declared which components it reads and writes
+    bool declaresAccess() const noexcept { return !readComponents.empty() || !writeComponents.empty(); }
     /// Check if all needed variable are set
     void validate() const;
     /// Error returned when the validation of a description fails
@@ -6,7 +6,12 @@
 #include "pivot/ecs/Core/Systems/description.hxx"
 #include "pivot/ecs/Core/Systems/index.hxx"
 
+#include <pivot/Threading/TaskGraph.hxx>
+
 #include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <tuple>
 #include <unordered_map>
 
@@ -15,6 +20,14 @@ namespace pivot::ecs::systems
 /** \brief Manages all the systems in a Scene
  *
  * System are execut when a event is emit
+ *
+ * The event and component names are resolved to ids when a system is used: the systems are stored in a dispatch table
+ * per event type, so executing an event only touches the systems listening to it.
+ *
+ * When a ThreadPool is set, the systems listening to the same event run on it. Two systems conflict when one writes a
+ * component the other uses, according to Description::readComponents and Description::writeComponents. Conflicting
+ * systems run one after the other in name order, the others run at the same time. The child events are returned in
+ * system name order whatever the scheduling was.
  */
 class Manager
 {
@@ -27,8 +40,25 @@ public:
     void useSystem(const std::string &systemName);
     /// register system in a scene by his description
     void useSystem(const Description &description);
-    /// execute the system listening the event
-    std::vector<event::Event> execute(const event::Event &event);
+    /// Id of an event type in the dispatch tables
+    using EventId = std::size_t;
+
+    /// Get the id of an event type, if a system listens to it
+    std::optional<EventId> getEventId(const std::string &eventName) const;
+
+    /// execute the system listening the event, the child events live in the frame arena
+    std::pmr::vector<event::Event> execute(const event::Event &event);
+    /** \brief Execute the systems listening to a batch of events of the same type
+     *
+     * Every system is looked up and scheduled once for the whole batch, and handles the events in order. The child
+     * events live in the frame arena, in system name order and then in event order.
+     */
+    std::pmr::vector<event::Event> execute(std::span<const event::Event> events);
+    /// Execute the systems listening to a batch of events, whose type was resolved with getEventId
+    std::pmr::vector<event::Event> execute(EventId eventId, std::span<const event::Event> events);
+
+    /// Run the systems on the thread pool, or on the calling thread when it is null
+    void setThreadPool(ThreadPool *threadPool) noexcept { m_threadPool = threadPool; }
 
     /// Constant iterator over every system used
     using const_iterator = std::map<std::string, Description>::const_iterator;
@@ -54,12 +84,40 @@ public:
     };
 
 private:
+    /// A used system, with its names resolved to ids
+    struct System {
+        const Description *description;
+        component::ArrayCombination combination;
+        /// Components of every entity of the event
+        std::vector<std::vector<component::Manager::ComponentId>> eventComponents;
+        std::vector<Signature> eventSignatures;
+        Signature read;
+        Signature write;
+    };
+    /// Systems listening to an event, and the graph running them
+    struct Schedule {
+        /// In name order
+        std::vector<System *> systems;
+        TaskGraph graph;
+        /// Events being executed, and the child events of every system
+        std::span<const event::Event> events;
+        std::vector<std::vector<event::Event>> childEvents;
+        bool running = false;
+    };
+
     std::vector<component::Manager::ComponentId> getComponentsId(const std::vector<std::string> &components);
-    std::vector<event::Event> executeOne(const Description &, const event::Event &);
+    Signature getSignature(const std::vector<std::string> &components);
+    std::vector<event::Event> executeBatch(System &, std::span<const event::Event>);
+    void buildSchedule(EventId eventId, const std::string &eventName);
+    static bool conflicts(const System &first, const System &second);
     component::Manager &m_componentManager;
     EntityManager &m_entityManager;
     std::map<std::string, Description> m_systems;
-    std::unordered_map<std::string, component::ArrayCombination> m_combinations;
+    std::unordered_map<std::string, System> m_resolvedSystems;
+    std::unordered_map<std::string, EventId> m_eventIds;
+    // Indexed by event id. Heap allocated, as the tasks of the graph point to their schedule
+    std::vector<std::unique_ptr<Schedule>> m_schedules;
+    ThreadPool *m_threadPool = nullptr;
 };
 
 }    // namespace pivot::ecs::systems
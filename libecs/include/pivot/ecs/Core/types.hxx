@@ -5,7 +5,6 @@
 #include <pivot/utility/entity.hxx>
 
 using Entity = pivot::Entity;
-const Entity MAX_ENTITIES = pivot::MAX_ENTITIES;
 
 constexpr std::uint32_t fnv1a_32(char const *s, std::size_t count)
 {
@@ -15,7 +14,7 @@ constexpr std::uint32_t fnv1a_32(char const *s, std::size_t count)
 constexpr std::uint32_t operator"" _hash(char const *s, std::size_t count) { return fnv1a_32(s, count); }
 
 using ComponentType = std::uint8_t;
-const ComponentType MAX_COMPONENTS = 32;
+const ComponentType MAX_COMPONENTS = 64;
 
 using Signature = std::bitset<MAX_COMPONENTS>;
 
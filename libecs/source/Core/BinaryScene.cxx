@@ -0,0 +1,574 @@
+#include <pivot/ecs/Core/BinaryScene.hxx>
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <type_traits>
+
+#include <pivot/ecs/Core/Data/value_serialization.hxx>
+
+using namespace pivot::ecs;
+
+namespace
+{
+    static_assert(std::endian::native == std::endian::little, "The binary scene format is little-endian");
+
+    constexpr std::array<char, 8> magic = {'P', 'V', 'S', 'C', 'E', 'N', 'E', '\0'};
+    /// Alignment of the blocks and of the columns in the file
+    constexpr std::size_t alignment = 8;
+    /// Maximum depth of the records in the schema
+    constexpr unsigned maxTypeDepth = 64;
+    /// Size of the smallest name and type in the schema: an empty name and a basic type
+    constexpr std::size_t minimumFieldSize = sizeof(std::uint32_t) + 2 * sizeof(std::uint8_t);
+
+    /// Kind of a type in the schema
+    enum class TypeKind : std::uint8_t {
+        Basic,
+        Record,
+    };
+
+    /// Every component of the entities, before being encoded
+    struct Content {
+        /// Entities having a component, and their value
+        struct Column {
+            std::vector<Entity> entities;
+            std::vector<data::Value> values;
+        };
+
+        std::string name;
+        std::uint32_t entityCount = 0;
+        /// Sorted by name, like in the JSON format
+        std::map<std::string, Column> components;
+        std::vector<std::string> systems;
+        std::vector<std::string> scripts;
+        std::vector<std::string> assets;
+    };
+
+    /// Value of type T, or a FormatError
+    template <typename T>
+    const T &as(const data::Value &value, const std::string &component)
+    {
+        if (const T *datum = std::get_if<T>(&value)) return *datum;
+        throw BinaryScene::FormatError("The values of component " + component + " do not all have the same type");
+    }
+
+    /// Reads a T stored anywhere in the file
+    template <typename T>
+    T load(const std::byte *data, std::size_t index = 0)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    class Writer
+    {
+    public:
+        template <typename T>
+        void write(const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            std::memcpy(extend(sizeof(T)), &value, sizeof(T));
+        }
+
+        void write(std::string_view string)
+        {
+            write(static_cast<std::uint32_t>(string.size()));
+            std::memcpy(extend(string.size()), string.data(), string.size());
+        }
+
+        void write(const std::vector<std::string> &strings)
+        {
+            write(static_cast<std::uint32_t>(strings.size()));
+            for (const auto &string: strings) write(std::string_view(string));
+        }
+
+        void writeType(const data::Type &type)
+        {
+            if (auto basic = std::get_if<data::BasicType>(&type)) {
+                write(TypeKind::Basic);
+                write(static_cast<std::uint8_t>(*basic));
+            } else {
+                const auto &record = std::get<data::RecordType>(type);
+                write(TypeKind::Record);
+                write(static_cast<std::uint32_t>(record.size()));
+                for (const auto &[name, fieldType]: record) {
+                    write(std::string_view(name));
+                    writeType(fieldType);
+                }
+            }
+        }
+
+        /// Writes the basic fields of the values in columns, the values must have the given type
+        void writeColumns(const data::Type &type, std::span<const data::Value *const> values,
+                          const std::string &component)
+        {
+            if (auto record = std::get_if<data::RecordType>(&type)) {
+                std::vector<const data::Value *> fields(values.size());
+                std::size_t index = 0;
+                for (const auto &[name, fieldType]: *record) {
+                    for (std::size_t i = 0; i < values.size(); i++) {
+                        const auto &value = as<data::Record>(*values[i], component);
+                        if (value.size() != record->size() || value.field(index).first != name)
+                            throw BinaryScene::FormatError("The values of component " + component +
+                                                           " do not all have the same fields");
+                        fields[i] = &value.field(index).second;
+                    }
+                    writeColumns(fieldType, fields, component);
+                    index++;
+                }
+                return;
+            }
+            switch (std::get<data::BasicType>(type)) {
+                case data::BasicType::String:
+                    writeStrings(values, [&](const data::Value &v) { return as<std::string>(v, component); });
+                    break;
+                case data::BasicType::Asset:
+                    writeStrings(values, [&](const data::Value &v) { return as<data::Asset>(v, component).name; });
+                    break;
+                case data::BasicType::Number:
+                    writeFixed<double>(values, [&](const data::Value &v) { return as<double>(v, component); });
+                    break;
+                case data::BasicType::Integer:
+                    writeFixed<std::int32_t>(values, [&](const data::Value &v) { return as<int>(v, component); });
+                    break;
+                case data::BasicType::Boolean:
+                    writeFixed<std::uint8_t>(values, [&](const data::Value &v) { return as<bool>(v, component); });
+                    break;
+                case data::BasicType::Vec3:
+                    writeFixed<std::array<float, 3>>(values, [&](const data::Value &v) {
+                        const auto &vec = as<glm::vec3>(v, component);
+                        return std::array<float, 3>{vec.x, vec.y, vec.z};
+                    });
+                    break;
+                case data::BasicType::Vec2:
+                    writeFixed<std::array<float, 2>>(values, [&](const data::Value &v) {
+                        const auto &vec = as<glm::vec2>(v, component);
+                        return std::array<float, 2>{vec.x, vec.y};
+                    });
+                    break;
+                case data::BasicType::Color:
+                    writeFixed<std::array<float, 4>>(
+                        values, [&](const data::Value &v) { return as<data::Color>(v, component).rgba; });
+                    break;
+                case data::BasicType::EntityRef:
+                    writeFixed<Entity>(values,
+                                       [&](const data::Value &v) { return as<pivot::EntityRef>(v, component).ref; });
+                    break;
+                case data::BasicType::Void:
+                    for (const auto *value: values) as<data::Void>(*value, component);
+                    break;
+                case data::BasicType::ScriptEntity:
+                case data::BasicType::List:
+                    throw BinaryScene::FormatError("Component " + component + " can't be stored in a binary scene");
+            }
+        }
+
+        /// Reserves space for a column
+        std::byte *column(std::size_t size)
+        {
+            align();
+            return extend(size);
+        }
+
+        void align() { m_data.resize((m_data.size() + alignment - 1) / alignment * alignment); }
+
+        std::size_t size() const { return m_data.size(); }
+        std::vector<std::byte> &data() { return m_data; }
+
+    private:
+        std::byte *extend(std::size_t size)
+        {
+            const auto offset = m_data.size();
+            m_data.resize(offset + size);
+            return m_data.data() + offset;
+        }
+
+        template <typename T, typename F>
+        void writeFixed(std::span<const data::Value *const> values, F &&get)
+        {
+            std::byte *data = column(values.size() * sizeof(T));
+            for (std::size_t i = 0; i < values.size(); i++) {
+                const T datum = get(*values[i]);
+                std::memcpy(data + i * sizeof(T), &datum, sizeof(T));
+            }
+        }
+
+        /// Offsets of the strings in their characters, followed by the characters
+        template <typename F>
+        void writeStrings(std::span<const data::Value *const> values, F &&get)
+        {
+            std::vector<std::uint32_t> offsets(values.size() + 1, 0);
+            for (std::size_t i = 0; i < values.size(); i++)
+                offsets[i + 1] = offsets[i] + static_cast<std::uint32_t>(get(*values[i]).size());
+            std::memcpy(column(offsets.size() * sizeof(std::uint32_t)), offsets.data(),
+                        offsets.size() * sizeof(std::uint32_t));
+            std::byte *characters = column(offsets.back());
+            for (std::size_t i = 0; i < values.size(); i++) {
+                const std::string &string = get(*values[i]);
+                std::memcpy(characters + offsets[i], string.data(), string.size());
+            }
+        }
+
+        std::vector<std::byte> m_data;
+    };
+
+    class Reader
+    {
+    public:
+        explicit Reader(std::span<const std::byte> data, std::size_t offset = 0): m_data(data), m_offset(offset) {}
+
+        template <typename T>
+        T read()
+        {
+            return load<T>(bytes(sizeof(T)));
+        }
+
+        std::string readString()
+        {
+            const auto size = read<std::uint32_t>();
+            const auto *characters = bytes(size);
+            return std::string(reinterpret_cast<const char *>(characters), size);
+        }
+
+        std::vector<std::string> readStrings()
+        {
+            std::vector<std::string> strings(readCount(sizeof(std::uint32_t)));
+            for (auto &string: strings) string = readString();
+            return strings;
+        }
+
+        /// Reads a number of elements, which can't be larger than the remaining elements of minimumSize bytes
+        std::size_t readCount(std::size_t minimumSize)
+        {
+            const std::size_t count = read<std::uint32_t>();
+            if (count > (m_data.size() - m_offset) / minimumSize)
+                throw BinaryScene::FormatError("The binary scene is truncated");
+            return count;
+        }
+
+        data::Type readType(unsigned depth = 0)
+        {
+            if (depth > maxTypeDepth) throw BinaryScene::FormatError("The records of the schema are too deep");
+            const auto kind = read<TypeKind>();
+            if (kind == TypeKind::Basic) {
+                const auto basic = read<std::uint8_t>();
+                // Color is the last basic type
+                if (basic > static_cast<std::uint8_t>(data::BasicType::Color))
+                    throw BinaryScene::FormatError("Unknown basic type " + std::to_string(basic));
+                return static_cast<data::BasicType>(basic);
+            }
+            if (kind != TypeKind::Record) throw BinaryScene::FormatError("Unknown kind of type");
+            data::RecordType record;
+            const auto size = readCount(minimumFieldSize);
+            for (std::size_t i = 0; i < size; i++) {
+                auto name = readString();
+                record.emplace(std::move(name), readType(depth + 1));
+            }
+            return record;
+        }
+
+        /// Reads the columns of the basic fields of count values of the given type
+        std::vector<data::Value> readColumns(const data::Type &type, std::size_t count)
+        {
+            std::vector<data::Value> values;
+            values.reserve(count);
+            if (auto record = std::get_if<data::RecordType>(&type)) {
+                std::vector<std::pair<data::FieldName, std::vector<data::Value>>> fields;
+                fields.reserve(record->size());
+                for (const auto &[name, fieldType]: *record) fields.emplace_back(name, readColumns(fieldType, count));
+                for (std::size_t i = 0; i < count; i++) {
+                    std::vector<data::Record::value_type> value;
+                    value.reserve(fields.size());
+                    for (auto &[name, column]: fields) value.emplace_back(name, std::move(column[i]));
+                    values.emplace_back(data::Record(std::move(value)));
+                }
+                return values;
+            }
+            switch (std::get<data::BasicType>(type)) {
+                case data::BasicType::String:
+                    readStrings(count, [&](std::string string) { values.emplace_back(std::move(string)); });
+                    break;
+                case data::BasicType::Asset:
+                    readStrings(count,
+                                [&](std::string string) { values.emplace_back(data::Asset{std::move(string)}); });
+                    break;
+                case data::BasicType::Number:
+                    readFixed<double>(count, [&](double datum) { values.emplace_back(datum); });
+                    break;
+                case data::BasicType::Integer:
+                    readFixed<std::int32_t>(count, [&](std::int32_t datum) { values.emplace_back(int(datum)); });
+                    break;
+                case data::BasicType::Boolean:
+                    readFixed<std::uint8_t>(count, [&](std::uint8_t datum) { values.emplace_back(datum != 0); });
+                    break;
+                case data::BasicType::Vec3:
+                    readFixed<std::array<float, 3>>(count, [&](std::array<float, 3> datum) {
+                        values.emplace_back(glm::vec3(datum[0], datum[1], datum[2]));
+                    });
+                    break;
+                case data::BasicType::Vec2:
+                    readFixed<std::array<float, 2>>(
+                        count, [&](std::array<float, 2> datum) { values.emplace_back(glm::vec2(datum[0], datum[1])); });
+                    break;
+                case data::BasicType::Color:
+                    readFixed<std::array<float, 4>>(
+                        count, [&](std::array<float, 4> datum) { values.emplace_back(data::Color{datum}); });
+                    break;
+                case data::BasicType::EntityRef:
+                    readFixed<Entity>(count, [&](Entity datum) { values.emplace_back(pivot::EntityRef{datum}); });
+                    break;
+                case data::BasicType::Void: values.resize(count, data::Value{data::Void{}}); break;
+                case data::BasicType::ScriptEntity:
+                case data::BasicType::List: throw BinaryScene::FormatError("Invalid type in the schema");
+            }
+            return values;
+        }
+
+        /// Bytes of a column, which is aligned
+        const std::byte *column(std::size_t size)
+        {
+            align();
+            return bytes(size);
+        }
+
+        void align() { m_offset = (m_offset + alignment - 1) / alignment * alignment; }
+        void skip(std::size_t size) { bytes(size); }
+
+        std::size_t offset() const { return m_offset; }
+
+    private:
+        const std::byte *bytes(std::size_t size)
+        {
+            if (m_offset > m_data.size() || size > m_data.size() - m_offset)
+                throw BinaryScene::FormatError("The binary scene is truncated");
+            const auto *data = m_data.data() + m_offset;
+            m_offset += size;
+            return data;
+        }
+
+        template <typename T, typename F>
+        void readFixed(std::size_t count, F &&f)
+        {
+            const std::byte *data = column(count * sizeof(T));
+            for (std::size_t i = 0; i < count; i++) f(load<T>(data, i));
+        }
+
+        template <typename F>
+        void readStrings(std::size_t count, F &&f)
+        {
+            const std::byte *offsets = column((count + 1) * sizeof(std::uint32_t));
+            const auto *characters = reinterpret_cast<const char *>(column(load<std::uint32_t>(offsets, count)));
+            for (std::size_t i = 0; i < count; i++) {
+                const auto begin = load<std::uint32_t>(offsets, i);
+                const auto end = load<std::uint32_t>(offsets, i + 1);
+                if (begin > end || end > load<std::uint32_t>(offsets, count))
+                    throw BinaryScene::FormatError("Invalid string in the binary scene");
+                f(std::string(characters + begin, end - begin));
+            }
+        }
+
+        std::span<const std::byte> m_data;
+        std::size_t m_offset;
+    };
+
+    std::vector<std::byte> encode(const Content &content)
+    {
+        Writer writer;
+        for (char c: magic) writer.write(c);
+        writer.write(BinaryScene::version);
+        writer.write(content.entityCount);
+        writer.write(std::string_view(content.name));
+        writer.write(content.systems);
+        writer.write(content.scripts);
+        writer.write(content.assets);
+
+        // The type of a component is the one of its values, so that they are read back exactly like from JSON
+        std::vector<data::Type> types;
+        writer.write(static_cast<std::uint32_t>(content.components.size()));
+        for (const auto &[name, column]: content.components) {
+            types.push_back(column.values.front().type());
+            writer.write(std::string_view(name));
+            writer.writeType(types.back());
+        }
+
+        auto type = types.begin();
+        for (const auto &[name, column]: content.components) {
+            writer.align();
+            const auto sizeOffset = writer.size();
+            writer.write(std::uint64_t(0));
+            writer.write(static_cast<std::uint32_t>(column.entities.size()));
+            std::memcpy(writer.column(column.entities.size() * sizeof(Entity)), column.entities.data(),
+                        column.entities.size() * sizeof(Entity));
+            std::vector<const data::Value *> values;
+            values.reserve(column.values.size());
+            for (const auto &value: column.values) values.push_back(&value);
+            writer.writeColumns(*type++, values, name);
+            const std::uint64_t blockSize = writer.size() - sizeOffset - sizeof(std::uint64_t);
+            std::memcpy(writer.data().data() + sizeOffset, &blockSize, sizeof(blockSize));
+        }
+        return std::move(writer.data());
+    }
+}    // namespace
+
+BinaryScene::BinaryScene(const std::filesystem::path &path): m_file(path), m_data(m_file.data()) { readHeader(); }
+
+BinaryScene::BinaryScene(std::span<const std::byte> data): m_data(data) { readHeader(); }
+
+bool BinaryScene::isBinaryScene(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::array<char, magic.size()> header{};
+    file.read(header.data(), header.size());
+    return file && header == magic;
+}
+
+void BinaryScene::readHeader()
+{
+    PROFILE_FUNCTION();
+    Reader reader(m_data);
+    for (char c: magic) {
+        if (reader.read<char>() != c) throw FormatError("Not a binary scene");
+    }
+    if (const auto fileVersion = reader.read<std::uint32_t>(); fileVersion != version)
+        throw FormatError("Unsupported binary scene version " + std::to_string(fileVersion));
+    m_entityCount = reader.read<std::uint32_t>();
+    m_name = reader.readString();
+    m_systems = reader.readStrings();
+    m_scripts = reader.readStrings();
+    m_assets = reader.readStrings();
+
+    m_schema.resize(reader.readCount(minimumFieldSize));
+    for (auto &[name, type]: m_schema) {
+        name = reader.readString();
+        type = reader.readType();
+    }
+    for (std::size_t component = 0; component < m_schema.size(); component++) {
+        reader.align();
+        m_blocks.push_back({component, reader.offset()});
+        reader.skip(reader.read<std::uint64_t>());
+    }
+}
+
+template <typename F>
+void BinaryScene::forEachBlock(F &&f) const
+{
+    for (const auto &block: m_blocks) {
+        const auto &[name, type] = m_schema.at(block.component);
+        Reader reader(m_data, block.offset);
+        reader.read<std::uint64_t>();
+        const auto count = reader.read<std::uint32_t>();
+        const auto *column = reader.column(count * sizeof(Entity));
+        std::vector<Entity> entities(count);
+        std::memcpy(entities.data(), column, count * sizeof(Entity));
+        for (const Entity entity: entities) {
+            if (entity >= m_entityCount)
+                throw FormatError("Component " + name + " of entity " + std::to_string(entity) +
+                                  " is out of the scene");
+        }
+        f(name, entities, reader.readColumns(type, count));
+    }
+}
+
+std::unique_ptr<Scene> BinaryScene::load(const component::Index &cIndex, const systems::Index &sIndex) const
+{
+    PROFILE_FUNCTION();
+    auto scene = std::make_unique<Scene>(m_name);
+    auto &componentManager = scene->getComponentManager();
+    auto &entityManager = scene->getEntityManager();
+
+    for (std::uint32_t i = 0; i < m_entityCount; i++) entityManager.CreateEntity();
+    forEachBlock([&](const std::string &name, const std::vector<Entity> &entities, std::vector<data::Value> values) {
+        auto componentId = componentManager.GetComponentId(name);
+        if (!componentId) {
+            auto description = cIndex.getDescription(name);
+            if (!description.has_value()) throw std::runtime_error("Unknown Component " + name);
+            componentId = componentManager.RegisterComponent(description.value());
+        }
+        for (std::size_t i = 0; i < entities.size(); i++)
+            componentManager.AddComponent(entities[i], std::move(values[i]), componentId.value());
+    });
+    for (const auto &system: m_systems) {
+        auto description = sIndex.getDescription(system);
+        if (!description.has_value()) throw std::runtime_error("Unknown System " + system);
+        scene->registerSystem(description.value());
+    }
+    return scene;
+}
+
+nlohmann::json BinaryScene::toJson() const
+{
+    PROFILE_FUNCTION();
+    nlohmann::json output;
+    output["name"] = m_name;
+    if (m_entityCount > 0) {
+        auto &components = output["components"];
+        components = nlohmann::json::array();
+        for (std::uint32_t i = 0; i < m_entityCount; i++) components.push_back(nullptr);
+        forEachBlock(
+            [&](const std::string &name, const std::vector<Entity> &entities, std::vector<data::Value> values) {
+                for (std::size_t i = 0; i < entities.size(); i++)
+                    components[entities[i]][name] = nlohmann::json(values[i]);
+            });
+    }
+    output["systems"] = m_systems;
+    output["scripts"] = m_scripts;
+    output["assets"] = m_assets;
+    return output;
+}
+
+std::vector<std::byte> BinaryScene::fromJson(const nlohmann::json &scene)
+{
+    PROFILE_FUNCTION();
+    Content content;
+    content.name = scene.at("name").get<std::string>();
+    if (scene.contains("components")) {
+        const auto &entities = scene["components"];
+        content.entityCount = static_cast<std::uint32_t>(entities.size());
+        for (Entity entity = 0; entity < content.entityCount; entity++) {
+            for (const auto &component: entities[entity].items()) {
+                auto &column = content.components[component.key()];
+                column.entities.push_back(entity);
+                column.values.push_back(component.value().get<data::Value>());
+            }
+        }
+    }
+    if (scene.contains("systems")) content.systems = scene["systems"].get<std::vector<std::string>>();
+    if (scene.contains("scripts")) content.scripts = scene["scripts"].get<std::vector<std::string>>();
+    if (scene.contains("assets")) content.assets = scene["assets"].get<std::vector<std::string>>();
+    return encode(content);
+}
+
+std::vector<std::byte> BinaryScene::fromScene(const Scene &scene, std::optional<Scene::AssetTranslator> assetTranslator,
+                                              std::optional<Scene::ScriptTranslator> scriptTranslator)
+{
+    PROFILE_FUNCTION();
+    Content content;
+    content.name = scene.getName();
+    const auto &componentManager = scene.getComponentManager();
+    for (auto [entity, _]: scene.getEntityManager().getEntities()) {
+        for (component::ComponentRef ref: componentManager.GetAllComponents(entity)) {
+            auto &column = content.components[ref.description().name];
+            column.entities.push_back(entity);
+            column.values.push_back(ref.get());
+            // Like the JSON array of the components, which ends with the last entity having one
+            content.entityCount = std::max(content.entityCount, entity + 1);
+        }
+    }
+    const auto resources = scene.getResources(assetTranslator, scriptTranslator);
+    content.systems = resources["systems"].get<std::vector<std::string>>();
+    content.scripts = resources["scripts"].get<std::vector<std::string>>();
+    content.assets = resources["assets"].get<std::vector<std::string>>();
+    return encode(content);
+}
+
+void BinaryScene::write(const std::filesystem::path &path, std::span<const std::byte> data)
+{
+    PROFILE_FUNCTION();
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!out) throw std::runtime_error("Could not write the binary scene " + path.string());
+}
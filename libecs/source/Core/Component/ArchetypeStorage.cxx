@@ -0,0 +1,212 @@
+#include "pivot/ecs/Core/Component/ArchetypeStorage.hxx"
+
+#include <algorithm>
+
+#include "pivot/ecs/Core/EcsException.hxx"
+#include "pivot/pivot.hxx"
+
+namespace pivot::ecs::component
+{
+
+static constexpr std::size_t chunkAlignment = 64;
+
+static std::size_t alignUp(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+    for (auto &archetype: m_archetypes) {
+        for (auto &chunk: archetype->m_chunks) {
+            for (std::size_t column = 0; column < archetype->m_components.size(); column++) {
+                const auto &type = m_types[archetype->m_components[column]];
+                for (std::size_t row = 0; row < chunk->m_size; row++)
+                    type.destroy(chunk->m_data.get() + archetype->m_offsets[column + 1] + row * type.size);
+            }
+        }
+    }
+}
+
+void ArchetypeStorage::registerComponent(ComponentType component, ArchetypeColumnType type)
+{
+    if (component >= MAX_COMPONENTS) throw EcsException("Too many components registered.");
+    m_registered.set(component);
+    m_types[component] = type;
+}
+
+Signature ArchetypeStorage::getSignature(Entity entity) const noexcept
+{
+    if (entity >= m_locations.size() || m_locations[entity].archetype == noArchetype) return {};
+    return m_archetypes[m_locations[entity].archetype]->m_signature;
+}
+
+void *ArchetypeStorage::get(Entity entity, ComponentType component) noexcept
+{
+    if (!contains(entity, component)) return nullptr;
+    const auto &location = m_locations[entity];
+    return value(location, m_archetypes[location.archetype]->m_columnIndex[component]);
+}
+
+void ArchetypeStorage::insert(Entity entity, ComponentType component, void *source)
+{
+    pivotAssertMsg(isRegistered(component), "Component is not stored in the archetypes");
+    const auto &type = m_types[component];
+
+    if (entity >= m_locations.size()) m_locations.resize(entity + 1);
+    const Location oldLocation = m_locations[entity];
+    if (oldLocation.archetype != noArchetype && m_archetypes[oldLocation.archetype]->m_signature.test(component)) {
+        void *current = value(oldLocation, m_archetypes[oldLocation.archetype]->m_columnIndex[component]);
+        type.destroy(current);
+        type.relocate(current, source);
+        return;
+    }
+
+    Signature signature = getSignature(entity);
+    signature.set(component);
+    const auto archetypeIndex = getArchetype(signature);
+    const Location newLocation = pushRow(archetypeIndex, entity);
+    const Archetype &archetype = *m_archetypes[archetypeIndex];
+    type.relocate(value(newLocation, archetype.m_columnIndex[component]), source);
+
+    if (oldLocation.archetype != noArchetype) {
+        const Archetype &oldArchetype = *m_archetypes[oldLocation.archetype];
+        for (std::size_t column = 0; column < oldArchetype.m_components.size(); column++) {
+            const auto moved = oldArchetype.m_components[column];
+            m_types[moved].relocate(value(newLocation, archetype.m_columnIndex[moved]),
+                                    value(oldLocation, column + 1));
+        }
+        eraseRow(oldLocation);
+    }
+    m_locations[entity] = newLocation;
+}
+
+void ArchetypeStorage::remove(Entity entity, ComponentType component)
+{
+    if (!contains(entity, component)) return;
+    const Location oldLocation = m_locations[entity];
+    const Archetype &oldArchetype = *m_archetypes[oldLocation.archetype];
+    m_types[component].destroy(value(oldLocation, oldArchetype.m_columnIndex[component]));
+
+    Signature signature = oldArchetype.m_signature;
+    signature.reset(component);
+    if (signature.none()) {
+        eraseRow(oldLocation);
+        m_locations[entity] = {};
+        return;
+    }
+
+    const auto archetypeIndex = getArchetype(signature);
+    const Location newLocation = pushRow(archetypeIndex, entity);
+    const Archetype &archetype = *m_archetypes[archetypeIndex];
+    // getArchetype may have added an archetype, the reference to the old one is still valid as they are heap allocated
+    for (std::size_t column = 0; column < oldArchetype.m_components.size(); column++) {
+        const auto moved = oldArchetype.m_components[column];
+        if (moved == component) continue;
+        m_types[moved].relocate(value(newLocation, archetype.m_columnIndex[moved]), value(oldLocation, column + 1));
+    }
+    eraseRow(oldLocation);
+    m_locations[entity] = newLocation;
+}
+
+void ArchetypeStorage::removeEntity(Entity entity)
+{
+    if (entity >= m_locations.size() || m_locations[entity].archetype == noArchetype) return;
+    const Location location = m_locations[entity];
+    const Archetype &archetype = *m_archetypes[location.archetype];
+    for (std::size_t column = 0; column < archetype.m_components.size(); column++)
+        m_types[archetype.m_components[column]].destroy(value(location, column + 1));
+    eraseRow(location);
+    m_locations[entity] = {};
+}
+
+std::uint32_t ArchetypeStorage::getArchetype(const Signature &signature)
+{
+    auto iter = m_archetypeIndex.find(signature);
+    if (iter != m_archetypeIndex.end()) return iter->second;
+
+    auto archetype = std::make_unique<Archetype>();
+    archetype->m_signature = signature;
+    std::size_t rowSize = sizeof(Entity);
+    std::size_t padding = 0;
+    for (ComponentType component = 0; component < MAX_COMPONENTS; component++) {
+        if (!signature.test(component)) continue;
+        archetype->m_columnIndex[component] = archetype->m_components.size() + 1;
+        archetype->m_components.push_back(component);
+        rowSize += m_types[component].size;
+        padding += m_types[component].alignment;
+    }
+
+    // Leave room for the alignment of every column, a single row must always fit
+    archetype->m_chunkCapacity = std::max<std::size_t>((chunkSize - std::min(padding, chunkSize)) / rowSize, 1);
+    std::size_t offset = 0;
+    archetype->m_offsets.push_back(offset);
+    offset += sizeof(Entity) * archetype->m_chunkCapacity;
+    for (auto component: archetype->m_components) {
+        offset = alignUp(offset, m_types[component].alignment);
+        archetype->m_offsets.push_back(offset);
+        offset += m_types[component].size * archetype->m_chunkCapacity;
+    }
+    archetype->m_chunkBytes = alignUp(offset, chunkAlignment);
+
+    const auto index = static_cast<std::uint32_t>(m_archetypes.size());
+    m_archetypes.push_back(std::move(archetype));
+    m_archetypeIndex.emplace(signature, index);
+    return index;
+}
+
+ArchetypeStorage::Location ArchetypeStorage::pushRow(std::uint32_t archetypeIndex, Entity entity)
+{
+    Archetype &archetype = *m_archetypes[archetypeIndex];
+    if (archetype.m_chunks.empty() || archetype.m_chunks.back()->m_size == archetype.m_chunkCapacity) {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->m_data.reset(
+            static_cast<std::byte *>(::operator new[](archetype.m_chunkBytes, std::align_val_t(chunkAlignment))));
+        chunk->m_offsets = archetype.m_offsets;
+        archetype.m_chunks.push_back(std::move(chunk));
+    }
+    Chunk &chunk = *archetype.m_chunks.back();
+    const Location location{
+        .archetype = archetypeIndex,
+        .chunk = static_cast<std::uint32_t>(archetype.m_chunks.size() - 1),
+        .row = static_cast<std::uint32_t>(chunk.m_size),
+    };
+    reinterpret_cast<Entity *>(chunk.m_data.get())[chunk.m_size] = entity;
+    chunk.m_size++;
+    archetype.m_size++;
+    return location;
+}
+
+void ArchetypeStorage::eraseRow(const Location &location)
+{
+    Archetype &archetype = *m_archetypes[location.archetype];
+    Chunk &lastChunk = *archetype.m_chunks.back();
+    const Location last{
+        .archetype = location.archetype,
+        .chunk = static_cast<std::uint32_t>(archetype.m_chunks.size() - 1),
+        .row = static_cast<std::uint32_t>(lastChunk.m_size - 1),
+    };
+
+    if (last.chunk != location.chunk || last.row != location.row) {
+        // Fill the hole with the last row of the archetype
+        const Entity movedEntity = reinterpret_cast<Entity *>(lastChunk.m_data.get())[last.row];
+        for (std::size_t column = 0; column < archetype.m_components.size(); column++)
+            m_types[archetype.m_components[column]].relocate(value(location, column + 1), value(last, column + 1));
+        reinterpret_cast<Entity *>(archetype.m_chunks[location.chunk]->m_data.get())[location.row] = movedEntity;
+        m_locations[movedEntity] = location;
+    }
+
+    lastChunk.m_size--;
+    archetype.m_size--;
+    if (lastChunk.m_size == 0) archetype.m_chunks.pop_back();
+}
+
+void *ArchetypeStorage::value(const Location &location, std::size_t columnIndex) noexcept
+{
+    const Archetype &archetype = *m_archetypes[location.archetype];
+    const auto component = archetype.m_components[columnIndex - 1];
+    return archetype.m_chunks[location.chunk]->m_data.get() + archetype.m_offsets[columnIndex] +
+           location.row * m_types[component].size;
+}
+
+}    // namespace pivot::ecs::component
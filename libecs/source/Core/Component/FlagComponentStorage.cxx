@@ -20,7 +20,7 @@ void FlagComponentStorage::setValueForEntity(Entity entity, std::optional<data::
         if (!std::holds_alternative<data::Void>(*value)) {
             throw InvalidComponentValue(m_description.name, m_description.type, value->type());
         }
-        m_entity_having_component.insert(entity);
+        if (!m_entity_having_component.contains(entity)) m_entity_having_component.insert(entity);
         m_max_entity = std::max(m_max_entity, entity);
     } else {
         m_entity_having_component.erase(entity);
@@ -29,5 +29,7 @@ void FlagComponentStorage::setValueForEntity(Entity entity, std::optional<data::
 
 Entity FlagComponentStorage::maxEntity() const { return m_max_entity; }
 
-const std::set<Entity> &FlagComponentStorage::getData() { return m_entity_having_component; }
+std::span<const Entity> FlagComponentStorage::getEntities() const { return m_entity_having_component.entities(); }
+
+std::span<const Entity> FlagComponentStorage::getData() const { return m_entity_having_component.entities(); }
 }    // namespace pivot::ecs::component
@@ -7,23 +7,31 @@ const Description &ScriptingComponentArray::getDescription() const { return m_de
 
 std::optional<data::Value> ScriptingComponentArray::getValueForEntity(Entity entity) const
 {
-    auto value = m_components.find(entity);
-    if (value == m_components.end()) return std::nullopt;
-    return value->second;
+    auto index = m_entities.find(entity);
+    if (!index) return std::nullopt;
+    return m_components[*index];
 }
 
 void ScriptingComponentArray::setValueForEntity(Entity entity, std::optional<data::Value> value)
 {
     if (!value) {
-        m_components.erase(entity);
+        auto removed = m_entities.erase(entity);
+        if (!removed) return;
+        if (*removed + 1 != m_components.size()) m_components[*removed] = std::move(m_components.back());
+        m_components.pop_back();
+    } else if (auto index = m_entities.find(entity)) {
+        m_components[*index] = std::move(value.value());
     } else {
-        m_components[entity] = value.value();
+        m_entities.insert(entity);
+        m_components.push_back(std::move(value.value()));
         m_max_entity = std::max(entity, m_max_entity);
     }
 }
 
-bool ScriptingComponentArray::entityHasValue(Entity entity) const { return m_components.contains(entity); }
+bool ScriptingComponentArray::entityHasValue(Entity entity) const { return m_entities.contains(entity); }
 
 Entity ScriptingComponentArray::maxEntity() const { return m_max_entity; }
 
+std::span<const Entity> ScriptingComponentArray::getEntities() const { return m_entities.entities(); }
+
 }    // namespace pivot::ecs::component
@@ -0,0 +1,40 @@
+#include "pivot/ecs/Core/Component/SparseSet.hxx"
+
+#include "pivot/pivot.hxx"
+
+namespace pivot::ecs::component
+{
+
+std::size_t SparseSet::insert(Entity entity)
+{
+    pivotAssertMsg(!contains(entity), "The entity is already in the set");
+    const auto page = entity / pageSize;
+    if (page >= m_pages.size()) m_pages.resize(page + 1);
+    if (!m_pages[page]) {
+        m_pages[page] = std::make_unique<Page>();
+        m_pages[page]->fill(noIndex);
+    }
+    (*m_pages[page])[entity % pageSize] = m_dense.size();
+    m_dense.push_back(entity);
+    return m_dense.size() - 1;
+}
+
+std::optional<std::size_t> SparseSet::erase(Entity entity) noexcept
+{
+    if (!contains(entity)) return std::nullopt;
+    const auto removed = index(entity);
+    const Entity last = m_dense.back();
+    m_dense[removed] = last;
+    (*m_pages[last / pageSize])[last % pageSize] = removed;
+    (*m_pages[entity / pageSize])[entity % pageSize] = noIndex;
+    m_dense.pop_back();
+    return removed;
+}
+
+void SparseSet::clear() noexcept
+{
+    for (auto entity: m_dense) (*m_pages[entity / pageSize])[entity % pageSize] = noIndex;
+    m_dense.clear();
+}
+
+}    // namespace pivot::ecs::component
@@ -1,8 +1,15 @@
+#include <bit>
+
+#include <pivot/ecs/Core/Component/DenseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/SparseComponentArray.hxx>
 #include <pivot/ecs/Core/Component/combination.hxx>
 
 namespace pivot::ecs::component
 {
 
+/// Below this ratio of entities in the smallest sparse array, sorting and visiting them is faster than scanning bitmaps
+static constexpr std::size_t sparseRatio = 16;
+
 Entity ArrayCombination::maxEntity() const
 {
     if (m_arrays.empty()) return 0;
@@ -18,4 +25,104 @@ bool ArrayCombination::entityHasValue(Entity entity) const
 
     return std::ranges::all_of(m_arrays, [=](auto &array) { return array.get().entityHasValue(entity); });
 }
+
+void ArrayCombination::prepare()
+{
+    m_strategy = Strategy::Probe;
+    m_sparseEntities.clear();
+    m_bitmaps.clear();
+    m_snapshots.clear();
+    m_probed.clear();
+
+    if (m_query) {
+        // Copied, so that the iteration is not disturbed if the system adds or removes components
+        m_strategy = Strategy::Cached;
+        m_sparseEntities.assign(m_query->entities().begin(), m_query->entities().end());
+        return;
+    }
+
+    const ISparseComponentArray *smallest = nullptr;
+    for (auto &array: m_arrays) {
+        if (auto *dense = dynamic_cast<const IDenseComponentArray *>(&array.get())) {
+            m_bitmaps.push_back(&dense->getExistence());
+            continue;
+        }
+        m_probed.push_back(&array.get());
+        auto *sparse = dynamic_cast<const ISparseComponentArray *>(&array.get());
+        if (sparse && (!smallest || sparse->getEntities().size() < smallest->getEntities().size())) smallest = sparse;
+    }
+
+    if (smallest && smallest->getEntities().size() * sparseRatio < maxEntity() + 1) {
+        // Copied, so that the iteration is not disturbed if the system modifies the array
+        m_strategy = Strategy::Sparse;
+        m_sparseEntities.assign(smallest->getEntities().begin(), smallest->getEntities().end());
+        std::ranges::sort(m_sparseEntities);
+    } else if (!m_bitmaps.empty() || smallest) {
+        // Large sparse arrays are turned into bitmaps, which is cheaper than sorting their entities. Sparse arrays used
+        // by most entities would not skip enough entities to pay for it, they are only probed.
+        m_strategy = Strategy::Bitmap;
+        for (auto *array: m_probed) {
+            auto *sparse = dynamic_cast<const ISparseComponentArray *>(array);
+            if (!sparse || sparse->getEntities().size() * 2 > maxEntity() + 1) continue;
+            auto &snapshot = m_snapshots.emplace_back();
+            snapshot.resize(array->maxEntity() + 1);
+            for (auto entity: sparse->getEntities()) snapshot[entity] = true;
+        }
+    }
+}
+
+Entity ArrayCombination::next(Cursor &cursor, Entity maxEntity) const
+{
+    const Entity end = maxEntity + 1;
+    switch (m_strategy) {
+        case Strategy::Probe:
+            while (cursor.position <= maxEntity) {
+                const Entity entity = cursor.position++;
+                if (entityHasValue(entity)) return entity;
+            }
+            return end;
+
+        case Strategy::Sparse:
+            while (cursor.position < m_sparseEntities.size()) {
+                const Entity entity = m_sparseEntities[cursor.position++];
+                if (entityHasValue(entity)) return entity;
+            }
+            return end;
+
+        case Strategy::Cached:
+            while (cursor.position < m_sparseEntities.size()) {
+                const Entity entity = m_sparseEntities[cursor.position++];
+                if (m_query->contains(entity)) return entity;
+            }
+            return end;
+
+        case Strategy::Bitmap:
+            while (true) {
+                if (cursor.bits == 0) {
+                    if (cursor.position * EntityBitmap::wordBits > maxEntity) return end;
+                    EntityBitmap::Word word = ~EntityBitmap::Word(0);
+                    auto intersect = [&](const EntityBitmap &bitmap) {
+                        auto words = bitmap.words();
+                        word &= cursor.position < words.size() ? words[cursor.position] : 0;
+                    };
+                    for (auto *bitmap: m_bitmaps) intersect(*bitmap);
+                    for (auto &snapshot: m_snapshots) intersect(snapshot);
+                    cursor.position++;
+                    cursor.bits = word;
+                    continue;
+                }
+                const Entity entity =
+                    (cursor.position - 1) * EntityBitmap::wordBits + std::countr_zero(cursor.bits);
+                cursor.bits &= cursor.bits - 1;
+                if (entity > maxEntity) return end;
+                // The word was read before the previous entities were visited, which may have modified the arrays. The
+                // snapshots of the sparse arrays are checked by probing them.
+                auto inBitmap = [=](auto *bitmap) { return entity < bitmap->size() && (*bitmap)[entity]; };
+                if (!std::ranges::all_of(m_bitmaps, inBitmap)) continue;
+                if (std::ranges::all_of(m_probed, [=](auto *array) { return array->entityHasValue(entity); }))
+                    return entity;
+            }
+    }
+    return end;
+}
 }    // namespace pivot::ecs::component
@@ -1,4 +1,5 @@
 #include "pivot/ecs/Core/Component/manager.hxx"
+#include "pivot/ecs/Core/Component/ArchetypeComponentArray.hxx"
 
 namespace pivot::ecs::component
 {
@@ -7,8 +8,12 @@ Manager::ComponentId Manager::RegisterComponent(const Description &componentDesc
     if (m_componentNameToIndex.contains(componentDescription.name))
         throw EcsException("Registering component type more than once.");
 
+    if (m_componentArrays.size() >= MAX_COMPONENTS) throw EcsException("Too many components registered.");
+
     ComponentId index = m_componentArrays.size();
     m_componentArrays.push_back(componentDescription.createContainer(componentDescription));
+    if (auto *archetypeArray = dynamic_cast<IArchetypeComponentArray *>(m_componentArrays.back().get()))
+        archetypeArray->attach(*m_archetypes, index);
     m_componentNameToIndex.insert({componentDescription.name, index});
     return index;
 }
@@ -26,11 +31,13 @@ std::optional<Manager::ComponentId> Manager::GetComponentId(std::string_view nam
 void Manager::AddComponent(Entity entity, data::Value component, Manager::ComponentId index)
 {
     m_componentArrays.at(index)->setValueForEntity(entity, component);
+    setSignature(entity, GetSignature(entity).set(index));
 }
 
 void Manager::RemoveComponent(Entity entity, Manager::ComponentId index)
 {
     m_componentArrays.at(index)->setValueForEntity(entity, std::nullopt);
+    setSignature(entity, GetSignature(entity).reset(index));
 }
 
 /// Get the value of a component associated to an entity
@@ -42,9 +49,44 @@ const std::optional<data::Value> Manager::GetComponent(Entity entity, Manager::C
 /// Removes the component for every entity.
 void Manager::EntityDestroyed(Entity entity)
 {
+    // Remove the archetype components at once, instead of moving the entity through every smaller archetype
+    m_archetypes->removeEntity(entity);
     for (auto &componentArray: m_componentArrays) { componentArray->setValueForEntity(entity, std::nullopt); }
+    setSignature(entity, Signature());
 }
 
 IComponentArray &Manager::GetComponentArray(ComponentId index) { return *m_componentArrays.at(index); }
 
+Signature Manager::GetSignature(Entity entity) const
+{
+    if (entity >= m_signatures.size()) return {};
+    return m_signatures[entity];
+}
+
+const Query &Manager::GetQuery(const Signature &signature)
+{
+    for (const auto &query: m_queries) {
+        if (query->signature() == signature) return *query;
+    }
+
+    auto &query = *m_queries.emplace_back(std::make_unique<Query>(signature));
+    for (Entity entity = 0; entity < m_signatures.size(); entity++) {
+        if (m_signatures[entity].any() && query.matches(m_signatures[entity])) query.m_entities.insert(entity);
+    }
+    return query;
+}
+
+void Manager::setSignature(Entity entity, const Signature &signature)
+{
+    if (entity >= m_signatures.size()) {
+        if (signature.none()) return;
+        m_signatures.resize(entity + 1);
+    }
+    const Signature oldSignature = m_signatures[entity];
+    if (oldSignature == signature) return;
+    m_signatures[entity] = signature;
+    for (auto &query: m_queries) query->update(entity, oldSignature, signature);
+    if (m_entityManager) m_entityManager->SetSignature(entity, signature);
+}
+
 }    // namespace pivot::ecs::component
@@ -2,9 +2,57 @@
 
 #include "pivot/pivot.hxx"
 
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace pivot::ecs::data
 {
 
+namespace
+{
+    /// Every field name interned
+    struct FieldTable {
+        std::shared_mutex mutex;
+        /// Never reallocated, so that the FieldName can point to the names
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, FieldId> ids;
+    };
+
+    FieldTable &fieldTable()
+    {
+        static FieldTable table;
+        return table;
+    }
+}    // namespace
+
+FieldName::FieldName(std::string_view name)
+{
+    auto &table = fieldTable();
+    {
+        std::shared_lock lock(table.mutex);
+        if (auto id = table.ids.find(name); id != table.ids.end()) {
+            m_id = id->second;
+            m_name = &table.names[m_id];
+            return;
+        }
+    }
+    std::unique_lock lock(table.mutex);
+    // Another thread may have interned the name in the meantime
+    auto [id, inserted] = table.ids.try_emplace(name, table.names.size());
+    if (inserted) {
+        const auto &interned = table.names.emplace_back(name);
+        // The key must point to the interned copy, not to the name being looked up
+        table.ids.erase(id);
+        id = table.ids.emplace(interned, table.names.size() - 1).first;
+    }
+    m_id = id->second;
+    m_name = &table.names[m_id];
+}
+
+std::ostream &operator<<(std::ostream &stream, const FieldName &name) { return stream << name.str(); }
+
 RecordType Record::type() const
 {
     PROFILE_FUNCTION();
@@ -46,6 +46,20 @@ void from_json(const nlohmann::json &json, Value &value)
     }
 }
 
+void to_json(nlohmann::json &json, const Record &value)
+{
+    json = nlohmann::json::object();
+    for (const auto &[name, field]: value) json[name.str()] = field;
+}
+
+void from_json(const nlohmann::json &json, Record &value)
+{
+    std::vector<Record::value_type> fields;
+    fields.reserve(json.size());
+    for (const auto &[name, field]: json.items()) fields.emplace_back(name, field.get<Value>());
+    value = Record(std::move(fields));
+}
+
 std::ostream &operator<<(std::ostream &stream, const Record &type) { return stream << nlohmann::json(type).dump(); }
 std::ostream &operator<<(std::ostream &stream, const Value &type) { return stream << nlohmann::json(type).dump(); }
 
@@ -2,48 +2,59 @@
 
 #include "pivot/pivot.hxx"
 
-EntityManager::EntityManager()
-{
-    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) mAvailableEntities.push(entity);
-}
-
 Entity EntityManager::CreateEntity()
 {
     PROFILE_FUNCTION();
-    if (mLivingEntityCount >= MAX_ENTITIES) throw EcsException("Too many entities in existence.");
-
-    Entity id = mAvailableEntities.front();
-    mEntities.insert({id, Signature()});
-    mAvailableEntities.pop();
-    ++mLivingEntityCount;
-
+    Entity id;
+    // The null entity can never be allocated
+    const bool full = mSlots.size() >= pivot::NULL_ENTITY;
+    if (mFreeEntities.size() >= minimumFreeEntities || (full && !mFreeEntities.empty())) {
+        id = mFreeEntities.front();
+        mFreeEntities.pop_front();
+    } else {
+        if (full) throw EcsException("Too many entities in existence.");
+        id = mSlots.size();
+        mSlots.emplace_back();
+    }
+
+    mSlots[id].livingIndex = mLivingEntities.size();
+    mLivingEntities.push_back(id);
     return id;
 }
 
 void EntityManager::DestroyEntity(Entity entity)
 {
     PROFILE_FUNCTION();
-    if (entity >= MAX_ENTITIES) throw EcsException("Entity out of range.");
-
-    mAvailableEntities.push(entity);
-    mEntities.erase(entity);
-    --mLivingEntityCount;
+    if (!isAlive(entity)) throw EcsException("Entity does not exist.");
+
+    auto &slot = mSlots[entity];
+    const Entity last = mLivingEntities.back();
+    mLivingEntities[slot.livingIndex] = last;
+    mSlots[last].livingIndex = slot.livingIndex;
+    mLivingEntities.pop_back();
+
+    slot.signature.reset();
+    slot.livingIndex = noIndex;
+    slot.generation++;
+    mFreeEntities.push_back(entity);
 }
 
 void EntityManager::SetSignature(Entity entity, Signature signature)
 {
     PROFILE_FUNCTION();
-    if (entity >= MAX_ENTITIES) throw EcsException("Entity out of range.");
-    mEntities[entity] = signature;
+    // The component manager may update the signature of an entity which was already destroyed
+    if (isAlive(entity)) mSlots[entity].signature = signature;
 }
 
-Signature EntityManager::GetSignature(Entity entity)
+Signature EntityManager::GetSignature(Entity entity) const
 {
     PROFILE_FUNCTION();
-    if (entity >= MAX_ENTITIES) throw EcsException("Entity out of range.");
-    return mEntities[entity];
+    if (!isAlive(entity)) return {};
+    return mSlots[entity].signature;
 }
 
-std::unordered_map<Entity, Signature> EntityManager::getEntities() const { return mEntities; }
-
-uint32_t EntityManager::getLivingEntityCount() { return mLivingEntityCount; }
+EntityManager::Handle EntityManager::getHandle(Entity entity) const
+{
+    if (!isAlive(entity)) throw EcsException("Entity does not exist.");
+    return {entity, mSlots[entity].generation};
+}
@@ -8,12 +8,86 @@ namespace pivot::ecs::event
 Manager::Manager(systems::Manager &systemManager): m_systemManager(systemManager) {}
 
 void Manager::sendEvent(const Event &event)
+{
+    PROFILE_FUNCTION();
+    queueEvent(event);
+    dispatchEvents();
+}
+
+void Manager::queueEvent(Event event)
 {
     PROFILE_FUNCTION();
     if (event.payload.type() != event.description.payload)
         throw std::runtime_error("This event expect " + event.description.payload.toString() + ", got " +
                                  event.payload.type().toString());
-    for (const auto &childEvent: m_systemManager.execute(event)) this->sendEvent(childEvent);
+
+    const auto eventId = m_systemManager.getEventId(event.description.name);
+    if (!eventId) return;
+    if (eventId.value() >= m_batchIndex.size()) m_batchIndex.resize(eventId.value() + 1, noBatch);
+    auto &batchIndex = m_batchIndex[eventId.value()];
+    if (batchIndex == noBatch) {
+        const auto coalescing = m_coalescing.find(event.description.name);
+        batchIndex = m_queue.size();
+        m_queue.push_back({
+            .eventId = eventId.value(),
+            .coalescing = coalescing == m_coalescing.end() ? Coalescing::None : coalescing->second,
+        });
+    }
+    auto &batch = m_queue[batchIndex];
+
+    switch (batch.coalescing) {
+        case Coalescing::None: batch.events.push_back(std::move(event)); break;
+        case Coalescing::Latest:
+            if (batch.events.empty())
+                batch.events.push_back(std::move(event));
+            else
+                batch.events.front() = std::move(event);
+            break;
+        case Coalescing::LatestPerEntities: {
+            auto [entityIndex, newEntities] = batch.entityIndex.try_emplace(event.entities, batch.events.size());
+            if (newEntities)
+                batch.events.push_back(std::move(event));
+            else
+                batch.events[entityIndex->second] = std::move(event);
+        } break;
+    }
+}
+
+void Manager::dispatchEvents()
+{
+    PROFILE_FUNCTION();
+    // Events queued by a system are dispatched by the loop already running
+    if (m_dispatching) return;
+    m_dispatching = true;
+    try {
+        for (std::size_t depth = 0; depth < m_maxDepth && !m_queue.empty(); depth++) {
+            auto generation = std::exchange(m_queue, {});
+            for (const auto &batch: generation) m_batchIndex[batch.eventId] = noBatch;
+            for (const auto &batch: generation) {
+                for (auto &childEvent: m_systemManager.execute(batch.eventId, batch.events))
+                    queueEvent(std::move(childEvent));
+            }
+        }
+    } catch (...) {
+        m_dispatching = false;
+        throw;
+    }
+    m_dispatching = false;
+    if (!m_queue.empty())
+        logger.warn("Event Manager") << "Child events nested deeper than " << m_maxDepth << " generations, "
+                                     << getQueuedEventCount() << " events are left for the next dispatch";
+}
+
+std::size_t Manager::getQueuedEventCount() const noexcept
+{
+    std::size_t count = 0;
+    for (const auto &batch: m_queue) count += batch.events.size();
+    return count;
+}
+
+void Manager::setCoalescing(const std::string &eventName, Coalescing coalescing)
+{
+    m_coalescing[eventName] = coalescing;
 }
 
 }    // namespace pivot::ecs::event
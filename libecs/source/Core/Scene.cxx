@@ -1,6 +1,7 @@
 #include <set>
 
 #include "pivot/ecs/Core/Scene.hxx"
+#include <pivot/ecs/Core/BinaryScene.hxx>
 #include <pivot/ecs/Components/Tag.hxx>
 #include <pivot/ecs/Components/TagArray.hxx>
 #include <pivot/ecs/Core/Component/index.hxx>
@@ -8,7 +9,10 @@
 using namespace pivot::ecs;
 
 Scene::Scene(std::string sceneName)
-    : name(sceneName), mSystemManager(mComponentManager, mEntityManager), mEventManager(mSystemManager)
+    : name(sceneName),
+      mComponentManager(mEntityManager),
+      mSystemManager(mComponentManager, mEntityManager),
+      mEventManager(mSystemManager)
 {
     mTagId = mComponentManager.RegisterComponent(Tag::description);
 }
@@ -32,7 +36,7 @@ Entity Scene::CreateEntity(std::string newName)
     return newEntity;
 }
 
-std::unordered_map<Entity, Signature> Scene::getEntities() const { return mEntityManager.getEntities(); }
+EntityManager::EntityView Scene::getEntities() const { return mEntityManager.getEntities(); }
 
 void Scene::DestroyEntity(Entity entity)
 {
@@ -117,11 +121,10 @@ void extract_assets(const data::Value &value, std::set<std::string> &assets,
 }
 }    // namespace
 
-nlohmann::json Scene::getJson(std::optional<AssetTranslator> assetTranslator,
-                              std::optional<ScriptTranslator> scriptTranslator) const
+nlohmann::json Scene::getResources(std::optional<AssetTranslator> assetTranslator,
+                                   std::optional<ScriptTranslator> scriptTranslator) const
 {
     PROFILE_FUNCTION();
-    // serialize scene
     nlohmann::json output;
     std::set<std::string> scriptUsed;
     std::set<std::string> assets;
@@ -135,12 +138,10 @@ nlohmann::json Scene::getJson(std::optional<AssetTranslator> assetTranslator,
         }
     };
 
-    output["name"] = name;
-    for (auto &[entity, _]: mEntityManager.getEntities()) {
+    for (auto [entity, _]: mEntityManager.getEntities()) {
         for (pivot::ecs::component::ComponentRef ref: mComponentManager.GetAllComponents(entity)) {
             auto &provenance = ref.description().provenance;
             if (provenance.isExternalRessource()) addScript(provenance.getExternalRessource());
-            output["components"][entity][ref.description().name] = nlohmann::json(ref.get());
             extract_assets(ref.get(), assets, assetTranslator);
         }
     }
@@ -156,6 +157,21 @@ nlohmann::json Scene::getJson(std::optional<AssetTranslator> assetTranslator,
     return output;
 }
 
+nlohmann::json Scene::getJson(std::optional<AssetTranslator> assetTranslator,
+                              std::optional<ScriptTranslator> scriptTranslator) const
+{
+    PROFILE_FUNCTION();
+    // serialize scene
+    nlohmann::json output = getResources(assetTranslator, scriptTranslator);
+    output["name"] = name;
+    for (auto [entity, _]: mEntityManager.getEntities()) {
+        for (pivot::ecs::component::ComponentRef ref: mComponentManager.GetAllComponents(entity)) {
+            output["components"][entity][ref.description().name] = nlohmann::json(ref.get());
+        }
+    }
+    return output;
+}
+
 void Scene::save(const std::filesystem::path &path, std::optional<AssetTranslator> assetTranslator,
                  std::optional<ScriptTranslator> scriptTranslator) const
 {
@@ -166,6 +182,13 @@ void Scene::save(const std::filesystem::path &path, std::optional<AssetTranslato
     out.close();
 }
 
+void Scene::saveBinary(const std::filesystem::path &path, std::optional<AssetTranslator> assetTranslator,
+                       std::optional<ScriptTranslator> scriptTranslator) const
+{
+    PROFILE_FUNCTION();
+    BinaryScene::write(path, BinaryScene::fromScene(*this, assetTranslator, scriptTranslator));
+}
+
 void Scene::registerSystem(const systems::Description &description, pivot::OptionalRef<const component::Index> cIndex)
 {
     PROFILE_FUNCTION();
@@ -182,6 +205,6 @@ void Scene::registerSystem(const systems::Description &description, pivot::Optio
 
 std::optional<Entity> Scene::getEntityID(const std::string &name)
 {
-    auto array = dynamic_cast<const component::TagArray &>(mComponentManager.GetComponentArray(mTagId));
+    auto &array = dynamic_cast<const component::TagArray &>(mComponentManager.GetComponentArray(mTagId));
     return array.getEntityID(name);
 }
@@ -0,0 +1,291 @@
+#include "pivot/ecs/Core/Scene.hxx"
+
+#include <unordered_map>
+
+using namespace pivot::ecs;
+
+namespace
+{
+    /// Top-level keys of a JSON scene
+    enum class Section {
+        Ignored,
+        Name,
+        Components,
+        Systems,
+        Scripts,
+        Assets,
+    };
+
+    /// Builds a scene from the SAX events of its JSON
+    ///
+    /// The entities and components are added to the scene as soon as they are read, and the values of the components
+    /// are built directly, following the same rules as data::from_json. The systems are registered once the whole
+    /// scene is read, as they need their components to be registered. Without a scene, only the scripts and assets are
+    /// read.
+    class SceneHandler : public nlohmann::json_sax<nlohmann::json>
+    {
+    public:
+        SceneHandler() = default;
+        SceneHandler(Scene &scene, const component::Index &cIndex, const systems::Index &sIndex)
+            : m_scene(&scene), m_cIndex(&cIndex), m_sIndex(&sIndex)
+        {
+        }
+
+        bool null() override { return scalar(data::Void{}); }
+        bool boolean(bool value) override { return scalar(value); }
+        bool number_integer(number_integer_t value) override { return scalar(static_cast<int>(value)); }
+        bool number_unsigned(number_unsigned_t value) override { return scalar(static_cast<int>(value)); }
+        bool number_float(number_float_t value, const string_t &) override { return scalar(value); }
+        bool string(string_t &value) override { return scalar(std::move(value)); }
+        bool binary(binary_t &) override { throw std::runtime_error("Binary values can't be part of a scene"); }
+
+        bool start_object(std::size_t) override { return open(true); }
+        bool start_array(std::size_t) override { return open(false); }
+        bool end_object() override { return close(); }
+        bool end_array() override { return close(); }
+
+        bool key(string_t &key) override
+        {
+            if (m_component) {
+                m_field = std::move(key);
+            } else if (m_depth == 1) {
+                m_section = section(key);
+            } else if (m_depth == 3 && m_section == Section::Components && m_scene) {
+                m_component = std::move(key);
+                m_pendingLists = 0;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string &, const nlohmann::json::exception &error) override
+        {
+            if (auto parseError = dynamic_cast<const nlohmann::json::parse_error *>(&error)) throw *parseError;
+            throw std::runtime_error(error.what());
+        }
+
+        /// Scripts and assets read so far
+        Scene::Resources resources;
+
+    private:
+        /// Container of the component being read which is not closed yet
+        struct Frame {
+            bool object;
+            /// Key of the container in its parent
+            std::string key;
+            /// Fields of an object, or items of an array without their key
+            std::vector<std::pair<std::string, data::Value>> children;
+        };
+
+        static Section section(const std::string &key)
+        {
+            if (key == "name") return Section::Name;
+            if (key == "components") return Section::Components;
+            if (key == "systems") return Section::Systems;
+            if (key == "scripts") return Section::Scripts;
+            if (key == "assets") return Section::Assets;
+            return Section::Ignored;
+        }
+
+        static const std::string &asString(const data::Value &value)
+        {
+            if (auto string = std::get_if<std::string>(&value)) return *string;
+            throw std::runtime_error("Expected a string in the scene, got " + value.type().toString());
+        }
+
+        bool scalar(data::Value value)
+        {
+            if (m_component) {
+                add(std::move(value));
+            } else if (m_depth == 1 && m_section == Section::Name && m_scene) {
+                m_scene->setName(asString(value));
+            } else if (m_depth == 2) {
+                element(std::move(value));
+            }
+            return true;
+        }
+
+        bool open(bool object)
+        {
+            if (m_component) {
+                if (m_open == m_frames.size()) m_frames.emplace_back();
+                auto &frame = m_frames[m_open++];
+                frame.object = object;
+                frame.key.swap(m_field);
+                frame.children.clear();
+                return true;
+            }
+            if (m_depth == 2 && m_section == Section::Components && m_scene) {
+                if (!object) throw std::runtime_error("The entities of a scene must be objects");
+                m_entity = m_scene->getEntityManager().CreateEntity();
+            }
+            m_depth++;
+            return true;
+        }
+
+        bool close()
+        {
+            if (m_component) {
+                auto &frame = m_frames[--m_open];
+                auto value = frame.object ? object(frame.children) : array(frame.children);
+                m_field.swap(frame.key);
+                add(std::move(value));
+            } else if (--m_depth == 0 && m_scene) {
+                registerSystems();
+            }
+            return true;
+        }
+
+        void registerSystems()
+        {
+            for (const auto &name: m_systems) {
+                auto description = m_sIndex->getDescription(name);
+                if (!description.has_value()) throw std::runtime_error("Unknown System " + name);
+                m_scene->registerSystem(description.value());
+            }
+        }
+
+        /// Element of the array of a section
+        void element(data::Value value)
+        {
+            switch (m_section) {
+                case Section::Components:
+                    if (!m_scene) break;
+                    // Entities without components are stored as null
+                    if (!std::holds_alternative<data::Void>(value))
+                        throw std::runtime_error("The entities of a scene must be objects");
+                    m_scene->getEntityManager().CreateEntity();
+                    break;
+                case Section::Systems:
+                    if (m_scene) m_systems.push_back(asString(value));
+                    break;
+                case Section::Scripts: resources.scripts.push_back(asString(value)); break;
+                case Section::Assets: resources.assets.push_back(asString(value)); break;
+                case Section::Name:
+                case Section::Ignored: break;
+            }
+        }
+
+        /// Adds a value to the innermost container of the component being read, or to the entity
+        void add(data::Value value)
+        {
+            if (m_open == 0) return addComponent(std::move(value));
+            m_frames[m_open - 1].children.emplace_back(std::move(m_field), std::move(value));
+        }
+
+        [[noreturn]] void invalid() const { throw std::runtime_error("Invalid value of component " + *m_component); }
+
+        float number(const data::Value &value) const
+        {
+            if (auto number = std::get_if<double>(&value)) return static_cast<float>(*number);
+            if (auto integer = std::get_if<int>(&value)) return static_cast<float>(*integer);
+            invalid();
+        }
+
+        const data::Value &field(const data::Value &value, std::string_view name) const
+        {
+            auto record = std::get_if<data::Record>(&value);
+            if (!record) invalid();
+            auto field = record->find(name);
+            if (field == record->end()) invalid();
+            return field->second;
+        }
+
+        data::Value array(std::vector<std::pair<std::string, data::Value>> &items)
+        {
+            switch (items.size()) {
+                case 2: return glm::vec2(number(items[0].second), number(items[1].second));
+                case 3: return glm::vec3(number(items[0].second), number(items[1].second), number(items[2].second));
+                case 4: {
+                    // Only valid as the channels of a color, which consumes it
+                    m_pendingLists++;
+                    std::vector<data::Value> channels;
+                    for (auto &[_, item]: items) channels.push_back(std::move(item));
+                    return data::List{std::move(channels)};
+                }
+                default: invalid();
+            }
+        }
+
+        data::Value object(std::vector<std::pair<std::string, data::Value>> &fields)
+        {
+            if (fields.size() == 1) {
+                const auto &[key, value] = fields.front();
+                if (key == "asset") return data::Asset{asString(field(value, "name"))};
+                if (key == "entity") {
+                    if (std::holds_alternative<data::Void>(value)) return pivot::EntityRef::empty();
+                    if (auto entity = std::get_if<int>(&value)) return pivot::EntityRef{static_cast<Entity>(*entity)};
+                    invalid();
+                }
+                if (key == "color") {
+                    auto rgba = std::get_if<data::List>(&field(value, "rgba"));
+                    if (!rgba) invalid();
+                    m_pendingLists--;
+                    return data::Color{{number(rgba->items[0]), number(rgba->items[1]), number(rgba->items[2]),
+                                        number(rgba->items[3])}};
+                }
+            }
+            std::vector<data::Record::value_type> record;
+            record.reserve(fields.size());
+            for (auto &[name, value]: fields) record.emplace_back(name, std::move(value));
+            return data::Record(std::move(record));
+        }
+
+        void addComponent(data::Value value)
+        {
+            if (m_pendingLists != 0) invalid();
+            auto componentId = m_componentIds.find(*m_component);
+            if (componentId == m_componentIds.end()) {
+                auto &componentManager = m_scene->getComponentManager();
+                auto id = componentManager.GetComponentId(*m_component);
+                if (!id) {
+                    auto description = m_cIndex->getDescription(*m_component);
+                    if (!description.has_value()) throw std::runtime_error("Unknown Component " + *m_component);
+                    id = componentManager.RegisterComponent(description.value());
+                }
+                componentId = m_componentIds.emplace(*m_component, id.value()).first;
+            }
+            m_scene->getComponentManager().AddComponent(m_entity, std::move(value), componentId->second);
+            m_component.reset();
+        }
+
+        Scene *m_scene = nullptr;
+        const component::Index *m_cIndex = nullptr;
+        const systems::Index *m_sIndex = nullptr;
+
+        /// Number of containers opened outside of the components
+        unsigned m_depth = 0;
+        Section m_section = Section::Ignored;
+        Entity m_entity = 0;
+        std::unordered_map<std::string, component::Manager::ComponentId> m_componentIds;
+        /// Systems of the scene, registered after its components
+        std::vector<std::string> m_systems;
+
+        /// Name of the component being read
+        std::optional<std::string> m_component;
+        /// Containers of the component being read, the first m_open ones are open and the others are kept for reuse
+        std::vector<Frame> m_frames;
+        std::size_t m_open = 0;
+        /// Key of the next field of the innermost container
+        std::string m_field;
+        /// Arrays of 4 numbers not yet used as the channels of a color
+        unsigned m_pendingLists = 0;
+    };
+}    // namespace
+
+std::unique_ptr<Scene> Scene::loadStream(std::istream &input, const pivot::ecs::component::Index &cIndex,
+                                         const pivot::ecs::systems::Index &sIndex)
+{
+    PROFILE_FUNCTION();
+    auto scene = std::make_unique<Scene>();
+    SceneHandler handler(*scene, cIndex, sIndex);
+    nlohmann::json::sax_parse(input, &handler);
+    return scene;
+}
+
+Scene::Resources Scene::readResources(std::istream &input)
+{
+    PROFILE_FUNCTION();
+    SceneHandler handler;
+    nlohmann::json::sax_parse(input, &handler);
+    return std::move(handler.resources);
+}
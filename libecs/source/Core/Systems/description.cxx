@@ -2,6 +2,7 @@
 #include <pivot/ecs/Core/Systems/description.hxx>
 
 #include <iostream>
+#include <set>
 #include <stdexcept>
 
 namespace pivot::ecs::systems
@@ -16,6 +17,25 @@ void Description::validate() const
     if (this->eventComponents.size() != this->eventListener.entities.size())
         throw ValidationError("Event require " + std::to_string(this->eventListener.entities.size()) +
                               " entities given " + std::to_string(this->eventComponents.size()));
+
+    if (!this->declaresAccess()) return;
+    std::set<std::string> used(this->systemComponents.begin(), this->systemComponents.end());
+    for (const auto &components: this->eventComponents) used.insert(components.begin(), components.end());
+    std::set<std::string> declared;
+    for (const auto *access: {&this->readComponents, &this->writeComponents}) {
+        for (const auto &component: *access) {
+            if (!used.contains(component))
+                throw ValidationError("Access declared to component " + component + " which is not used");
+            if (!declared.insert(component).second)
+                throw ValidationError("Access to component " + component + " declared more than once");
+        }
+    }
+    if (declared.size() != used.size()) {
+        for (const auto &component: used) {
+            if (!declared.contains(component))
+                throw ValidationError("Missing access declaration for component " + component);
+        }
+    }
 }
 
 }    // namespace pivot::ecs::systems
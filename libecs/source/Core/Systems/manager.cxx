@@ -1,4 +1,5 @@
 #include "pivot/ecs/Core/Systems/manager.hxx"
+#include "pivot/memory/FrameArena.hxx"
 #include "pivot/pivot.hxx"
 
 namespace pivot::ecs::systems
@@ -17,28 +18,125 @@ void Manager::useSystem(const Description &description)
 {
     PROFILE_FUNCTION();
     if (m_systems.contains(description.name)) throw EcsException("System already use.");
-    m_systems.insert({description.name, description});
 
     std::vector<std::reference_wrapper<component::IComponentArray>> componentArrays;
-    for (const auto index: getComponentsId(description.systemComponents))
+    Signature signature;
+    for (const auto index: getComponentsId(description.systemComponents)) {
         componentArrays.push_back(m_componentManager.GetComponentArray(index));
-    m_combinations.insert({description.name, {componentArrays}});
+        signature.set(index);
+    }
+    std::vector<std::vector<component::Manager::ComponentId>> eventComponents;
+    std::vector<Signature> eventSignatures;
+    for (const auto &components: description.eventComponents) {
+        auto &required = eventSignatures.emplace_back();
+        for (const auto index: eventComponents.emplace_back(getComponentsId(components))) required.set(index);
+    }
+    const Signature read = getSignature(description.readComponents);
+    const Signature write = getSignature(description.writeComponents);
+
+    const auto &used = m_systems.insert({description.name, description}).first->second;
+    // The query is kept up to date by the component manager, the system only visits the matching entities
+    auto combination = signature.none()
+                           ? component::ArrayCombination(componentArrays)
+                           : component::ArrayCombination(componentArrays, m_componentManager.GetQuery(signature));
+    m_resolvedSystems.insert({description.name,
+                              System{
+                                  .description = &used,
+                                  .combination = std::move(combination),
+                                  .eventComponents = std::move(eventComponents),
+                                  .eventSignatures = std::move(eventSignatures),
+                                  .read = read,
+                                  .write = write,
+                              }});
+
+    const auto &eventName = description.eventListener.name;
+    auto [eventId, inserted] = m_eventIds.try_emplace(eventName, m_schedules.size());
+    if (inserted) m_schedules.emplace_back();
+    buildSchedule(eventId->second, eventName);
+}
+
+std::optional<Manager::EventId> Manager::getEventId(const std::string &eventName) const
+{
+    const auto eventId = m_eventIds.find(eventName);
+    if (eventId == m_eventIds.end()) return std::nullopt;
+    return eventId->second;
+}
+
+std::pmr::vector<event::Event> Manager::execute(const event::Event &event) { return execute({&event, 1}); }
+
+std::pmr::vector<event::Event> Manager::execute(std::span<const event::Event> events)
+{
+    if (events.empty()) return std::pmr::vector<event::Event>(memory::FrameArena::get());
+    const auto eventId = getEventId(events.front().description.name);
+    // Nobody listens to this event
+    if (!eventId) return std::pmr::vector<event::Event>(memory::FrameArena::get());
+    return execute(eventId.value(), events);
 }
 
-std::vector<event::Event> Manager::execute(const event::Event &event)
+std::pmr::vector<event::Event> Manager::execute(EventId eventId, std::span<const event::Event> events)
 {
     PROFILE_FUNCTION();
-    std::vector<event::Event> childEvent;
+    std::pmr::vector<event::Event> childEvent(memory::FrameArena::get());
+    auto &schedule = *m_schedules.at(eventId);
 
-    for (const auto &[name, description]: m_systems) {
-        if (event.description.name == description.eventListener.name) {
-            auto events = executeOne(description, event);
-            childEvent.insert(childEvent.end(), events.begin(), events.end());
+    // A system sending an event listened by itself runs the schedule again before it finished, so it runs serially
+    if (!m_threadPool || schedule.systems.size() < 2 || schedule.running) {
+        for (auto *system: schedule.systems) {
+            auto children = executeBatch(*system, events);
+            childEvent.insert(childEvent.end(), std::make_move_iterator(children.begin()),
+                              std::make_move_iterator(children.end()));
         }
+        return childEvent;
+    }
+
+    schedule.running = true;
+    schedule.events = events;
+    try {
+        schedule.graph.run(*m_threadPool);
+    } catch (...) {
+        schedule.running = false;
+        throw;
+    }
+    schedule.running = false;
+    for (auto &children: schedule.childEvents) {
+        childEvent.insert(childEvent.end(), std::make_move_iterator(children.begin()),
+                          std::make_move_iterator(children.end()));
+        children.clear();
     }
     return childEvent;
 }
 
+void Manager::buildSchedule(EventId eventId, const std::string &eventName)
+{
+    PROFILE_FUNCTION();
+    auto &schedule = m_schedules[eventId];
+    if (schedule && schedule->running) throw EcsException("Cannot use a system while its event is executed.");
+    schedule = std::make_unique<Schedule>();
+    for (const auto &[name, description]: m_systems) {
+        if (description.eventListener.name == eventName) schedule->systems.push_back(&m_resolvedSystems.at(name));
+    }
+    schedule->childEvents.resize(schedule->systems.size());
+    for (std::size_t i = 0; i < schedule->systems.size(); i++) {
+        auto &current = *schedule;
+        const auto task = current.graph.add(current.systems[i]->description->name, [this, &current, i] {
+            current.childEvents[i] = executeBatch(*current.systems[i], current.events);
+        });
+        // Conflicting systems keep the order of a serial execution
+        for (std::size_t previous = 0; previous < i; previous++) {
+            if (conflicts(*current.systems[previous], *current.systems[i])) current.graph.depend(task, previous);
+        }
+    }
+}
+
+bool Manager::conflicts(const System &first, const System &second)
+{
+    if (!first.description->declaresAccess() || !second.description->declaresAccess()) return true;
+
+    const Signature firstUsed = first.write | first.read;
+    const Signature secondUsed = second.write | second.read;
+    return (first.write & secondUsed).any() || (second.write & firstUsed).any();
+}
+
 Manager::const_iterator Manager::begin() const { return m_systems.begin(); }
 
 Manager::const_iterator Manager::end() const { return m_systems.end(); }
@@ -56,24 +154,45 @@ std::vector<component::Manager::ComponentId> Manager::getComponentsId(const std:
     return componentsId;
 }
 
-std::vector<event::Event> Manager::executeOne(const Description &description, const event::Event &event)
+Signature Manager::getSignature(const std::vector<std::string> &components)
+{
+    Signature signature;
+    for (const auto index: getComponentsId(components)) signature.set(index);
+    return signature;
+}
+
+std::vector<event::Event> Manager::executeBatch(System &system, std::span<const event::Event> events)
 {
     PROFILE_FUNCTION();
-    if (event.entities.size() != description.eventComponents.size())
-        throw std::logic_error("This system expect " + std::to_string(description.eventComponents.size()) + " entity.");
-
-    event::EntityComponents entitiesComponents;
-    for (std::size_t i = 0; i < event.entities.size(); i++) {
-        std::vector<component::ComponentRef> entityComponents;
-        for (const auto index: getComponentsId(description.eventComponents[i])) {
-            if (!m_componentManager.GetComponent(event.entities[i], index).has_value()) return {};
-            entityComponents.emplace_back(m_componentManager.GetComponentArray(index), event.entities[i]);
+    const auto &description = *system.description;
+    std::vector<event::Event> childEvents;
+    for (const auto &event: events) {
+        if (event.entities.size() != system.eventComponents.size())
+            throw std::logic_error("This system expect " + std::to_string(system.eventComponents.size()) +
+                                   " entity.");
+
+        // The event is ignored when one of its entities lacks a component
+        bool hasComponents = true;
+        for (std::size_t i = 0; i < event.entities.size(); i++) {
+            const auto &required = system.eventSignatures[i];
+            hasComponents &= (m_componentManager.GetSignature(event.entities[i]) & required) == required;
+        }
+        if (!hasComponents) continue;
+
+        event::EntityComponents entitiesComponents;
+        for (std::size_t i = 0; i < event.entities.size(); i++) {
+            std::vector<component::ComponentRef> entityComponents;
+            for (const auto index: system.eventComponents[i])
+                entityComponents.emplace_back(m_componentManager.GetComponentArray(index), event.entities[i]);
+            entitiesComponents.push_back(std::move(entityComponents));
         }
-        entitiesComponents.push_back(entityComponents);
-    }
 
-    event::EventWithComponent entityComponents{.event = event, .components = entitiesComponents};
-    return description.system(description, m_combinations.at(description.name), entityComponents);
+        event::EventWithComponent entityComponents{.event = event, .components = entitiesComponents};
+        auto children = description.system(description, system.combination, entityComponents);
+        childEvents.insert(childEvents.end(), std::make_move_iterator(children.begin()),
+                           std::make_move_iterator(children.end()));
+    }
+    return childEvents;
 }
 
 }    // namespace pivot::ecs::systems
@@ -0,0 +1,249 @@
+#include <boost/fusion/include/adapt_struct.hpp>
+#include <pivot/ecs/Core/Component/ArchetypeComponentArray.hxx>
+#include <pivot/ecs/Core/Component/ArchetypeStorage.hxx>
+#include <pivot/ecs/Core/Component/DenseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/description_helpers_impl.hxx>
+#include <pivot/ecs/Core/Component/manager.hxx>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace pivot::ecs;
+using namespace pivot::ecs::component;
+using namespace pivot::ecs::data;
+
+struct ArchetypeTransform {
+    glm::vec3 position;
+    glm::vec3 rotation;
+    glm::vec3 scale;
+};
+struct ArchetypeRigidBody {
+    glm::vec3 velocity;
+    glm::vec3 acceleration;
+};
+struct ArchetypeGravity {
+    glm::vec3 force;
+};
+
+BOOST_FUSION_ADAPT_STRUCT(ArchetypeTransform, position, rotation, scale);
+BOOST_FUSION_ADAPT_STRUCT(ArchetypeRigidBody, velocity, acceleration);
+BOOST_FUSION_ADAPT_STRUCT(ArchetypeGravity, force);
+
+namespace pivot::ecs::component::helpers
+{
+template <>
+constexpr const char *component_name<ArchetypeTransform> = "ArchetypeTransform";
+template <>
+constexpr const char *component_name<ArchetypeRigidBody> = "ArchetypeRigidBody";
+template <>
+constexpr const char *component_name<ArchetypeGravity> = "ArchetypeGravity";
+}    // namespace pivot::ecs::component::helpers
+
+namespace
+{
+/// Counts its live instances, to check that the storage destroys every value it relocates
+struct Counted {
+    static inline int alive = 0;
+
+    std::string name;
+
+    Counted(std::string name = ""): name(std::move(name)) { alive++; }
+    Counted(const Counted &other): name(other.name) { alive++; }
+    Counted(Counted &&other) noexcept: name(std::move(other.name)) { alive++; }
+    Counted &operator=(const Counted &) = default;
+    Counted &operator=(Counted &&) noexcept = default;
+    ~Counted() { alive--; }
+};
+
+constexpr ComponentType transformId = 0;
+constexpr ComponentType rigidBodyId = 1;
+constexpr ComponentType countedId = 2;
+
+template <typename T>
+Description denseDescription(const char *name)
+{
+    return helpers::build_component_description<T, DenseTypedComponentArray<T>>(name);
+}
+}    // namespace
+
+TEST_CASE("Archetype storage moves entities between archetypes", "[component][archetype]")
+{
+    ArchetypeStorage storage;
+    storage.registerComponent(transformId, ArchetypeColumnType::of<ArchetypeTransform>());
+    storage.registerComponent(rigidBodyId, ArchetypeColumnType::of<ArchetypeRigidBody>());
+    REQUIRE(storage.isRegistered(rigidBodyId));
+    REQUIRE(!storage.isRegistered(countedId));
+
+    storage.insert(0, transformId, ArchetypeTransform{.position = glm::vec3(1)});
+    storage.insert(1, transformId, ArchetypeTransform{.position = glm::vec3(2)});
+    storage.insert(1, rigidBodyId, ArchetypeRigidBody{.velocity = glm::vec3(3)});
+    REQUIRE(storage.archetypes().size() == 2);
+    REQUIRE(storage.getSignature(1) == Signature().set(transformId).set(rigidBodyId));
+    REQUIRE(storage.get<ArchetypeTransform>(1, transformId)->position == glm::vec3(2));
+    REQUIRE(storage.get<ArchetypeRigidBody>(1, rigidBodyId)->velocity == glm::vec3(3));
+    REQUIRE(storage.get<ArchetypeRigidBody>(0, rigidBodyId) == nullptr);
+
+    // Replacing a value keeps the entity in its archetype
+    storage.insert(1, rigidBodyId, ArchetypeRigidBody{.velocity = glm::vec3(4)});
+    REQUIRE(storage.archetypes()[1]->size() == 1);
+    REQUIRE(storage.get<ArchetypeRigidBody>(1, rigidBodyId)->velocity == glm::vec3(4));
+
+    storage.remove(1, rigidBodyId);
+    REQUIRE(!storage.contains(1, rigidBodyId));
+    REQUIRE(storage.get<ArchetypeTransform>(1, transformId)->position == glm::vec3(2));
+    REQUIRE(storage.archetypes()[0]->size() == 2);
+    REQUIRE(storage.archetypes()[1]->size() == 0);
+
+    storage.removeEntity(0);
+    REQUIRE(storage.getSignature(0).none());
+    REQUIRE(storage.get<ArchetypeTransform>(1, transformId)->position == glm::vec3(2));
+}
+
+TEST_CASE("Archetype storage keeps its chunks packed", "[component][archetype]")
+{
+    ArchetypeStorage storage;
+    storage.registerComponent(transformId, ArchetypeColumnType::of<ArchetypeTransform>());
+    storage.registerComponent(rigidBodyId, ArchetypeColumnType::of<ArchetypeRigidBody>());
+
+    constexpr Entity count = 2000;
+    for (Entity entity = 0; entity < count; entity++) {
+        storage.insert(entity, transformId, ArchetypeTransform{.position = glm::vec3(entity)});
+        storage.insert(entity, rigidBodyId, ArchetypeRigidBody{.velocity = glm::vec3(entity)});
+    }
+    const auto &archetype = *storage.archetypes()[1];
+    REQUIRE(archetype.chunks().size() > 1);
+
+    for (Entity entity = 0; entity < count; entity += 2) storage.remove(entity, rigidBodyId);
+    REQUIRE(archetype.size() == count / 2);
+
+    std::size_t seen = 0;
+    storage.forEachChunk(archetype.signature(),
+                         [&](const ArchetypeStorage::Archetype &, ArchetypeStorage::Chunk &chunk) {
+                             REQUIRE(chunk.size() > 0);
+                             seen += chunk.size();
+                         });
+    REQUIRE(seen == count / 2);
+
+    storage.each<ArchetypeTransform, ArchetypeRigidBody>(
+        {transformId, rigidBodyId}, [](Entity entity, ArchetypeTransform &transform, ArchetypeRigidBody &rigidBody) {
+            REQUIRE(entity % 2 == 1);
+            REQUIRE(transform.position == glm::vec3(entity));
+            REQUIRE(rigidBody.velocity == glm::vec3(entity));
+        });
+    for (Entity entity = 0; entity < count; entity++)
+        REQUIRE(storage.get<ArchetypeTransform>(entity, transformId)->position == glm::vec3(entity));
+}
+
+TEST_CASE("Archetype storage destroys its values", "[component][archetype]")
+{
+    {
+        ArchetypeStorage storage;
+        storage.registerComponent(transformId, ArchetypeColumnType::of<ArchetypeTransform>());
+        storage.registerComponent(countedId, ArchetypeColumnType::of<Counted>());
+
+        for (Entity entity = 0; entity < 100; entity++) {
+            storage.insert(entity, countedId, Counted(std::to_string(entity)));
+            storage.insert(entity, transformId, ArchetypeTransform{});
+        }
+        REQUIRE(Counted::alive == 100);
+        storage.insert(5, countedId, Counted("replaced"));
+        storage.remove(10, countedId);
+        storage.removeEntity(20);
+        REQUIRE(Counted::alive == 98);
+        REQUIRE(storage.get<Counted>(5, countedId)->name == "replaced");
+        REQUIRE(storage.get<Counted>(99, countedId)->name == "99");
+    }
+    REQUIRE(Counted::alive == 0);
+}
+
+TEST_CASE("Archetype component arrays are stored by the component manager", "[component][archetype]")
+{
+    const auto transformDescription =
+        helpers::build_component_description<ArchetypeTransform, ArchetypeComponentArray<ArchetypeTransform>>(
+            "ArchetypeTransform");
+    const auto rigidBodyDescription = denseDescription<ArchetypeRigidBody>("ArchetypeRigidBody");
+
+    Manager manager;
+    const auto transform = manager.RegisterComponent(transformDescription);
+    const auto rigidBody = manager.RegisterComponent(rigidBodyDescription);
+    REQUIRE(manager.GetArchetypeStorage().isRegistered(transform));
+    REQUIRE(!manager.GetArchetypeStorage().isRegistered(rigidBody));
+
+    const Value value = Record{{"position", glm::vec3(1)}, {"rotation", glm::vec3(2)}, {"scale", glm::vec3(3)}};
+    manager.AddComponent(7, value, transform);
+    manager.AddComponent(7, Record{{"velocity", glm::vec3(1)}, {"acceleration", glm::vec3(0)}}, rigidBody);
+    REQUIRE(manager.GetComponent(7, transform) == value);
+    REQUIRE(manager.GetArchetypeStorage().get<ArchetypeTransform>(7, transform)->scale == glm::vec3(3));
+    REQUIRE(std::ranges::distance(manager.GetAllComponents(7)) == 2);
+    REQUIRE_THROWS_AS(manager.AddComponent(7, Value{1}, transform), InvalidComponentValue);
+
+    auto &array = dynamic_cast<ArchetypeComponentArray<ArchetypeTransform> &>(manager.GetComponentArray(transform));
+    REQUIRE(array.getEntity(7)->rotation == glm::vec3(2));
+    REQUIRE(!array.getEntity(6).has_value());
+
+    manager.EntityDestroyed(7);
+    REQUIRE(!manager.GetComponent(7, transform).has_value());
+    REQUIRE(!manager.GetComponent(7, rigidBody).has_value());
+}
+
+TEST_CASE("Archetype storage against dense arrays", "[.][benchmark][archetype]")
+{
+    constexpr Entity entityCount = 100000;
+    constexpr int frames = 100;
+    constexpr float dt = 0.016f;
+    constexpr ComponentType gravityId = 2;
+    using Clock = std::chrono::steady_clock;
+
+    // Every other entity only has a Transform, and leaves a hole in the dense arrays of the other components
+    DenseTypedComponentArray<ArchetypeTransform> transforms(denseDescription<ArchetypeTransform>("ArchetypeTransform"));
+    DenseTypedComponentArray<ArchetypeRigidBody> rigidBodies(
+        denseDescription<ArchetypeRigidBody>("ArchetypeRigidBody"));
+    DenseTypedComponentArray<ArchetypeGravity> gravities(denseDescription<ArchetypeGravity>("ArchetypeGravity"));
+    ArchetypeStorage storage;
+    storage.registerComponent(transformId, ArchetypeColumnType::of<ArchetypeTransform>());
+    storage.registerComponent(rigidBodyId, ArchetypeColumnType::of<ArchetypeRigidBody>());
+    storage.registerComponent(gravityId, ArchetypeColumnType::of<ArchetypeGravity>());
+    for (Entity entity = 0; entity < entityCount; entity++) {
+        transforms.setEntity(entity, ArchetypeTransform{});
+        storage.insert(entity, transformId, ArchetypeTransform{});
+        if (entity % 2 == 1) continue;
+        rigidBodies.setEntity(entity, ArchetypeRigidBody{});
+        gravities.setEntity(entity, ArchetypeGravity{.force = glm::vec3(0, -9.81, 0)});
+        storage.insert(entity, rigidBodyId, ArchetypeRigidBody{});
+        storage.insert(entity, gravityId, ArchetypeGravity{.force = glm::vec3(0, -9.81, 0)});
+    }
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        auto transformData = transforms.getData();
+        auto rigidBodyData = rigidBodies.getData();
+        auto gravityData = gravities.getData();
+        const auto &rigidBodyExist = rigidBodies.getExistence();
+        const auto &gravityExist = gravities.getExistence();
+        for (Entity entity = 0; entity < rigidBodyData.size(); entity++) {
+            if (!rigidBodyExist[entity] || !gravityExist[entity]) continue;
+            rigidBodyData[entity].velocity += gravityData[entity].force * dt;
+            transformData[entity].position += rigidBodyData[entity].velocity * dt;
+        }
+    }
+    const std::chrono::duration<double, std::milli> dense = Clock::now() - start;
+
+    start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        storage.each<ArchetypeTransform, ArchetypeRigidBody, ArchetypeGravity>(
+            {transformId, rigidBodyId, gravityId},
+            [](Entity, ArchetypeTransform &transform, ArchetypeRigidBody &rigidBody, ArchetypeGravity &gravity) {
+                rigidBody.velocity += gravity.force * dt;
+                transform.position += rigidBody.velocity * dt;
+            });
+    }
+    const std::chrono::duration<double, std::milli> archetype = Clock::now() - start;
+
+    REQUIRE(transforms.getEntity(0)->position == storage.get<ArchetypeTransform>(0, transformId)->position);
+    std::cout << "Transform+RigidBody+Gravity, " << entityCount << " entities, per frame:" << std::endl;
+    std::cout << "  dense arrays:     " << dense.count() / frames << "ms" << std::endl;
+    std::cout << "  archetype chunks: " << archetype.count() / frames << "ms" << std::endl;
+}
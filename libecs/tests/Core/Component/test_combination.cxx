@@ -1,7 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <chrono>
+#include <iostream>
+#include <ranges>
+
 #include <pivot/ecs/Components/Tag.hxx>
 #include <pivot/ecs/Core/Component/DenseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/FlagComponentStorage.hxx>
 #include <pivot/ecs/Core/Component/ScriptingComponentArray.hxx>
 #include <pivot/ecs/Core/Component/combination.hxx>
 #include <pivot/ecs/Core/Component/index.hxx>
@@ -95,3 +100,122 @@ TEST_CASE("Array intersections work", "[component]")
 
     REQUIRE(it == combination.end());
 }
+
+namespace
+{
+std::vector<Entity> iterate(ArrayCombination &combination)
+{
+    std::vector<Entity> visited;
+    for (auto combi: combination) visited.push_back(combi.entity);
+    return visited;
+}
+
+std::vector<Entity> bruteForce(const std::vector<std::reference_wrapper<IComponentArray>> &arrays, Entity maxEntity)
+{
+    std::vector<Entity> visited;
+    for (Entity entity = 0; entity <= maxEntity; entity++) {
+        if (std::ranges::all_of(arrays, [=](auto &array) { return array.get().entityHasValue(entity); }))
+            visited.push_back(entity);
+    }
+    return visited;
+}
+}    // namespace
+
+TEST_CASE("Array combinations skip the missing entities", "[component]")
+{
+    const Value name{Record{{"name", "bobby"}}};
+    DenseTypedComponentArray<Tag> everyEntity(Tag::description);
+    DenseTypedComponentArray<Tag> everyThird(Tag::description);
+    FlagComponentStorage rare(Tag::description);
+    ScriptingComponentArray everyOther(Tag::description);
+
+    constexpr Entity entityCount = 1000;
+    for (Entity entity = 0; entity < entityCount; entity++) {
+        everyEntity.setValueForEntity(entity, name);
+        if (entity % 3 == 0) everyThird.setValueForEntity(entity, name);
+        if (entity % 97 == 5) rare.setValueForEntity(entity, Void{});
+        if (entity % 2 == 0) everyOther.setValueForEntity(entity, Value{1});
+    }
+    // Inserted out of order in the sparse sets
+    rare.setValueForEntity(2, Void{});
+    everyOther.setValueForEntity(1, Value{1});
+
+    const std::vector<std::vector<std::reference_wrapper<IComponentArray>>> cases{
+        {everyEntity},
+        {everyEntity, everyThird},
+        {everyThird, everyEntity, rare},
+        {everyEntity, everyOther},
+        {everyOther, rare},
+        {everyThird, everyOther},
+    };
+    for (const auto &arrays: cases) {
+        ArrayCombination combination(arrays);
+        const auto expected = bruteForce(arrays, entityCount);
+        REQUIRE(iterate(combination) == expected);
+        // Iterating twice gives the same result
+        REQUIRE(iterate(combination) == expected);
+    }
+
+    // Removing components while iterating
+    ArrayCombination combination{{everyEntity, everyThird}};
+    std::vector<Entity> visited;
+    for (auto combi: combination) {
+        visited.push_back(combi.entity);
+        everyThird.setValueForEntity(combi.entity + 3, std::nullopt);
+    }
+    std::vector<Entity> expected;
+    for (Entity entity = 0; entity < entityCount; entity += 6) expected.push_back(entity);
+    REQUIRE(visited == expected);
+}
+
+TEST_CASE("Array combinations at different densities", "[.][benchmark][component]")
+{
+    constexpr Entity entityCount = 200000;
+    constexpr int repeat = 20;
+    using Clock = std::chrono::steady_clock;
+
+    const Value name{Record{{"name", "bobby"}}};
+    DenseTypedComponentArray<Tag> transforms(Tag::description);
+    for (Entity entity = 0; entity < entityCount; entity++) transforms.setValueForEntity(entity, name);
+
+    auto measure = [&](ArrayCombination &combination, auto &&iterate) {
+        std::size_t count = 0;
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) count += iterate(combination);
+        const std::chrono::duration<double, std::milli> duration = Clock::now() - start;
+        return duration.count() / repeat;
+    };
+    // The previous implementation, probing every array for every entity id
+    auto probeEveryId = [](ArrayCombination &combination) {
+        std::size_t count = 0;
+        const Entity maxEntity = std::ranges::max(
+            combination.arrays() | std::views::transform([](auto &array) { return array.get().maxEntity(); }));
+        for (Entity entity = 0; entity <= maxEntity; entity++) {
+            if (ArrayCombination::ComponentCombination(combination, entity).isValid()) count++;
+        }
+        return count;
+    };
+    auto iterateCombination = [](ArrayCombination &combination) {
+        std::size_t count = 0;
+        for ([[maybe_unused]] auto combi: combination) count++;
+        return count;
+    };
+
+    std::cout << "Dense array of " << entityCount << " entities, combined with a second array (ms per iteration)"
+              << std::endl;
+    std::cout << "density   | flag: probe  combination | dense: probe  combination" << std::endl;
+    for (double density: {0.001, 0.01, 0.1, 0.5, 1.0}) {
+        FlagComponentStorage flags(Tag::description);
+        DenseTypedComponentArray<Tag> dense(Tag::description);
+        const auto step = static_cast<Entity>(1 / density);
+        for (Entity entity = 0; entity < entityCount; entity += step) {
+            flags.setValueForEntity(entity, Void{});
+            dense.setValueForEntity(entity, name);
+        }
+        ArrayCombination withFlags{{transforms, flags}};
+        ArrayCombination withDense{{transforms, dense}};
+        std::cout << density * 100 << "%\t  | " << measure(withFlags, probeEveryId) << "  "
+                  << measure(withFlags, iterateCombination) << " | " << measure(withDense, probeEveryId) << "  "
+                  << measure(withDense, iterateCombination) << std::endl;
+    }
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <pivot/Threading/ThreadPool.hxx>
+#include <pivot/ecs/Components/Gravity.hxx>
+#include <pivot/ecs/Components/RigidBody.hxx>
+#include <pivot/ecs/Core/Component/DenseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/parallel.hxx>
+
+using namespace pivot::ecs;
+using namespace pivot::ecs::component;
+using namespace pivot::builtins::components;
+
+TEST_CASE("Parallel iteration visits the entities present in every bitmap", "[component][parallel]")
+{
+    constexpr Entity entityCount = 10000;
+    EntityBitmap even;
+    EntityBitmap triple;
+    even.resize(entityCount);
+    triple.resize(entityCount / 2);
+    for (Entity entity = 0; entity < entityCount; entity += 2) even[entity] = true;
+    for (Entity entity = 0; entity < entityCount / 2; entity += 3) triple[entity] = true;
+
+    pivot::ThreadPool pool;
+    pool.start(3);
+    for (pivot::ThreadPool *threadPool: {static_cast<pivot::ThreadPool *>(nullptr), &pool}) {
+        std::vector<std::atomic_int> visits(entityCount);
+        auto visit = [&](Entity entity) { visits[entity]++; };
+        parallelForEach(threadPool, {even, triple}, visit, 100);
+        for (Entity entity = 0; entity < entityCount; entity++) {
+            const bool expected = entity % 6 == 0 && entity < entityCount / 2;
+            REQUIRE(visits[entity] == int(expected));
+        }
+    }
+
+    std::vector<Entity> visited;
+    parallelForEach(nullptr, {even}, [&](Entity entity) { visited.push_back(entity); });
+    REQUIRE(visited.size() == entityCount / 2);
+    REQUIRE(std::ranges::is_sorted(visited));
+}
+
+TEST_CASE("Parallel physics integration scaling", "[.][benchmark][component][parallel]")
+{
+    constexpr Entity entityCount = 1000000;
+    constexpr int repeat = 20;
+    constexpr float dt = 0.01f;
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    DenseTypedComponentArray<Gravity> gravities(Gravity::description);
+    DenseTypedComponentArray<RigidBody> rigidBodies(RigidBody::description);
+    DenseTypedComponentArray<Gravity> positions(Gravity::description);
+    for (Entity entity = 0; entity < entityCount; entity++) {
+        if (entity % 4 != 3) gravities.setValueForEntity(entity, Gravity::description.defaultValue);
+        rigidBodies.setValueForEntity(entity, RigidBody::description.defaultValue);
+        positions.setValueForEntity(entity, Gravity::description.defaultValue);
+    }
+    auto gravityData = gravities.getData();
+    auto rigidBodyData = rigidBodies.getData();
+    auto positionData = positions.getData();
+
+    auto integrate = [&](pivot::ThreadPool *pool) {
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) {
+            parallelForEach(pool, {gravities.getExistence(), rigidBodies.getExistence(), positions.getExistence()},
+                            [&](Entity entity) {
+                                auto &rigidBody = rigidBodyData[entity];
+                                if (gravityData[entity].force != glm::vec3(0))
+                                    rigidBody.acceleration = gravityData[entity].force;
+                                rigidBody.velocity += rigidBody.acceleration * dt;
+                                positionData[entity].force += rigidBody.velocity * dt;
+                            });
+        }
+        return Milliseconds(Clock::now() - start).count() / repeat;
+    };
+
+    std::cout << "Integrating " << entityCount << " entities, " << std::thread::hardware_concurrency()
+              << " hardware threads (ms per tick):" << std::endl;
+    std::cout << "  serial loop: " << integrate(nullptr) << std::endl;
+    for (unsigned threads: {1, 2, 4, 8, 16}) {
+        pivot::ThreadPool pool;
+        // The calling thread takes part in the iteration
+        if (threads > 1) pool.start(threads - 1);
+        std::cout << "  " << threads << " threads: " << integrate(&pool) << std::endl;
+    }
+}
@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <pivot/ecs/Components/Gravity.hxx>
+#include <pivot/ecs/Components/RigidBody.hxx>
+#include <pivot/ecs/Components/Tag.hxx>
+#include <pivot/ecs/Core/Component/combination.hxx>
+#include <pivot/ecs/Core/Component/manager.hxx>
+#include <pivot/ecs/Core/Scene.hxx>
+
+using namespace pivot::ecs;
+using namespace pivot::ecs::component;
+using namespace pivot::ecs::data;
+using namespace pivot::builtins::components;
+
+namespace
+{
+const Value rigidBody = Record{{"velocity", glm::vec3(0)}, {"acceleration", glm::vec3(0)}};
+const Value gravity = Record{{"force", glm::vec3(0, -9.81, 0)}};
+
+std::vector<Entity> sorted(std::span<const Entity> entities)
+{
+    std::vector<Entity> result(entities.begin(), entities.end());
+    std::ranges::sort(result);
+    return result;
+}
+}    // namespace
+
+TEST_CASE("The component manager maintains the signatures and the queries", "[component][query]")
+{
+    Manager manager;
+    const auto tag = manager.RegisterComponent(Tag::description);
+    const auto rigid = manager.RegisterComponent(RigidBody::description);
+    const auto grav = manager.RegisterComponent(Gravity::description);
+
+    manager.AddComponent(1, rigidBody, rigid);
+    manager.AddComponent(1, gravity, grav);
+    manager.AddComponent(2, rigidBody, rigid);
+    REQUIRE(manager.GetSignature(1) == Signature().set(rigid).set(grav));
+    REQUIRE(manager.GetSignature(0).none());
+    REQUIRE(manager.GetSignature(100000).none());
+
+    const auto &physics = manager.GetQuery(Signature().set(rigid).set(grav));
+    REQUIRE(&manager.GetQuery(Signature().set(rigid).set(grav)) == &physics);
+    REQUIRE(sorted(physics.entities()) == std::vector<Entity>{1});
+    const auto &rigidBodies = manager.GetQuery(Signature().set(rigid));
+    REQUIRE(sorted(rigidBodies.entities()) == std::vector<Entity>{1, 2});
+
+    manager.AddComponent(2, gravity, grav);
+    manager.AddComponent(3, Value{Record{{"name", "three"}}}, tag);
+    REQUIRE(sorted(physics.entities()) == std::vector<Entity>{1, 2});
+
+    // Invalid values do not change the signature
+    REQUIRE_THROWS(manager.AddComponent(3, Value{1}, grav));
+    REQUIRE_FALSE(physics.contains(3));
+
+    manager.RemoveComponent(1, grav);
+    REQUIRE(manager.GetSignature(1) == Signature().set(rigid));
+    REQUIRE(sorted(physics.entities()) == std::vector<Entity>{2});
+    REQUIRE(sorted(rigidBodies.entities()) == std::vector<Entity>{1, 2});
+
+    manager.EntityDestroyed(2);
+    REQUIRE(manager.GetSignature(2).none());
+    REQUIRE(physics.entities().empty());
+    REQUIRE(sorted(rigidBodies.entities()) == std::vector<Entity>{1});
+}
+
+TEST_CASE("The scene keeps the signatures of the entity manager up to date", "[component][query][scene]")
+{
+    Scene scene("query");
+    auto &cm = scene.getComponentManager();
+    const auto tag = cm.GetComponentId("Tag").value();
+    const auto rigid = cm.RegisterComponent(RigidBody::description);
+
+    Entity entity = scene.CreateEntity("entity");
+    REQUIRE(scene.getSignature(entity) == Signature().set(tag));
+    cm.AddComponent(entity, rigidBody, rigid);
+    REQUIRE(scene.getSignature(entity) == Signature().set(tag).set(rigid));
+    REQUIRE(scene.getEntities().size() == 1);
+    for (auto [viewed, signature]: scene.getEntities()) {
+        REQUIRE(viewed == entity);
+        REQUIRE(signature == Signature().set(tag).set(rigid));
+    }
+
+    scene.DestroyEntity(entity);
+    REQUIRE(scene.getEntities().empty());
+    REQUIRE(cm.GetSignature(entity).none());
+}
+
+TEST_CASE("Combinations built from a query only visit its entities", "[component][query]")
+{
+    Manager manager;
+    const auto rigid = manager.RegisterComponent(RigidBody::description);
+    const auto grav = manager.RegisterComponent(Gravity::description);
+    for (Entity entity = 0; entity < 100; entity++) {
+        manager.AddComponent(entity, rigidBody, rigid);
+        if (entity % 10 == 0) manager.AddComponent(entity, gravity, grav);
+    }
+
+    ArrayCombination combination({manager.GetComponentArray(rigid), manager.GetComponentArray(grav)},
+                                 manager.GetQuery(Signature().set(rigid).set(grav)));
+    std::vector<Entity> visited;
+    for (auto combi: combination) {
+        visited.push_back(combi.entity);
+        REQUIRE(combi[1].get() == gravity);
+        // Removing a component of an entity not visited yet
+        manager.RemoveComponent(combi.entity + 10, grav);
+    }
+    REQUIRE(visited == std::vector<Entity>{0, 20, 40, 60, 80});
+}
+
+TEST_CASE("Cached queries against combinations", "[.][benchmark][component][query]")
+{
+    constexpr Entity entityCount = 200000;
+    constexpr int repeat = 20;
+    using Clock = std::chrono::steady_clock;
+
+    std::cout << "System over RigidBody+Gravity, " << entityCount << " entities with a RigidBody (ms per tick)"
+              << std::endl;
+    std::cout << "density | combination  cached query" << std::endl;
+    for (double density: {0.001, 0.01, 0.1, 1.0}) {
+        Manager manager;
+        const auto rigid = manager.RegisterComponent(RigidBody::description);
+        const auto grav = manager.RegisterComponent(Gravity::description);
+        const auto step = static_cast<Entity>(1 / density);
+        for (Entity entity = 0; entity < entityCount; entity++) {
+            manager.AddComponent(entity, rigidBody, rigid);
+            if (entity % step == 0) manager.AddComponent(entity, gravity, grav);
+        }
+        const std::vector<std::reference_wrapper<IComponentArray>> arrays{manager.GetComponentArray(rigid),
+                                                                          manager.GetComponentArray(grav)};
+        ArrayCombination combination(arrays);
+        ArrayCombination cached(arrays, manager.GetQuery(Signature().set(rigid).set(grav)));
+
+        auto measure = [&](ArrayCombination &tested) {
+            std::size_t count = 0;
+            const auto start = Clock::now();
+            for (int i = 0; i < repeat; i++) {
+                for ([[maybe_unused]] auto combi: tested) count++;
+            }
+            const std::chrono::duration<double, std::milli> duration = Clock::now() - start;
+            REQUIRE(count == repeat * ((entityCount - 1) / step + 1));
+            return duration.count() / repeat;
+        };
+        std::cout << density * 100 << "%\t| " << measure(combination) << "  " << measure(cached) << std::endl;
+    }
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <unordered_map>
+
+#include <pivot/ecs/Components/Tag.hxx>
+#include <pivot/ecs/Core/Component/FlagComponentStorage.hxx>
+#include <pivot/ecs/Core/Component/ScriptingComponentArray.hxx>
+#include <pivot/ecs/Core/Component/SparseComponentArray.hxx>
+#include <pivot/ecs/Core/Component/SparseSet.hxx>
+
+using namespace pivot::ecs;
+using namespace pivot::ecs::component;
+using namespace pivot::ecs::data;
+
+TEST_CASE("Sparse set", "[component][sparse]")
+{
+    SparseSet set;
+    REQUIRE(set.empty());
+    REQUIRE_FALSE(set.contains(0));
+    REQUIRE_FALSE(set.contains(1000000));
+
+    REQUIRE(set.insert(5) == 0);
+    REQUIRE(set.insert(SparseSet::pageSize * 3) == 1);
+    REQUIRE(set.insert(7) == 2);
+    REQUIRE(set.contains(SparseSet::pageSize * 3));
+    REQUIRE_FALSE(set.contains(6));
+
+    // The last entity takes the place of the removed one
+    REQUIRE(set.erase(5) == 0);
+    REQUIRE_FALSE(set.erase(5).has_value());
+    REQUIRE(std::ranges::equal(set.entities(), std::vector<Entity>{7, SparseSet::pageSize * 3}));
+    REQUIRE(set.index(7) == 0);
+
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE_FALSE(set.contains(7));
+}
+
+TEST_CASE("Sparse component arrays", "[component][sparse]")
+{
+    SparseComponentArray<Tag> array(Tag::description);
+
+    REQUIRE(array.getData().size() == 0);
+    REQUIRE(!array.getValueForEntity(0).has_value());
+
+    array.setValueForEntity(1000, Value{Record{{"name", "first"}}});
+    array.setValueForEntity(3, Value{Record{{"name", "second"}}});
+    array.setValueForEntity(1000, Value{Record{{"name", "replaced"}}});
+    REQUIRE(array.getData().size() == 2);
+    REQUIRE(array.maxEntity() == 1000);
+    REQUIRE(array.getValueForEntity(1000).value() == Value{Record{{"name", "replaced"}}});
+    REQUIRE(array.getEntity(3)->name == "second");
+    REQUIRE_THROWS_AS(array.setValueForEntity(4, Value{3}), InvalidComponentValue);
+
+    array.setValueForEntity(1000, std::nullopt);
+    array.setValueForEntity(1000000, std::nullopt);
+    REQUIRE(std::ranges::equal(array.getEntities(), std::vector<Entity>{3}));
+    REQUIRE(array.getData()[0].name == "second");
+    REQUIRE_FALSE(array.entityHasValue(1000));
+}
+
+TEST_CASE("Scripting component arrays are sparse", "[component][sparse]")
+{
+    ScriptingComponentArray array(Tag::description);
+
+    array.setValueForEntity(10, Value{1});
+    array.setValueForEntity(20, Value{2});
+    array.setValueForEntity(30, Value{3});
+    array.setValueForEntity(10, std::nullopt);
+    array.setValueForEntity(20, Value{4});
+
+    REQUIRE(std::ranges::equal(array.getEntities(), std::vector<Entity>{30, 20}));
+    REQUIRE(array.getValueForEntity(20) == Value{4});
+    REQUIRE(array.getValueForEntity(30) == Value{3});
+    REQUIRE_FALSE(array.getValueForEntity(10).has_value());
+    REQUIRE(array.maxEntity() == 30);
+}
+
+TEST_CASE("Sparse set against tree and hash containers", "[.][benchmark][sparse]")
+{
+    constexpr Entity entityCount = 200000;
+    constexpr Entity stride = 20;
+    constexpr int repeat = 100;
+    using Clock = std::chrono::steady_clock;
+
+    std::set<Entity> tree;
+    std::unordered_map<Entity, Value> hash;
+    FlagComponentStorage flags(Tag::description);
+    ScriptingComponentArray script(Tag::description);
+    for (Entity entity = 0; entity < entityCount; entity += stride) {
+        tree.insert(entity);
+        hash.emplace(entity, Value{1});
+        flags.setValueForEntity(entity, Void{});
+        script.setValueForEntity(entity, Value{1});
+    }
+
+    auto measure = [&](const char *name, auto &&f) {
+        std::size_t sum = 0;
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) sum += f();
+        const std::chrono::duration<double, std::micro> duration = Clock::now() - start;
+        std::cout << "  " << name << ": " << duration.count() / repeat << "us (" << sum << ")" << std::endl;
+    };
+
+    std::cout << "Iterating " << entityCount / stride << " of " << entityCount << " entities:" << std::endl;
+    measure("std::set", [&] {
+        std::size_t sum = 0;
+        for (auto entity: tree) sum += entity;
+        return sum;
+    });
+    measure("flag storage", [&] {
+        std::size_t sum = 0;
+        for (auto entity: flags.getData()) sum += entity;
+        return sum;
+    });
+    measure("std::unordered_map", [&] {
+        std::size_t sum = 0;
+        for (auto &[entity, value]: hash) sum += entity + std::get<int>(value);
+        return sum;
+    });
+    measure("scripting array", [&] {
+        std::size_t sum = 0;
+        auto entities = script.getEntities();
+        auto values = script.getData();
+        for (std::size_t i = 0; i < entities.size(); i++) sum += entities[i] + std::get<int>(values[i]);
+        return sum;
+    });
+    measure("std::set lookups", [&] {
+        std::size_t sum = 0;
+        for (Entity entity = 0; entity < entityCount; entity++) sum += tree.contains(entity);
+        return sum;
+    });
+    measure("flag storage lookups", [&] {
+        std::size_t sum = 0;
+        for (Entity entity = 0; entity < entityCount; entity++) sum += flags.entityHasValue(entity);
+        return sum;
+    });
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <iostream>
+
+#include <pivot/ecs/Components/Gravity.hxx>
+#include <pivot/ecs/Components/RigidBody.hxx>
+#include <pivot/ecs/Components/Tag.hxx>
+#include <pivot/ecs/Core/Component/SynchronizedComponentArray.hxx>
+#include <pivot/ecs/Core/Component/view.hxx>
+
+using namespace pivot::ecs;
+using namespace pivot::ecs::component;
+using namespace pivot::ecs::data;
+using namespace pivot::builtins::components;
+
+namespace
+{
+const Value rigidBody = Record{{"velocity", glm::vec3(0)}, {"acceleration", glm::vec3(0)}};
+const Value gravity = Record{{"force", glm::vec3(0, -9.81, 0)}};
+}    // namespace
+
+TEST_CASE("Typed refs access the value of a component without conversion", "[component][view]")
+{
+    Manager manager;
+    const auto grav = manager.RegisterComponent(Gravity::description);
+    const auto tag = manager.RegisterComponent(Tag::description);
+    manager.AddComponent(2, gravity, grav);
+    manager.AddComponent(2, Value{Record{{"name", "two"}}}, tag);
+
+    TypedRef<Gravity> ref(ComponentRef(manager.GetComponentArray(grav), 2));
+    REQUIRE(ref->force == glm::vec3(0, -9.81, 0));
+    ref->force.y = 1;
+    REQUIRE(manager.GetComponent(2, grav).value() == Value{Record{{"force", glm::vec3(0, 1, 0)}}});
+
+    REQUIRE_THROWS_AS(TypedRef<Gravity>(manager.GetComponentArray(grav), 1), ComponentRef::MissingComponent);
+    REQUIRE_THROWS_AS(TypedRef<RigidBody>(manager.GetComponentArray(grav), 2), InvalidComponentArray);
+    // The tag array keeps an index of the names, so the tags can only be read
+    REQUIRE_THROWS_AS(TypedRef<Tag>(manager.GetComponentArray(tag), 2), InvalidComponentArray);
+    REQUIRE(TypedRef<const Tag>(manager.GetComponentArray(tag), 2)->name == "two");
+
+    // The values of a synchronized array may only be accessed with its mutex locked
+    SynchronizedTypedComponentArray<Gravity> synchronized(Gravity::description);
+    synchronized.setValueForEntity(2, gravity);
+    REQUIRE_THROWS_AS(TypedRef<const Gravity>(synchronized, 2), InvalidComponentArray);
+}
+
+TEST_CASE("Views iterate over the entities having every component", "[component][view]")
+{
+    Manager manager;
+    const auto rigid = manager.RegisterComponent(RigidBody::description);
+    const auto grav = manager.RegisterComponent(Gravity::description);
+    SparseComponentArray<Gravity> sparse(Gravity::description);
+    for (Entity entity = 0; entity < 10; entity++) {
+        manager.AddComponent(entity, rigidBody, rigid);
+        if (entity % 3 == 0) manager.AddComponent(entity, gravity, grav);
+        if (entity % 2 == 0) sparse.setEntity(entity, Gravity{glm::vec3(entity)});
+    }
+
+    std::vector<Entity> visited;
+    for (auto [entity, body, force]: view<RigidBody, const Gravity>(manager)) {
+        visited.push_back(entity);
+        body.acceleration = force.force;
+    }
+    REQUIRE(visited == std::vector<Entity>{0, 3, 6, 9});
+    REQUIRE(manager.GetComponent(3, rigid).value() ==
+            Value{Record{{"velocity", glm::vec3(0)}, {"acceleration", glm::vec3(0, -9.81, 0)}}});
+    REQUIRE(manager.GetComponent(4, rigid).value() == rigidBody);
+
+    visited.clear();
+    View<Gravity, RigidBody> mixed({sparse, manager.GetComponentArray(rigid)});
+    for (auto [entity, force, body]: mixed) {
+        visited.push_back(entity);
+        REQUIRE(force.force == glm::vec3(entity));
+    }
+    REQUIRE(visited == std::vector<Entity>{0, 2, 4, 6, 8});
+
+    ArrayCombination combination({manager.GetComponentArray(grav), manager.GetComponentArray(rigid)});
+    std::size_t count = 0;
+    for ([[maybe_unused]] auto &&row: View<Gravity>(combination)) count++;
+    REQUIRE(count == 4);
+    REQUIRE_THROWS_AS(View<RigidBody>(combination), InvalidComponentArray);
+}
+
+TEST_CASE("Typed views against data::Value access", "[.][benchmark][component][view]")
+{
+    constexpr Entity entityCount = 100000;
+    constexpr int repeat = 20;
+    constexpr float dt = 0.01f;
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    Manager manager;
+    const auto rigid = manager.RegisterComponent(RigidBody::description);
+    const auto grav = manager.RegisterComponent(Gravity::description);
+    for (Entity entity = 0; entity < entityCount; entity++) {
+        manager.AddComponent(entity, rigidBody, rigid);
+        manager.AddComponent(entity, gravity, grav);
+    }
+    ArrayCombination combination({manager.GetComponentArray(grav), manager.GetComponentArray(rigid)});
+
+    auto measure = [&](const char *name, auto &&tick) {
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) tick();
+        std::cout << "  " << name << ": " << Milliseconds(Clock::now() - start).count() / repeat << "ms per tick"
+                  << std::endl;
+    };
+    std::cout << "Integrating the velocity of " << entityCount << " entities:" << std::endl;
+    measure("ComponentRef get/set", [&] {
+        for (auto components: combination) {
+            const auto force = std::get<glm::vec3>(std::get<Record>(components[0].get()).at("force"));
+            auto body = components[1].get();
+            std::get<glm::vec3>(std::get<Record>(body).at("velocity")) += force * dt;
+            components[1].set(body);
+        }
+    });
+    measure("View", [&] {
+        for (auto [entity, force, body]: View<const Gravity, RigidBody>(combination)) body.velocity += force.force * dt;
+    });
+}
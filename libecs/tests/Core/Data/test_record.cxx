@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <iostream>
+
+#include <boost/fusion/include/adapt_struct.hpp>
+#include <pivot/ecs/Core/Component/description_helpers_impl.hxx>
+#include <pivot/ecs/Core/Data/value.hxx>
+#include <pivot/ecs/Core/Data/value_serialization.hxx>
+#include <pivot/memory/AllocationCounter.hxx>
+
+using namespace pivot::ecs;
+using namespace pivot::ecs::data;
+
+namespace
+{
+struct Transform {
+    glm::vec3 position;
+    glm::vec3 rotation;
+    glm::vec3 scale;
+};
+}    // namespace
+
+BOOST_FUSION_ADAPT_STRUCT(Transform, position, rotation, scale);
+
+PIVOT_COUNT_ALLOCATIONS()
+
+TEST_CASE("Field names are interned", "[data][record]")
+{
+    const FieldName position("position");
+    REQUIRE(FieldName(std::string("position")).id() == position.id());
+    REQUIRE(FieldName("rotation").id() != position.id());
+    REQUIRE(position == "position");
+    REQUIRE(position.str() == "position");
+    REQUIRE(FieldName("a") < FieldName("b"));
+}
+
+TEST_CASE("Records keep their fields sorted by name", "[data][record]")
+{
+    Record record{{"scale", 1}, {"position", 2}, {"rotation", 3}, {"position", 4}};
+    REQUIRE(record.size() == 3);
+    std::vector<std::string> names;
+    for (const auto &[name, value]: record) names.push_back(name);
+    REQUIRE(names == std::vector<std::string>{"position", "rotation", "scale"});
+    REQUIRE(record.at("position") == Value{2});
+    REQUIRE(record.field(1).second == Value{3});
+    REQUIRE_THROWS_AS(record.at("missing"), std::out_of_range);
+    REQUIRE_FALSE(record.contains("missing"));
+
+    record["missing"] = 5;
+    REQUIRE(record.field(0).first == "missing");
+    REQUIRE_FALSE(record.insert({"scale", 6}).second);
+    REQUIRE(record.insert_or_assign("scale", 6).first->second == Value{6});
+    // A wrong hint still keeps the order
+    record.insert(record.begin(), {"z", 7});
+    REQUIRE(record.field(record.size() - 1).first == "z");
+    REQUIRE(record.erase("z") == 1);
+    REQUIRE(record == Record{{"missing", 5}, {"position", 2}, {"rotation", 3}, {"scale", 6}});
+
+    const nlohmann::json json = Value{record};
+    REQUIRE(json.get<Value>() == Value{record});
+}
+
+TEST_CASE("Components are converted through the layout of their record", "[data][record]")
+{
+    using Helpers = component::helpers::Helpers<Transform>;
+    const Transform transform{glm::vec3(1), glm::vec3(2), glm::vec3(3)};
+    const Value value = Helpers::createValueFromType(transform);
+    REQUIRE(value == Value{Record{{"position", glm::vec3(1)}, {"rotation", glm::vec3(2)}, {"scale", glm::vec3(3)}}});
+    REQUIRE(value.type() == Helpers::getType());
+
+    Transform parsed;
+    Helpers::updateTypeWithValue(parsed, value);
+    REQUIRE(parsed.rotation == transform.rotation);
+    // Records missing fields do not have the others at the index of the layout
+    Helpers::updateTypeWithValue(parsed, Value{Record{{"scale", glm::vec3(4)}}});
+    REQUIRE(parsed.position == glm::vec3(0));
+    REQUIRE(parsed.scale == glm::vec3(4));
+}
+
+TEST_CASE("Copies of records do not allocate", "[data][record]")
+{
+    const Value value = Record{{"name", "a name too long to be stored inline"}, {"scale", glm::vec3(1)}};
+    pivot::memory::AllocationCounter counter;
+    const Value copy = value;
+    REQUIRE(counter.getCount() == 0);
+    REQUIRE(copy == value);
+
+    // The fields of a component are stored in a single allocation
+    const Value transform = component::helpers::Helpers<Transform>::createValueFromType(Transform{});
+    REQUIRE(counter.getCount() == 1);
+    REQUIRE(std::get<Record>(transform).size() == 3);
+}
+
+TEST_CASE("Record conversion allocations", "[.][benchmark][data][record]")
+{
+    constexpr int repeat = 100000;
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+    using Helpers = component::helpers::Helpers<Transform>;
+
+    const Transform transform{glm::vec3(1), glm::vec3(2), glm::vec3(3)};
+    Value value = Helpers::createValueFromType(transform);
+    Transform parsed;
+
+    auto measure = [&](const char *name, auto &&f) {
+        pivot::memory::AllocationCounter counter;
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) f();
+        const auto duration = Nanoseconds(Clock::now() - start).count() / repeat;
+        std::cout << "  " << name << ": " << double(counter.getCount()) / repeat << " allocations, " << duration
+                  << "ns" << std::endl;
+    };
+    std::cout << "Transform conversions (per call):" << std::endl;
+    measure("createValueFromType", [&] { value = Helpers::createValueFromType(transform); });
+    measure("updateTypeWithValue", [&] { Helpers::updateTypeWithValue(parsed, value); });
+    measure("copy", [&] { Value copy = value; });
+    measure("field access", [&] { parsed.scale = std::get<glm::vec3>(std::get<Record>(value).at("scale")); });
+    REQUIRE(parsed.scale == transform.scale);
+}
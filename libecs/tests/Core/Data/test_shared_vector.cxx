@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <utility>
+
+#include <pivot/ecs/Core/Data/shared_vector.hxx>
+#include <pivot/ecs/Core/Data/value.hxx>
+
+using namespace pivot::ecs::data;
+
+TEST_CASE("Shared vectors copy their elements on modification", "[data][shared_vector]")
+{
+    const SharedVector<int> empty;
+    REQUIRE(empty.empty());
+    REQUIRE_FALSE(empty.shared());
+
+    SharedVector<int> first{1, 2, 3};
+    const SharedVector<int> second = first;
+    REQUIRE(first.shared());
+    REQUIRE(&std::as_const(first).front() == &second.front());
+
+    first.push_back(4);
+    REQUIRE_FALSE(first.shared());
+    REQUIRE(first == SharedVector<int>{1, 2, 3, 4});
+    REQUIRE(second == SharedVector<int>{1, 2, 3});
+    REQUIRE(std::vector<int>(second.begin(), second.end()) == std::vector<int>{1, 2, 3});
+
+    first.erase(first.begin());
+    first.insert(first.begin() + 1, 5);
+    REQUIRE(first == SharedVector<int>{2, 5, 3, 4});
+}
+
+TEST_CASE("Shared vectors keep the elements referenced mutably to themselves", "[data][shared_vector]")
+{
+    SharedVector<int> vector{1, 2, 3};
+    int &element = vector[0];
+    const SharedVector<int> copy = vector;
+    REQUIRE_FALSE(vector.shared());
+    element = 4;
+    REQUIRE(vector[0] == 4);
+    REQUIRE(copy[0] == 1);
+    // The copy was never accessed mutably
+    const SharedVector<int> other = copy;
+    REQUIRE(copy.shared());
+}
+
+TEST_CASE("Shared vectors modified explicitly stay shareable", "[data][shared_vector]")
+{
+    SharedVector<int> vector{1, 2, 3};
+    vector.modify(0, [](int &element) { element = 4; });
+    vector.eraseAt(1);
+    vector.push_back(5);
+    const SharedVector<int> copy = vector;
+    REQUIRE(vector.shared());
+    REQUIRE(copy == SharedVector<int>{4, 3, 5});
+
+    // Modifying a shared vector copies its elements first
+    vector.modify(0, [](int &element) { element = 6; });
+    REQUIRE_FALSE(vector.shared());
+    REQUIRE(vector == SharedVector<int>{6, 3, 5});
+    REQUIRE(copy == SharedVector<int>{4, 3, 5});
+    REQUIRE(sizeof(SharedVector<int>) == sizeof(void *));
+}
+
+TEST_CASE("Records and lists share their payload between their copies", "[data][shared_vector]")
+{
+    const Value record = Record{{"position", glm::vec3(1)}, {"name", "a name too long to be stored inline"}};
+    const Value copy = record;
+    REQUIRE(&std::get<Record>(copy).field(0) == &std::get<Record>(record).field(0));
+
+    Value list = List{{Value{1.0}, Value{2.0}}};
+    Value modified = list;
+    std::get<List>(modified).items.push_back(Value{3.0});
+    REQUIRE(std::get<List>(list).items.size() == 2);
+    REQUIRE(std::get<List>(modified).items.size() == 3);
+}
+
+TEST_CASE("Records read through a const reference stay shareable", "[data][shared_vector]")
+{
+    Record record{{"position", glm::vec3(1)}, {"scale", glm::vec3(2)}};
+    REQUIRE(std::as_const(record).at("scale") == Value{glm::vec3(2)});
+    REQUIRE(record.modify("scale", [](Value &scale) { scale = glm::vec3(3); }));
+    REQUIRE_FALSE(record.modify("missing", [](Value &) {}));
+    REQUIRE(record.erase("position") == 1);
+    const Record copy = record;
+    REQUIRE(&copy.field(0) == &std::as_const(record).field(0));
+    REQUIRE(copy == Record{{"scale", glm::vec3(3)}});
+}
@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+#include "pivot/ecs/Core/EntityManager.hxx"
+#include "pivot/ecs/Core/Event/manager.hxx"
+#include "pivot/ecs/Core/Systems/manager.hxx"
+#include <pivot/ecs/Components/Tag.hxx>
+
+using namespace pivot::ecs;
+using namespace pivot::ecs::data;
+
+namespace
+{
+const event::Description tick{
+    .name = "Tick",
+    .entities = {},
+    .payload = BasicType::Number,
+};
+
+const event::Description collision{
+    .name = "Collision",
+    .entities = {"first", "second"},
+    .payload = BasicType::Void,
+};
+
+const event::Description echo{
+    .name = "Echo",
+    .entities = {},
+    .payload = BasicType::Number,
+};
+
+using Handler = std::function<std::vector<event::Event>(const event::Event &)>;
+
+systems::Description makeSystem(std::string name, const event::Description &listener, Handler handler)
+{
+    std::vector<std::vector<std::string>> eventComponents(listener.entities.size(), {"Tag"});
+    return {
+        .name = name,
+        .systemComponents = {},
+        .eventListener = listener,
+        .eventComponents = eventComponents,
+        .system = [handler](const systems::Description &, component::ArrayCombination &,
+                            const event::EventWithComponent &event) { return handler(event.event); },
+    };
+}
+
+struct Fixture {
+    Fixture()
+    {
+        cManager.RegisterComponent(Tag::description);
+        for (int i = 0; i < 4; i++) {
+            const Entity entity = eManager.CreateEntity();
+            cManager.AddComponent(entity, Value{Record{{"name", std::to_string(i)}}}, 0);
+        }
+    }
+
+    component::Manager cManager;
+    EntityManager eManager;
+    systems::Manager sManager{cManager, eManager};
+    event::Manager eventManager{sManager};
+};
+}    // namespace
+
+TEST_CASE("Queued events are dispatched in batches of the same type", "[event][queue]")
+{
+    Fixture fixture;
+    std::vector<std::string> received;
+    fixture.sManager.useSystem(makeSystem("Ticks", tick, [&](const event::Event &event) {
+        received.push_back("Tick " + std::to_string(int(std::get<double>(event.payload))));
+        return std::vector<event::Event>{};
+    }));
+    fixture.sManager.useSystem(makeSystem("Collisions", collision, [&](const event::Event &event) {
+        received.push_back("Collision " + std::to_string(event.entities[0]) + std::to_string(event.entities[1]));
+        return std::vector<event::Event>{};
+    }));
+
+    fixture.eventManager.queueEvent({tick, {}, Value{1.0}});
+    fixture.eventManager.queueEvent({collision, {0, 1}, Value{Void{}}});
+    fixture.eventManager.queueEvent({tick, {}, Value{2.0}});
+    fixture.eventManager.queueEvent({collision, {1, 2}, Value{Void{}}});
+    REQUIRE_THROWS(fixture.eventManager.queueEvent({tick, {}, Value{"wrong payload"}}));
+    REQUIRE(fixture.eventManager.getQueuedEventCount() == 4);
+    REQUIRE(received.empty());
+
+    fixture.eventManager.dispatchEvents();
+    REQUIRE(received == std::vector<std::string>{"Tick 1", "Tick 2", "Collision 01", "Collision 12"});
+    REQUIRE(fixture.eventManager.getQueuedEventCount() == 0);
+}
+
+TEST_CASE("Queued events can be coalesced", "[event][queue]")
+{
+    Fixture fixture;
+    std::vector<std::string> received;
+    fixture.sManager.useSystem(makeSystem("Ticks", tick, [&](const event::Event &event) {
+        received.push_back("Tick " + std::to_string(int(std::get<double>(event.payload))));
+        return std::vector<event::Event>{};
+    }));
+    fixture.sManager.useSystem(makeSystem("Collisions", collision, [&](const event::Event &event) {
+        received.push_back("Collision " + std::to_string(event.entities[0]) + std::to_string(event.entities[1]));
+        return std::vector<event::Event>{};
+    }));
+    fixture.eventManager.setCoalescing("Tick", event::Coalescing::Latest);
+    fixture.eventManager.setCoalescing("Collision", event::Coalescing::LatestPerEntities);
+
+    for (double i = 1; i <= 3; i++) fixture.eventManager.queueEvent({tick, {}, Value{i}});
+    fixture.eventManager.queueEvent({collision, {0, 1}, Value{Void{}}});
+    fixture.eventManager.queueEvent({collision, {1, 2}, Value{Void{}}});
+    fixture.eventManager.queueEvent({collision, {0, 1}, Value{Void{}}});
+    fixture.eventManager.queueEvent({collision, {1, 0}, Value{Void{}}});
+    REQUIRE(fixture.eventManager.getQueuedEventCount() == 4);
+
+    fixture.eventManager.dispatchEvents();
+    REQUIRE(received == std::vector<std::string>{"Tick 3", "Collision 01", "Collision 12", "Collision 10"});
+}
+
+TEST_CASE("Child events are dispatched breadth first up to the maximum depth", "[event][queue]")
+{
+    Fixture fixture;
+    std::vector<int> received;
+    // Every echo sends two echoes with the next value
+    fixture.sManager.useSystem(makeSystem("Echoes", echo, [&](const event::Event &event) {
+        const double value = std::get<double>(event.payload);
+        received.push_back(int(value));
+        return std::vector<event::Event>{{echo, {}, Value{value + 1}}, {echo, {}, Value{value + 1}}};
+    }));
+    fixture.eventManager.setMaxDepth(3);
+
+    fixture.eventManager.sendEvent({echo, {}, Value{0.0}});
+    REQUIRE(received == std::vector<int>{0, 1, 1, 2, 2, 2, 2});
+    REQUIRE(fixture.eventManager.getQueuedEventCount() == 8);
+
+    // The events left are dispatched next time
+    received.clear();
+    fixture.eventManager.setCoalescing("Echo", event::Coalescing::Latest);
+    fixture.eventManager.dispatchEvents();
+    REQUIRE(received == std::vector<int>{3, 3, 3, 3, 3, 3, 3, 3, 4, 5});
+}
+
+TEST_CASE("Collision storm dispatch", "[.][benchmark][event][queue]")
+{
+    constexpr int contactCount = 10000;
+    constexpr int repeat = 10;
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    Fixture fixture;
+    std::size_t handled = 0;
+    // Like the collision system, every contact emits an event for each of the two entities
+    fixture.sManager.useSystem(makeSystem("Physics", tick, [&](const event::Event &) {
+        std::vector<event::Event> events;
+        for (int i = 0; i < contactCount; i++) {
+            const Entity first = i % 4;
+            const Entity second = (i + 1) % 4;
+            events.push_back({collision, {first, second}, Value{Void{}}});
+            events.push_back({collision, {second, first}, Value{Void{}}});
+        }
+        return events;
+    }));
+    for (int i = 0; i < 8; i++) {
+        fixture.sManager.useSystem(makeSystem("Listener " + std::to_string(i), collision, [&](const event::Event &) {
+            handled++;
+            return std::vector<event::Event>{};
+        }));
+    }
+
+    auto measure = [&](const char *name, auto &&send) {
+        handled = 0;
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) send();
+        std::cout << "  " << name << ": " << Milliseconds(Clock::now() - start).count() / repeat << "ms per tick ("
+                  << handled / repeat << " system calls)" << std::endl;
+    };
+    std::cout << contactCount << " contacts, 8 systems listening to collisions:" << std::endl;
+    // What sendEvent used to do
+    std::function<void(const event::Event &)> recursive = [&](const event::Event &event) {
+        for (const auto &childEvent: fixture.sManager.execute(event)) recursive(childEvent);
+    };
+    measure("recursive dispatch", [&] { recursive({tick, {}, Value{0.1}}); });
+    measure("batched queue", [&] { fixture.eventManager.sendEvent({tick, {}, Value{0.1}}); });
+    fixture.eventManager.setCoalescing("Collision", event::Coalescing::LatestPerEntities);
+    measure("batched queue, coalesced per entities", [&] { fixture.eventManager.sendEvent({tick, {}, Value{0.1}}); });
+}
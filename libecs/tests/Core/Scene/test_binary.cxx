@@ -0,0 +1,182 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <nlohmann/json.hpp>
+#include <pivot/ecs/Components/Gravity.hxx>
+#include <pivot/ecs/Components/RigidBody.hxx>
+#include <pivot/ecs/Components/Tag.hxx>
+#include <pivot/ecs/Core/BinaryScene.hxx>
+
+using namespace pivot::ecs;
+using namespace nlohmann;
+
+namespace
+{
+std::vector<event::Event> test_binary_scene_system(const systems::Description &, component::ArrayCombination &,
+                                                   const event::EventWithComponent &)
+{
+    return {};
+}
+
+const systems::Description description{
+    .name = "Test Description",
+    .systemComponents = {"RigidBody", "Tag"},
+    .eventListener =
+        event::Description{
+            .name = "Colid",
+            .entities = {},
+            .payload = data::BasicType::Number,
+        },
+    .system = &test_binary_scene_system,
+};
+
+struct Indexes {
+    component::Index cIndex;
+    systems::Index sIndex;
+
+    Indexes()
+    {
+        cIndex.registerComponent(pivot::builtins::components::Gravity::description);
+        cIndex.registerComponent(pivot::builtins::components::RigidBody::description);
+        cIndex.registerComponent(Tag::description);
+        sIndex.registerSystem(description);
+    }
+};
+}    // namespace
+
+TEST_CASE("Binary scenes convert exactly to and from JSON", "[Scene][binary]")
+{
+    const json scene = json::parse(R"({
+        "name": "binary",
+        "components": [
+            {"Tag": {"name": "first"},
+             "Model": {"asset": {"name": "cube"}, "color": {"color": {"rgba": [1, 0, 0, 1]}}}},
+            null,
+            {"Tag": {"name": ""}, "Target": {"entity": 0}, "Count": 3, "Visible": true, "Size": [1.5, 2],
+             "Model": {"asset": {"name": "sphere"}, "color": {"color": {"rgba": [0, 1, 0, 0.5]}}}},
+            {"Target": {"entity": null}, "Count": -1, "Visible": false, "Size": [0, 0]},
+            null
+        ],
+        "systems": ["Test Description"],
+        "scripts": ["scripts/test.pvscript"],
+        "assets": ["cube", "sphere"]
+    })");
+
+    const auto data = BinaryScene::fromJson(scene);
+    const BinaryScene binary(data);
+    REQUIRE(binary.getName() == "binary");
+    REQUIRE(binary.getSystems() == std::vector<std::string>{"Test Description"});
+    REQUIRE(binary.getScripts() == std::vector<std::string>{"scripts/test.pvscript"});
+    REQUIRE(binary.getAssets() == std::vector<std::string>{"cube", "sphere"});
+    REQUIRE(binary.getSchema().size() == 6);
+    REQUIRE(binary.toJson() == scene);
+    REQUIRE(BinaryScene::fromJson(binary.toJson()) == data);
+}
+
+TEST_CASE("Binary scenes load like JSON scenes", "[Scene][binary]")
+{
+    Indexes indexes;
+    Scene scene("saved");
+    scene.getComponentManager().RegisterComponent(pivot::builtins::components::RigidBody::description);
+    scene.registerSystem(description);
+    const Entity first = scene.CreateEntity("first");
+    scene.CreateEntity("second");
+    scene.getComponentManager().AddComponent(
+        first, pivot::builtins::components::RigidBody::description.defaultValue,
+        scene.getComponentManager().GetComponentId("RigidBody").value());
+
+    if (!std::filesystem::exists("test")) { std::filesystem::create_directory("test"); }
+    const std::filesystem::path path = std::string("test/save") + BinaryScene::extension;
+    scene.saveBinary(path);
+    REQUIRE(BinaryScene::isBinaryScene(path));
+    const BinaryScene binary(path);
+    REQUIRE(binary.toJson() == scene.getJson());
+
+    auto loaded = binary.load(indexes.cIndex, indexes.sIndex);
+    REQUIRE(loaded->getName() == "saved");
+    REQUIRE(loaded->getLivingEntityCount() == 2);
+    REQUIRE(loaded->getJson() == scene.getJson());
+    auto &cManager = loaded->getComponentManager();
+    REQUIRE(cManager.GetComponent(first, cManager.GetComponentId("RigidBody").value()).has_value());
+    for (auto [name, _]: loaded->getSystemManager()) { REQUIRE(name == "Test Description"); }
+}
+
+TEST_CASE("Malformed binary scenes are rejected", "[Scene][binary]")
+{
+    const json scene = json::parse(R"({"name": "bad", "components": [{"Tag": {"name": "a"}}, {"Tag": 1}]})");
+    REQUIRE_THROWS_AS(BinaryScene::fromJson(scene), BinaryScene::FormatError);
+
+    auto data = BinaryScene::fromJson(json::parse(R"({"name": "good", "components": [{"Tag": {"name": "a"}}]})"));
+    REQUIRE_NOTHROW(BinaryScene(data));
+    for (std::size_t size = 0; size < data.size(); size++) {
+        REQUIRE_THROWS_AS(BinaryScene(std::span(data).first(size)).toJson(), BinaryScene::FormatError);
+    }
+    // Huge counts must be rejected before anything is allocated for them
+    auto forge = [&](std::size_t offset, std::uint32_t expected) {
+        auto forged = data;
+        std::uint32_t count;
+        std::memcpy(&count, forged.data() + offset, sizeof(count));
+        REQUIRE(count == expected);
+        count = 0xffffffff;
+        std::memcpy(forged.data() + offset, &count, sizeof(count));
+        return forged;
+    };
+    // Number of systems, of components in the schema, and of entities in the Tag block
+    for (auto [offset, expected]: {std::pair{24, 0}, std::pair{36, 1}, std::pair{72, 1}}) {
+        const auto forged = forge(offset, expected);
+        REQUIRE_THROWS_AS(BinaryScene(forged).toJson(), BinaryScene::FormatError);
+    }
+    data.at(8) = std::byte{0xff};
+    REQUIRE_THROWS_AS(BinaryScene(data), BinaryScene::FormatError);
+
+    Indexes indexes;
+    const BinaryScene unknown(BinaryScene::fromJson(json::parse(R"({"name": "", "components": [{"Unknown": 1}]})")));
+    REQUIRE_THROWS_AS(unknown.load(indexes.cIndex, indexes.sIndex), std::runtime_error);
+}
+
+TEST_CASE("Binary scene loading", "[.][benchmark][Scene][binary]")
+{
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    Indexes indexes;
+    if (!std::filesystem::exists("test")) { std::filesystem::create_directory("test"); }
+    auto measure = [&](const char *name, auto &&f) {
+        const auto start = Clock::now();
+        f();
+        std::cout << "  " << name << ": " << Milliseconds(Clock::now() - start).count() << "ms" << std::endl;
+    };
+    for (std::size_t count: {10'000, 100'000, 500'000}) {
+        json scene{{"name", "benchmark"}, {"systems", {"Test Description"}}};
+        auto &components = scene["components"];
+        for (std::size_t i = 0; i < count; i++) {
+            components.push_back({
+                {"Tag", {{"name", "entity " + std::to_string(i)}}},
+                {"RigidBody", {{"velocity", {1.0, 2.0, 3.0}}, {"acceleration", {0.0, -1.0, 0.0}}}},
+                {"Gravity", {{"force", {0.0, -9.8, 0.0}}}},
+            });
+        }
+        std::ofstream("test/benchmark.json") << scene;
+        BinaryScene::write("test/benchmark.pvscene", BinaryScene::fromJson(scene));
+        scene = nullptr;
+
+        std::cout << count << " entities:" << std::endl;
+        measure("JSON", [&] {
+            std::ifstream file("test/benchmark.json");
+            auto loaded = Scene::load(json::parse(file), indexes.cIndex, indexes.sIndex);
+            REQUIRE(loaded->getLivingEntityCount() == count);
+        });
+        measure("binary", [&] {
+            auto loaded = BinaryScene("test/benchmark.pvscene").load(indexes.cIndex, indexes.sIndex);
+            REQUIRE(loaded->getLivingEntityCount() == count);
+        });
+        std::cout << "  size: " << std::filesystem::file_size("test/benchmark.json") << " bytes in JSON, "
+                  << std::filesystem::file_size("test/benchmark.pvscene") << " bytes in binary" << std::endl;
+    }
+    std::filesystem::remove("test/benchmark.json");
+    std::filesystem::remove("test/benchmark.pvscene");
+}
@@ -1,9 +1,19 @@
 #include "pivot/ecs/Core/Scene.hxx"
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <iostream>
+#include <sstream>
 #include <nlohmann/json.hpp>
 #include <pivot/ecs/Components/Gravity.hxx>
 #include <pivot/ecs/Components/RigidBody.hxx>
 #include <pivot/ecs/Components/Tag.hxx>
+#include <pivot/ecs/Core/Component/ScriptingComponentArray.hxx>
+
+#if defined(__linux__)
+    #include <sys/resource.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
 
 using namespace nlohmann;
 using namespace pivot::ecs::data;
@@ -58,3 +68,118 @@ TEST_CASE("Load the scene", "[Scene][Load]")
     auto &sManager = LaS->getSystemManager();
     for (auto [name, _]: sManager) { REQUIRE(name == "Test Description"); }
 }
+
+std::unique_ptr<pivot::ecs::component::IComponentArray> create_model_array(pivot::ecs::component::Description description)
+{
+    return std::make_unique<pivot::ecs::component::ScriptingComponentArray>(description);
+}
+
+TEST_CASE("Stream the scene", "[Scene][Load]")
+{
+    const std::string input =
+        R"({"assets": ["cube"], "components": [{"Gravity": {"force": [0.0,-9.8,0.0]},"RigidBody": {"acceleration": [0.0,0.0,0.0],"velocity": [1.0,2.0,3.0]},"Tag": {"name": "yolo"}}, null, {"Tag": {"name": "alloy"}, "Model": {"asset": {"asset": {"name": "cube"}}, "color": {"color": {"rgba": [1, 0, 0.5, 1]}}, "count": 3, "size": [2, 1.5], "target": {"entity": 0}, "visible": true}}, {"Model": {"asset": {"asset": {"name": ""}}, "color": {"color": {"rgba": [0, 0, 0, 0]}}, "count": -1, "size": [0, 0], "target": {"entity": null}, "visible": false}}],"name": "Streamed","scripts": ["test.pvscript"],"systems":["Test Description"]})";
+    const Type model = RecordType{
+        {"asset", BasicType::Asset}, {"color", BasicType::Color},      {"count", BasicType::Integer},
+        {"size", BasicType::Vec2},   {"target", BasicType::EntityRef}, {"visible", BasicType::Boolean},
+    };
+
+    pivot::ecs::component::Index cIndex;
+    pivot::ecs::systems::Index sIndex;
+    cIndex.registerComponent(pivot::builtins::components::Gravity::description);
+    cIndex.registerComponent(pivot::builtins::components::RigidBody::description);
+    cIndex.registerComponent(pivot::ecs::Tag::description);
+    cIndex.registerComponent(pivot::ecs::component::Description{
+        "Model", model, pivot::ecs::Provenance::builtin(), model.defaultValue(),
+        create_model_array});
+    sIndex.registerSystem(pivot::ecs::systems::Description{
+        .name = "Test Description",
+        .systemComponents = {"RigidBody", "Tag"},
+        .eventListener = pivot::ecs::event::Description{.name = "Colid", .payload = BasicType::Number},
+        .system = &test_load_scene_system,
+    });
+
+    std::istringstream stream(input);
+    auto streamed = pivot::ecs::Scene::loadStream(stream, cIndex, sIndex);
+    auto loaded = pivot::ecs::Scene::load(json::parse(input), cIndex, sIndex);
+    REQUIRE(streamed->getName() == "Streamed");
+    REQUIRE(streamed->getLivingEntityCount() == 4);
+    REQUIRE(streamed->getJson() == loaded->getJson());
+
+    // The systems need their components, which are registered later when they come first
+    std::istringstream systemsFirst(
+        R"({"systems": ["Test Description"], "name": "Systems first", "components": [{"RigidBody": {"acceleration": [0.0,0.0,0.0],"velocity": [1.0,2.0,3.0]}}]})");
+    auto reordered = pivot::ecs::Scene::loadStream(systemsFirst, cIndex, sIndex);
+    REQUIRE(reordered->getLivingEntityCount() == 1);
+    for (auto [name, _]: reordered->getSystemManager()) { REQUIRE(name == "Test Description"); }
+
+    stream.clear();
+    stream.seekg(0);
+    const auto resources = pivot::ecs::Scene::readResources(stream);
+    REQUIRE(resources.scripts == std::vector<std::string>{"test.pvscript"});
+    REQUIRE(resources.assets == std::vector<std::string>{"cube"});
+
+    std::istringstream unknown(R"({"name": "", "components": [{"Unknown": 1}]})");
+    REQUIRE_THROWS_AS(pivot::ecs::Scene::loadStream(unknown, cIndex, sIndex), std::runtime_error);
+    std::istringstream truncated(input.substr(0, input.size() / 2));
+    REQUIRE_THROWS_AS(pivot::ecs::Scene::loadStream(truncated, cIndex, sIndex), json::parse_error);
+}
+
+TEST_CASE("Streaming scene loading", "[.][benchmark][Scene][Load]")
+{
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    pivot::ecs::component::Index cIndex;
+    pivot::ecs::systems::Index sIndex;
+    cIndex.registerComponent(pivot::builtins::components::Gravity::description);
+    cIndex.registerComponent(pivot::builtins::components::RigidBody::description);
+    cIndex.registerComponent(pivot::ecs::Tag::description);
+
+    // Every load runs in its own process on Linux, so that their peak memory can be measured independently
+    auto measure = [&](const char *name, auto &&load) {
+#if defined(__linux__)
+        std::cout.flush();
+        if (fork() != 0) {
+            wait(nullptr);
+            return;
+        }
+        // Resets the peak resident set size to the current one
+        std::ofstream("/proc/self/clear_refs") << "5";
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        const long before = usage.ru_maxrss;
+#endif
+        const auto start = Clock::now();
+        load();
+        std::cout << "  " << name << ": " << Milliseconds(Clock::now() - start).count() << "ms";
+#if defined(__linux__)
+        getrusage(RUSAGE_SELF, &usage);
+        std::cout << ", peak RSS +" << (usage.ru_maxrss - before) / 1024 << "MiB" << std::endl;
+        std::_Exit(0);
+#else
+        std::cout << std::endl;
+#endif
+    };
+    for (std::size_t count: {10'000, 100'000, 500'000}) {
+        std::string input = R"({"assets": [], "components": [)";
+        for (std::size_t i = 0; i < count; i++) {
+            if (i != 0) input += ',';
+            input += R"({"Gravity": {"force": [0.0,-9.8,0.0]},"RigidBody": {"acceleration": [0.0,-1.0,0.0],)"
+                     R"("velocity": [1.0,2.0,3.0]},"Tag": {"name": "entity )" +
+                     std::to_string(i) + R"("}})";
+        }
+        input += R"(], "name": "benchmark", "scripts": [], "systems": []})";
+
+        std::cout << count << " entities:" << std::endl;
+        measure("Scene::load", [&] {
+            std::istringstream stream(input);
+            auto scene = pivot::ecs::Scene::load(json::parse(stream), cIndex, sIndex);
+            if (scene->getLivingEntityCount() != count) std::abort();
+        });
+        measure("Scene::loadStream", [&] {
+            std::istringstream stream(input);
+            auto scene = pivot::ecs::Scene::loadStream(stream, cIndex, sIndex);
+            if (scene->getLivingEntityCount() != count) std::abort();
+        });
+    }
+}
@@ -0,0 +1,228 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <pivot/Threading/ThreadPool.hxx>
+#include <pivot/ecs/Components/Gravity.hxx>
+#include <pivot/ecs/Components/RigidBody.hxx>
+#include <pivot/ecs/Components/Tag.hxx>
+#include <pivot/ecs/Core/EntityManager.hxx>
+#include <pivot/ecs/Core/Systems/manager.hxx>
+
+using namespace pivot::ecs;
+using namespace pivot::builtins::components;
+using namespace std::chrono_literals;
+
+namespace
+{
+const event::Description tick{
+    .name = "Tick",
+    .entities = {},
+    .payload = data::BasicType::Number,
+};
+
+const event::Description child{
+    .name = "Child",
+    .entities = {},
+    .payload = data::BasicType::String,
+};
+
+systems::Description makeSystem(std::string name, std::vector<std::string> read, std::vector<std::string> write,
+                                std::function<void()> work)
+{
+    std::vector<std::string> components = read;
+    components.insert(components.end(), write.begin(), write.end());
+    return {
+        .name = name,
+        .systemComponents = components,
+        .eventListener = tick,
+        .eventComponents = {},
+        .readComponents = read,
+        .writeComponents = write,
+        .system = [name, work](const systems::Description &, component::ArrayCombination &,
+                               const event::EventWithComponent &) -> std::vector<event::Event> {
+            work();
+            return {event::Event{child, {}, data::Value{name}}};
+        },
+    };
+}
+
+struct Fixture {
+    Fixture()
+    {
+        cManager.RegisterComponent(Tag::description);
+        cManager.RegisterComponent(RigidBody::description);
+        cManager.RegisterComponent(Gravity::description);
+        pool.start(4);
+    }
+
+    component::Manager cManager;
+    EntityManager eManager;
+    systems::Manager sManager{cManager, eManager};
+    pivot::ThreadPool pool;
+};
+
+std::vector<std::string> childNames(const std::pmr::vector<event::Event> &events)
+{
+    std::vector<std::string> names;
+    for (const auto &event: events) names.push_back(std::get<std::string>(event.payload));
+    return names;
+}
+}    // namespace
+
+TEST_CASE("Systems declare the components they read and write", "[system][description]")
+{
+    auto description = makeSystem("Valid", {"Tag"}, {"RigidBody"}, [] {});
+    REQUIRE(description.declaresAccess());
+    REQUIRE_NOTHROW(description.validate());
+
+    description.readComponents = {"Tag", "Gravity"};
+    REQUIRE_THROWS_WITH(description.validate(), "Access declared to component Gravity which is not used");
+    description.readComponents = {"Tag", "RigidBody"};
+    REQUIRE_THROWS_WITH(description.validate(), "Access to component RigidBody declared more than once");
+    description.readComponents = {};
+    REQUIRE_THROWS_WITH(description.validate(), "Missing access declaration for component Tag");
+    description.writeComponents = {};
+    REQUIRE_FALSE(description.declaresAccess());
+    REQUIRE_NOTHROW(description.validate());
+}
+
+TEST_CASE("Systems without conflicts run at the same time", "[system][scheduler]")
+{
+    Fixture fixture;
+    fixture.sManager.setThreadPool(&fixture.pool);
+
+    // Both readers wait until the other one started, which only happens if they overlap
+    std::atomic_int readersStarted = 0;
+    auto reader = [&] {
+        readersStarted++;
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (readersStarted < 2 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+    };
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](std::string name) {
+        return [&, name] {
+            std::scoped_lock lock(mutex);
+            order.push_back(name);
+        };
+    };
+    fixture.sManager.useSystem(makeSystem("A reader", {"Tag", "Gravity"}, {}, reader));
+    fixture.sManager.useSystem(makeSystem("B reader", {"Tag"}, {}, [&] {
+        reader();
+        record("B reader")();
+    }));
+    fixture.sManager.useSystem(makeSystem("C writer", {"Tag"}, {"RigidBody"}, record("C writer")));
+    fixture.sManager.useSystem(makeSystem("D writer", {"Gravity"}, {"RigidBody"}, record("D writer")));
+
+    const auto events = fixture.sManager.execute(event::Event{tick, {}, data::Value{0.1}});
+    REQUIRE(readersStarted == 2);
+    // Both writers write RigidBody, so they keep the name order
+    REQUIRE(std::ranges::find(order, "C writer") < std::ranges::find(order, "D writer"));
+    // Child events are in name order, whatever order the systems finished in
+    REQUIRE(childNames(events) == std::vector<std::string>{"A reader", "B reader", "C writer", "D writer"});
+}
+
+TEST_CASE("Writers and systems without declared access run alone", "[system][scheduler]")
+{
+    Fixture fixture;
+    fixture.sManager.setThreadPool(&fixture.pool);
+
+    std::atomic_int running = 0;
+    std::atomic_bool overlapped = false;
+    auto work = [&] {
+        if (running++ != 0) overlapped = true;
+        std::this_thread::sleep_for(2ms);
+        running--;
+    };
+    fixture.sManager.useSystem(makeSystem("Reader", {"RigidBody"}, {}, work));
+    fixture.sManager.useSystem(makeSystem("Writer", {}, {"RigidBody"}, work));
+    fixture.sManager.useSystem(makeSystem("Undeclared", {}, {}, work));
+
+    for (int i = 0; i < 10; i++) {
+        const auto events = fixture.sManager.execute(event::Event{tick, {}, data::Value{0.1}});
+        REQUIRE(childNames(events) == std::vector<std::string>{"Reader", "Undeclared", "Writer"});
+    }
+    REQUIRE_FALSE(overlapped);
+}
+
+TEST_CASE("Systems are stored in a dispatch table per event type", "[system][dispatch]")
+{
+    Fixture fixture;
+    REQUIRE_FALSE(fixture.sManager.getEventId("Tick").has_value());
+    // Nobody listens yet
+    REQUIRE(fixture.sManager.execute(event::Event{tick, {}, data::Value{0.1}}).empty());
+
+    fixture.sManager.useSystem(makeSystem("Ticked", {"Tag"}, {}, [] {}));
+    const auto tickId = fixture.sManager.getEventId("Tick");
+    REQUIRE(tickId.has_value());
+    const event::Event event{tick, {}, data::Value{0.1}};
+    REQUIRE(childNames(fixture.sManager.execute(tickId.value(), {&event, 1})) == std::vector<std::string>{"Ticked"});
+
+    // Names are resolved when the system is used
+    auto missing = makeSystem("Missing", {"Tag"}, {}, [] {});
+    missing.eventComponents = {{"Unknown"}};
+    REQUIRE_THROWS_AS(fixture.sManager.useSystem(missing), systems::Manager::MissingComponent);
+    REQUIRE_FALSE(fixture.sManager.hasSystem("Missing"));
+}
+
+TEST_CASE("System scheduler against serial execution", "[.][benchmark][system][scheduler]")
+{
+    constexpr int systemCount = 8;
+    constexpr int repeat = 20;
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    auto measure = [&](bool parallel, bool conflicting) {
+        Fixture fixture;
+        if (parallel) fixture.sManager.setThreadPool(&fixture.pool);
+        for (int i = 0; i < systemCount; i++) {
+            auto busy = [] {
+                const auto end = Clock::now() + 1ms;
+                while (Clock::now() < end) {}
+            };
+            std::vector<std::string> write;
+            if (conflicting) write.push_back("RigidBody");
+            fixture.sManager.useSystem(makeSystem("System " + std::to_string(i), {"Tag"}, write, busy));
+        }
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) fixture.sManager.execute(event::Event{tick, {}, data::Value{0.1}});
+        return Milliseconds(Clock::now() - start).count() / repeat;
+    };
+    std::cout << systemCount << " systems busy for 1ms, on a pool of 4 threads (ms per event):" << std::endl;
+    std::cout << "  serial: " << measure(false, false) << std::endl;
+    std::cout << "  scheduled, readers only: " << measure(true, false) << std::endl;
+    std::cout << "  scheduled, every system writes the same component: " << measure(true, true) << std::endl;
+}
+
+TEST_CASE("Event dispatch against the amount of systems", "[.][benchmark][system][dispatch]")
+{
+    constexpr int repeat = 100000;
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+    std::cout << "Dispatching an event listened by one system (ns per event):" << std::endl;
+    for (int systemCount: {1, 10, 100, 1000}) {
+        Fixture fixture;
+        for (int i = 0; i < systemCount; i++) {
+            auto description = makeSystem("System " + std::to_string(i), {"Tag"}, {}, [] {});
+            // Every other system listens to its own event
+            if (i != 0) description.eventListener.name = "Other " + std::to_string(i);
+            description.system = [](const systems::Description &, component::ArrayCombination &,
+                                    const event::EventWithComponent &) -> std::vector<event::Event> { return {}; };
+            fixture.sManager.useSystem(description);
+        }
+        const event::Event event{tick, {}, data::Value{0.1}};
+        const auto tickId = fixture.sManager.getEventId("Tick").value();
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) fixture.sManager.execute(tickId, {&event, 1});
+        std::cout << "  " << systemCount << " systems: " << Nanoseconds(Clock::now() - start).count() / repeat
+                  << std::endl;
+    }
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <unordered_map>
+
+#include <pivot/ecs/Core/EntityManager.hxx>
+
+TEST_CASE("Entity ids are allocated on demand and reused", "[entity]")
+{
+    EntityManager manager;
+    REQUIRE(manager.getLivingEntityCount() == 0);
+    REQUIRE_FALSE(manager.isAlive(0));
+
+    REQUIRE(manager.CreateEntity() == 0);
+    REQUIRE(manager.CreateEntity() == 1);
+    REQUIRE(manager.CreateEntity() == 2);
+    auto handle = manager.getHandle(1);
+
+    manager.SetSignature(1, Signature().set(3));
+    manager.DestroyEntity(1);
+    REQUIRE_FALSE(manager.isAlive(1));
+    REQUIRE_FALSE(manager.isAlive(handle));
+    REQUIRE(manager.GetSignature(1).none());
+    REQUIRE_THROWS_AS(manager.DestroyEntity(1), EcsException);
+    REQUIRE_THROWS_AS(manager.getHandle(1), EcsException);
+    // Destroyed entities keep their signature cleared
+    manager.SetSignature(1, Signature().set(3));
+    REQUIRE(manager.GetSignature(1).none());
+
+    // Destroyed ids are not reused right away
+    REQUIRE(manager.CreateEntity() == 3);
+    REQUIRE_FALSE(manager.isAlive(1));
+
+    // Then they are reused in the order they were destroyed
+    for (std::size_t i = 1; i < EntityManager::minimumFreeEntities; i++) manager.DestroyEntity(manager.CreateEntity());
+    REQUIRE(manager.CreateEntity() == 1);
+    manager.DestroyEntity(2);
+    REQUIRE(manager.CreateEntity() == 4);
+    REQUIRE(manager.GetSignature(1).none());
+    REQUIRE(manager.isAlive(1));
+    REQUIRE_FALSE(manager.isAlive(handle));
+    REQUIRE(manager.isAlive(manager.getHandle(1)));
+    REQUIRE(manager.getHandle(1).generation == handle.generation + 1);
+
+    manager.DestroyEntity(0);
+    std::vector<Entity> living(manager.getLivingEntities().begin(), manager.getLivingEntities().end());
+    std::ranges::sort(living);
+    REQUIRE(living == std::vector<Entity>{1, 3, 4});
+    REQUIRE(manager.getLivingEntityCount() == 3);
+    REQUIRE(manager.getEntities().size() == 3);
+}
+
+TEST_CASE("Entity managers have no fixed entity limit", "[entity]")
+{
+    EntityManager manager;
+    for (Entity i = 0; i < 600000; i++) manager.CreateEntity();
+    REQUIRE(manager.getLivingEntityCount() == 600000);
+    REQUIRE(manager.isAlive(599999));
+}
+
+TEST_CASE("Entity views see the living entities without copying them", "[entity]")
+{
+    static_assert(std::ranges::input_range<EntityManager::EntityView>);
+
+    EntityManager manager;
+    for (Entity i = 0; i < 6; i++) manager.SetSignature(manager.CreateEntity(), Signature().set(i));
+    manager.DestroyEntity(2);
+    auto view = manager.getEntities();
+    REQUIRE(view.size() == 5);
+
+    std::vector<Entity> visited;
+    for (auto [entity, signature]: view) {
+        visited.push_back(entity);
+        REQUIRE(signature == Signature().set(entity));
+        // Entities can be created and destroyed while iterating
+        if (entity == 3) {
+            manager.DestroyEntity(5);
+            manager.DestroyEntity(1);
+            // Created after the current entity, so it is visited
+            REQUIRE(manager.CreateEntity() == 6);
+            manager.SetSignature(6, Signature().set(6));
+        }
+    }
+    REQUIRE(visited == std::vector<Entity>{0, 1, 3, 4, 6});
+    REQUIRE(view.size() == 4);
+}
+
+TEST_CASE("Entity allocator throughput", "[.][benchmark][entity]")
+{
+    constexpr Entity entityCount = 100000;
+    constexpr int repeat = 20;
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    // The previous allocator filled a queue with every id up front
+    auto start = Clock::now();
+    for (int i = 0; i < repeat; i++) {
+        std::queue<Entity> available;
+        for (Entity entity = 0; entity < 500000; entity++) available.push(entity);
+        REQUIRE(available.size() == 500000);
+    }
+    std::cout << "Construction, queue of 500k ids: " << Milliseconds(Clock::now() - start).count() / repeat << "ms"
+              << std::endl;
+    start = Clock::now();
+    for (int i = 0; i < repeat; i++) {
+        EntityManager manager;
+        REQUIRE(manager.getLivingEntityCount() == 0);
+    }
+    std::cout << "Construction, generational allocator: " << Milliseconds(Clock::now() - start).count() / repeat
+              << "ms" << std::endl;
+
+    EntityManager manager;
+    start = Clock::now();
+    for (int i = 0; i < repeat; i++) {
+        for (Entity entity = 0; entity < entityCount; entity++) manager.CreateEntity();
+        // Destroyed out of creation order, so that the living entities are moved around
+        for (Entity entity = 0; entity < entityCount; entity += 2) manager.DestroyEntity(entity);
+        for (Entity entity = 1; entity < entityCount; entity += 2) manager.DestroyEntity(entity);
+    }
+    const auto duration = Milliseconds(Clock::now() - start).count() / repeat;
+    std::cout << "Create and destroy " << entityCount << " entities: " << duration << "ms ("
+              << duration * 1e6 / (2 * entityCount) << "ns per operation)" << std::endl;
+}
+
+TEST_CASE("Entity view against a copied map", "[.][benchmark][entity]")
+{
+    constexpr Entity entityCount = 100000;
+    constexpr int repeat = 100;
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    EntityManager manager;
+    for (Entity i = 0; i < entityCount; i++) manager.SetSignature(manager.CreateEntity(), Signature().set(i % 8));
+    for (Entity entity = 0; entity < entityCount; entity += 10) manager.DestroyEntity(entity);
+
+    auto measure = [&](const char *name, auto &&frame) {
+        std::size_t sum = 0;
+        const auto start = Clock::now();
+        for (int i = 0; i < repeat; i++) sum += frame();
+        std::cout << "  " << name << ": " << Milliseconds(Clock::now() - start).count() / repeat << "ms per frame ("
+                  << sum / repeat << ")" << std::endl;
+    };
+    std::cout << "Iterating " << manager.getLivingEntityCount() << " entities:" << std::endl;
+    // What getEntities used to do every frame
+    measure("copied unordered_map", [&] {
+        std::unordered_map<Entity, Signature> entities;
+        for (auto [entity, signature]: manager.getEntities()) entities.emplace(entity, signature);
+        std::size_t sum = 0;
+        for (auto &[entity, signature]: entities) sum += signature.count();
+        return sum;
+    });
+    measure("entity view", [&] {
+        std::size_t sum = 0;
+        for (auto [entity, signature]: manager.getEntities()) sum += signature.count();
+        return sum;
+    });
+}
@@ -131,6 +131,7 @@ public:
         auto *mapped = mapMemory<T>(buffer);
         std::memcpy(mapped + offset, data, data_size);
         unmapMemory(buffer);
+        PROFILE_COUNTER("Bytes uploaded", data_size);
     }
 
     template <BufferValid T>
@@ -25,7 +25,7 @@ struct Object {
     /// The array of component
     std::reference_wrapper<const std::vector<T>> objects;
     /// Indicate which entities have the component
-    std::reference_wrapper<const std::vector<bool>> exist;
+    std::reference_wrapper<const pivot::ecs::component::EntityBitmap> exist;
 };
 
 /// Informations needed to draw a scene. Including all objects and al lights
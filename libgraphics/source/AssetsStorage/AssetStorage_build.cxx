@@ -17,7 +17,9 @@ batch_load(const std::unordered_map<std::string, std::filesystem::path> &storage
     futures.reserve(storage_map.size());
 
     /// Model must be loaded first, as they may add new texture to load
-    for (const auto &i: storage_map) futures.emplace_back(i.second, threadPool.push(load, i.second));
+    /// Loading can take seconds, it must not delay the frame work of the pool
+    for (const auto &i: storage_map)
+        futures.emplace_back(i.second, threadPool.push(ThreadPool::Lane::Background, load, i.second));
     for (auto &[name, f]: futures) {
         auto storage = f.get();
         if (!storage.has_value())
@@ -153,7 +155,7 @@ void AssetStorage::pushTexturesOnGPU()
         logger.warn("Asset Storage") << "No textures to push";
         return;
     }
-    for (auto &[name, idx]: cpuStorage.textureStaging) {
+    for (const auto &[name, idx]: cpuStorage.textureStaging) {
         auto &img = cpuStorage.textureStaging.get(idx);
         auto stagingBuffer = base_ref->get().allocator.createBuffer<std::byte>(
             img.image.size(), vk::BufferUsageFlagBits::eTransferSrc, vma::MemoryUsage::eCpuToGpu);
@@ -196,7 +198,7 @@ void AssetStorage::pushMaterialOnGPU()
         logger.warn("Asset Storage") << "No material to push";
         return;
     }
-    for (auto &[name, idx]: cpuStorage.materialStaging) {
+    for (const auto &[name, idx]: cpuStorage.materialStaging) {
         const auto &mat = cpuStorage.materialStaging.getStorage()[idx];
         materialStorage.add(
             name,
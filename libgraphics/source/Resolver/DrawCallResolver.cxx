@@ -3,6 +3,7 @@
 #include "pivot/graphics/types/UniformBufferObject.hxx"
 #include "pivot/graphics/vk_debug.hxx"
 #include "pivot/graphics/vk_utils.hxx"
+#include "pivot/memory/FrameArena.hxx"
 #include "pivot/pivot.hxx"
 
 namespace pivot::graphics
@@ -46,7 +47,7 @@ bool DrawCallResolver::destroy(VulkanBase &)
 bool DrawCallResolver::prepareForDraw(const DrawSceneInformation &sceneInformation)
 {
     PROFILE_FUNCTION();
-    std::vector<gpu_object::UniformBufferObject> objectGPUData;
+    std::pmr::vector<gpu_object::UniformBufferObject> objectGPUData(memory::FrameArena::get());
     std::uint32_t drawCount = 0;
 
     frame.packedDraws.clear();
@@ -55,10 +56,10 @@ bool DrawCallResolver::prepareForDraw(const DrawSceneInformation &sceneInformati
     std::scoped_lock lock(sceneInformation.renderObjects.getMutex(), sceneInformation.transform.getMutex());
 
     const std::vector<RenderObject> &renderObjects = sceneInformation.renderObjects.getComponents();
-    const std::vector<bool> &renderObjects_exist = sceneInformation.renderObjects.getExistence();
+    const ecs::component::EntityBitmap &renderObjects_exist = sceneInformation.renderObjects.getExistence();
 
     const std::vector<Transform> &transforms = sceneInformation.transform.getComponents();
-    const std::vector<bool> &transforms_exist = sceneInformation.transform.getExistence();
+    const ecs::component::EntityBitmap &transforms_exist = sceneInformation.transform.getExistence();
 
     for (unsigned i = 0; i < renderObjects.size() && i < transforms.size(); i++) {
         if (!renderObjects_exist.at(i) || !transforms_exist.at(i)) continue;
@@ -103,6 +104,7 @@ bool DrawCallResolver::prepareForDraw(const DrawSceneInformation &sceneInformati
     }
     pivotAssertMsg(frame.packedDraws.size() == objectGPUData.size(),
                    "Incorrect size between draw call and buffer data");
+    PROFILE_GAUGE("Draw calls", frame.packedDraws.size());
     if (objectGPUData.empty()) return true;
     if (objectGPUData.size() > frame.currentBufferSize || objectGPUData.size() < frame.currentBufferSize / 2) {
         createBuffer(objectGPUData.size());
@@ -3,6 +3,7 @@
 #include "pivot/graphics/types/UniformBufferObject.hxx"
 #include "pivot/graphics/vk_debug.hxx"
 #include "pivot/graphics/vk_utils.hxx"
+#include "pivot/memory/FrameArena.hxx"
 #include "pivot/pivot.hxx"
 
 namespace pivot::graphics
@@ -55,7 +56,7 @@ static vk::DeviceSize handleLights(VulkanBase &base_ref, AllocatedBuffer<G> &buf
     verifyMsg(lights.objects.get().size() == lights.exist.get().size(), "Light ECS data are incorrect");
     verifyMsg(transforms.objects.get().size() == transforms.exist.get().size(), "Transform ECS data are incorrect");
 
-    std::vector<G> lightsData;
+    std::pmr::vector<G> lightsData(memory::FrameArena::get());
     for (unsigned i = 0; i < lights.objects.get().size() && i < transforms.objects.get().size(); i++) {
         if (!lights.exist.get().at(i) || !lights.exist.get().at(i)) continue;
         const auto &light = lights.objects.get().at(i);
@@ -80,16 +81,16 @@ bool LightDataResolver::prepareForDraw(const DrawSceneInformation &sceneInformat
                           sceneInformation.spotLight.getMutex(), sceneInformation.transform.getMutex());
 
     const std::vector<PointLight> &pointLight = sceneInformation.pointLight.getComponents();
-    const std::vector<bool> &pointLight_exist = sceneInformation.pointLight.getExistence();
+    const ecs::component::EntityBitmap &pointLight_exist = sceneInformation.pointLight.getExistence();
 
     const std::vector<DirectionalLight> &directionalLight = sceneInformation.directionalLight.getComponents();
-    const std::vector<bool> &directionalLight_exist = sceneInformation.directionalLight.getExistence();
+    const ecs::component::EntityBitmap &directionalLight_exist = sceneInformation.directionalLight.getExistence();
 
     const std::vector<SpotLight> &spotLight = sceneInformation.spotLight.getComponents();
-    const std::vector<bool> &spotLight_exist = sceneInformation.spotLight.getExistence();
+    const ecs::component::EntityBitmap &spotLight_exist = sceneInformation.spotLight.getExistence();
 
     const std::vector<Transform> &transforms = sceneInformation.transform.getComponents();
-    const std::vector<bool> &transforms_exist = sceneInformation.transform.getExistence();
+    const ecs::component::EntityBitmap &transforms_exist = sceneInformation.transform.getExistence();
 
     // verifyMsg(sceneInformation.pointLight.objects.get().size() == sceneInformation.pointLight.exist.get().size(),
     //           "ECS Point tights arrays are invalid.");
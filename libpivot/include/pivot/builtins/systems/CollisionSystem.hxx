@@ -5,7 +5,8 @@
 
 namespace pivot::builtins::systems
 {
-const pivot::ecs::systems::Description makeCollisionSystem(const pivot::graphics::AssetStorage &assetStorage);
+const pivot::ecs::systems::Description makeCollisionSystem(const pivot::graphics::AssetStorage &assetStorage,
+                                                          ThreadPool &threadPool);
 
 namespace details
 {
@@ -16,6 +17,8 @@ namespace details
         Entity entity;
     };
 
-    std::vector<std::pair<Entity, Entity>> getEntityCollisions(std::span<const EntityAABB> entityAABB);
+    /// Returns the pairs of colliding boxes, in the order of entityAABB. The boxes are tested in parallel on the pool.
+    std::vector<std::pair<Entity, Entity>> getEntityCollisions(std::span<const EntityAABB> entityAABB,
+                                                               ThreadPool *threadPool = nullptr);
 }    // namespace details
 }    // namespace pivot::builtins::systems
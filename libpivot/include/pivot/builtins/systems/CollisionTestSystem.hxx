@@ -11,6 +11,7 @@ inline const pivot::ecs::systems::Description collisionTestSystem{
     .systemComponents = {"Transform"},
     .eventListener = events::collision,
     .eventComponents = {{}, {}},
+    .readComponents = {"Transform"},
     .provenance = ecs::Provenance::builtin(),
     .system = [](const pivot::ecs::systems::Description &, pivot::ecs::component::ArrayCombination &,
                  const pivot::ecs::event::EventWithComponent &) -> std::vector<pivot::ecs::event::Event> {
@@ -1,8 +1,9 @@
 #pragma once
 
+#include <pivot/Threading/ThreadPool.hxx>
 #include <pivot/ecs/Core/Systems/description.hxx>
 
 namespace pivot::builtins::systems
 {
-extern const pivot::ecs::systems::Description physicSystem;
+const pivot::ecs::systems::Description makePhysicSystem(ThreadPool &threadPool);
 }
@@ -1,5 +1,7 @@
 #include <csignal>
 
+#include <pivot/Threading/ParallelAlgorithms.hxx>
+
 #include <pivot/graphics/types/RenderObject.hxx>
 #include <pivot/graphics/types/TransformArray.hxx>
 
@@ -17,12 +19,30 @@ using Prefab = pivot::graphics::asset::Prefab;
 
 namespace
 {
+/// Call f(begin, end, output) on chunks of [0, count) in parallel, and concatenate the outputs in the chunk order
+template <typename T, typename F>
+std::vector<T> parallelCollect(pivot::ThreadPool *threadPool, std::size_t count, std::size_t grain, F &&f)
+{
+    std::vector<T> result;
+    if (!threadPool) {
+        f(0, count, result);
+        return result;
+    }
+    std::vector<std::vector<T>> chunks((count + grain - 1) / grain);
+    pivot::parallel_for_chunks(
+        *threadPool, 0, count, [&](std::size_t begin, std::size_t end) { f(begin, end, chunks[begin / grain]); },
+        grain);
+    for (auto &chunk: chunks) result.insert(result.end(), chunk.begin(), chunk.end());
+    return result;
+}
+
 std::vector<event::Event> collisionSystemImpl(std::reference_wrapper<const pivot::graphics::AssetStorage> assetStorage,
+                                              std::reference_wrapper<pivot::ThreadPool> threadPool,
                                               const systems::Description &, component::ArrayCombination &cmb,
                                               const event::EventWithComponent &)
 {
     logger.trace() << "Collision system run";
-    auto collidableStorage = dynamic_cast<const component::FlagComponentStorage &>(cmb.arrays()[0].get());
+    const auto &collidableStorage = dynamic_cast<const component::FlagComponentStorage &>(cmb.arrays()[0].get());
     const auto &transformArray = dynamic_cast<pivot::graphics::SynchronizedTransformArray &>(cmb.arrays()[1].get());
     const auto &renderObjectArray =
         dynamic_cast<component::SynchronizedTypedComponentArray<pivot::graphics::RenderObject> &>(
@@ -31,24 +51,28 @@ std::vector<event::Event> collisionSystemImpl(std::reference_wrapper<const pivot
 
     auto transformData = transformArray.getData();
     auto renderObjectData = renderObjectArray.getData();
-
-    std::vector<EntityAABB> entityAABB;
-
-    for (Entity entity: collidableStorage.getData()) {
-        logger.trace() << "Retrieving AABB for entity " << entity;
-        glm::vec3 position = transformData[entity].position;
-        auto &prefab_name = renderObjectData[entity].meshID;
-        auto prefab = assetStorage.get().get_optional<Prefab>(prefab_name);
-        if (!prefab.has_value()) continue;
-        auto bounding_box = assetStorage.get().get_optional<AABB>(prefab.value().get().modelIds.at(0));
-        if (bounding_box.has_value()) {
-            entityAABB.emplace_back(bounding_box->get().low + position, bounding_box->get().high + position, entity);
-        }
-    }
+    auto collidables = collidableStorage.getData();
+
+    constexpr std::size_t gatherGrain = 256;
+    auto entityAABB = parallelCollect<EntityAABB>(
+        &threadPool.get(), collidables.size(), gatherGrain,
+        [&](std::size_t begin, std::size_t end, std::vector<EntityAABB> &output) {
+            for (Entity entity: collidables.subspan(begin, end - begin)) {
+                glm::vec3 position = transformData[entity].position;
+                auto &prefab_name = renderObjectData[entity].meshID;
+                auto prefab = assetStorage.get().get_optional<Prefab>(prefab_name);
+                if (!prefab.has_value()) continue;
+                auto bounding_box = assetStorage.get().get_optional<AABB>(prefab.value().get().modelIds.at(0));
+                if (bounding_box.has_value()) {
+                    output.emplace_back(bounding_box->get().low + position, bounding_box->get().high + position,
+                                        entity);
+                }
+            }
+        });
 
     logger.trace() << "Collisions between " << entityAABB.size() << " entities with AABB";
 
-    auto collisions = getEntityCollisions(entityAABB);
+    auto collisions = getEntityCollisions(entityAABB, &threadPool.get());
     std::vector<event::Event> collision_events{};
 
     for (auto [entity1, entity2]: collisions) {
@@ -68,33 +92,38 @@ namespace pivot::builtins::systems
 namespace details
 {
 
-    std::vector<std::pair<Entity, Entity>> getEntityCollisions(std::span<const EntityAABB> entityAABB)
+    std::vector<std::pair<Entity, Entity>> getEntityCollisions(std::span<const EntityAABB> entityAABB,
+                                                               ThreadPool *threadPool)
     {
-        std::vector<std::pair<Entity, Entity>> collisions;
-
-        for (std::size_t i = 0; i < entityAABB.size(); i++) {
-            auto &box1 = entityAABB[i];
-            for (auto &box2: entityAABB.subspan(i)) {
-                if (box1.entity == box2.entity) continue;
-                float d1x = box2.low.x - box1.high.x;
-                float d1y = box2.low.y - box1.high.y;
-                float d1z = box2.low.z - box1.high.z;
-                float d2x = box1.low.x - box2.high.x;
-                float d2y = box1.low.y - box2.high.y;
-                float d2z = box1.low.z - box2.high.z;
-
-                if (d1x > 0.0f || d1y > 0.0f || d1z > 0.0f) continue;
-                if (d2x > 0.0f || d2y > 0.0f || d2z > 0.0f) continue;
-
-                collisions.emplace_back(box1.entity, box2.entity);
-            }
-        }
-        return collisions;
+        // The first boxes are tested against more boxes, small chunks keep the threads balanced
+        constexpr std::size_t grain = 16;
+        return parallelCollect<std::pair<Entity, Entity>>(
+            threadPool, entityAABB.size(), grain,
+            [&](std::size_t begin, std::size_t end, std::vector<std::pair<Entity, Entity>> &collisions) {
+                for (std::size_t i = begin; i < end; i++) {
+                    auto &box1 = entityAABB[i];
+                    for (auto &box2: entityAABB.subspan(i)) {
+                        if (box1.entity == box2.entity) continue;
+                        float d1x = box2.low.x - box1.high.x;
+                        float d1y = box2.low.y - box1.high.y;
+                        float d1z = box2.low.z - box1.high.z;
+                        float d2x = box1.low.x - box2.high.x;
+                        float d2y = box1.low.y - box2.high.y;
+                        float d2z = box1.low.z - box2.high.z;
+
+                        if (d1x > 0.0f || d1y > 0.0f || d1z > 0.0f) continue;
+                        if (d2x > 0.0f || d2y > 0.0f || d2z > 0.0f) continue;
+
+                        collisions.emplace_back(box1.entity, box2.entity);
+                    }
+                }
+            });
     }
 
 }    // namespace details
 
-const pivot::ecs::systems::Description makeCollisionSystem(const pivot::graphics::AssetStorage &assetStorage)
+const pivot::ecs::systems::Description makeCollisionSystem(const pivot::graphics::AssetStorage &assetStorage,
+                                                          ThreadPool &threadPool)
 {
     return pivot::ecs::systems::Description{
         .name = "Collision System",
@@ -107,8 +136,9 @@ const pivot::ecs::systems::Description makeCollisionSystem(const pivot::graphics
             },
         .eventListener = events::tick,
         .eventComponents = {},
+        .readComponents = {"Collidable", "Transform", "RenderObject"},
         .provenance = pivot::ecs::Provenance::builtin(),
-        .system = std::bind_front(collisionSystemImpl, std::cref(assetStorage)),
+        .system = std::bind_front(collisionSystemImpl, std::cref(assetStorage), std::ref(threadPool)),
     };
 }
 }    // namespace pivot::builtins::systems
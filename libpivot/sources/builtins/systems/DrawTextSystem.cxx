@@ -3,8 +3,7 @@
 
 #include <pivot/builtins/events/editor_tick.hxx>
 #include <pivot/builtins/systems/DrawTextSystem.hxx>
-#include <pivot/ecs/Core/Component/DenseComponentArray.hxx>
-#include <pivot/ecs/Core/Component/SynchronizedComponentArray.hxx>
+#include <pivot/ecs/Core/Component/view.hxx>
 
 #include <pivot/builtins/components/Text.hxx>
 #include <pivot/builtins/components/Transform2D.hxx>
@@ -37,17 +36,7 @@ std::vector<event::Event> drawTextSystemImpl(const systems::Description &, compo
                                              [[maybe_unused]] const event::EventWithComponent &event)
 {
     PROFILE_FUNCTION();
-    const auto &textArray = dynamic_cast<component::DenseTypedComponentArray<Text> &>(cmb.arrays()[0].get());
-    const auto &transformArray =
-        dynamic_cast<component::DenseTypedComponentArray<Transform2D> &>(cmb.arrays()[1].get());
-
-    auto maxEntity = std::min({textArray.maxEntity(), transformArray.maxEntity()});
-    for (std::size_t entity = 0; entity < maxEntity; entity++) {
-        if (!textArray.entityHasValue(entity) || !transformArray.entityHasValue(entity)) continue;
-
-        auto &text = textArray.getData()[entity];
-        auto &transform = transformArray.getData()[entity];
-
+    for (auto [entity, text, transform]: component::View<const Text, const Transform2D>(cmb)) {
         drawText(entity, text, transform);
     }
     return {};
@@ -67,6 +56,7 @@ const pivot::ecs::systems::Description drawTextSystem{
         },
     .eventListener = events::editor_tick,
     .eventComponents = {},
+    .readComponents = {"Text", "Transform2D"},
     .provenance = pivot::ecs::Provenance::builtin(),
     .system = &drawTextSystemImpl,
 
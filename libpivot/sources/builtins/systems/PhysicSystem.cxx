@@ -3,6 +3,7 @@
 
 #include <pivot/ecs/Core/Component/DenseComponentArray.hxx>
 #include <pivot/ecs/Core/Component/SynchronizedComponentArray.hxx>
+#include <pivot/ecs/Core/Component/parallel.hxx>
 #include <pivot/graphics/types/TransformArray.hxx>
 
 #include <pivot/ecs/Components/Gravity.hxx>
@@ -15,29 +16,33 @@ using namespace pivot::builtins::components;
 
 namespace
 {
-std::vector<event::Event> physicsSystemImpl(const systems::Description &, component::ArrayCombination &cmb,
+std::vector<event::Event> physicsSystemImpl(std::reference_wrapper<pivot::ThreadPool> threadPool,
+                                            const systems::Description &, component::ArrayCombination &cmb,
                                             const event::EventWithComponent &event)
 {
     PROFILE_FUNCTION();
     auto dt = (float)std::get<double>(event.event.payload);
 
-    auto gravityArray = dynamic_cast<component::DenseTypedComponentArray<Gravity> &>(cmb.arrays()[0].get()).getData();
-    auto rigidBodyArray =
-        dynamic_cast<component::DenseTypedComponentArray<RigidBody> &>(cmb.arrays()[1].get()).getData();
+    auto &gravityArray = dynamic_cast<component::DenseTypedComponentArray<Gravity> &>(cmb.arrays()[0].get());
+    auto &rigidBodyArray = dynamic_cast<component::DenseTypedComponentArray<RigidBody> &>(cmb.arrays()[1].get());
     auto &transformArray = dynamic_cast<pivot::graphics::SynchronizedTransformArray &>(cmb.arrays()[2].get());
     auto transform_array_lock = transformArray.lock();
+    auto gravityData = gravityArray.getData();
+    auto rigidBodyData = rigidBodyArray.getData();
     auto transformData = transformArray.getData();
 
-    auto maxEntity = std::min({gravityArray.size(), rigidBodyArray.size(), transformData.size()});
-    for (std::size_t entity = 0; entity < maxEntity; entity++) {
-        auto &gravity = gravityArray[entity];
-        auto &rigidBody = rigidBodyArray[entity];
-        auto &transform = transformData[entity];
+    component::parallelForEach(
+        &threadPool.get(),
+        {gravityArray.getExistence(), rigidBodyArray.getExistence(), transformArray.getExistence()},
+        [&](Entity entity) {
+            auto &gravity = gravityData[entity];
+            auto &rigidBody = rigidBodyData[entity];
+            auto &transform = transformData[entity];
 
-        if (gravity.force != glm::vec3(0)) { rigidBody.acceleration = gravity.force; }
-        rigidBody.velocity += rigidBody.acceleration * dt;
-        transform.position += rigidBody.velocity * dt;
-    }
+            if (gravity.force != glm::vec3(0)) { rigidBody.acceleration = gravity.force; }
+            rigidBody.velocity += rigidBody.acceleration * dt;
+            transform.position += rigidBody.velocity * dt;
+        });
     return {};
 }
 }    // namespace
@@ -45,19 +50,23 @@ std::vector<event::Event> physicsSystemImpl(const systems::Description &, compon
 namespace pivot::builtins::systems
 {
 
-const pivot::ecs::systems::Description physicSystem{
-    .name = "Physics System",
-    .entityName = "",
-    .systemComponents =
-        {
-            "Gravity",
-            "RigidBody",
-            "Transform",
-        },
-    .eventListener = events::tick,
-    .eventComponents = {},
-    .provenance = pivot::ecs::Provenance::builtin(),
-    .system = &physicsSystemImpl,
-
-};
+const pivot::ecs::systems::Description makePhysicSystem(ThreadPool &threadPool)
+{
+    return pivot::ecs::systems::Description{
+        .name = "Physics System",
+        .entityName = "",
+        .systemComponents =
+            {
+                "Gravity",
+                "RigidBody",
+                "Transform",
+            },
+        .eventListener = events::tick,
+        .eventComponents = {},
+        .readComponents = {"Gravity"},
+        .writeComponents = {"RigidBody", "Transform"},
+        .provenance = pivot::ecs::Provenance::builtin(),
+        .system = std::bind_front(physicsSystemImpl, std::ref(threadPool)),
+    };
 }
+}    // namespace pivot::builtins::systems
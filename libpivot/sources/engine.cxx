@@ -12,9 +12,11 @@
 #include <pivot/engine.hxx>
 
 #include <pivot/internal/FrameLimiter.hxx>
+#include <pivot/memory/FrameArena.hxx>
 
 #include <pivot/ecs/Components/Gravity.hxx>
 #include <pivot/ecs/Components/RigidBody.hxx>
+#include <pivot/ecs/Core/BinaryScene.hxx>
 
 #include <pivot/builtins/events/collision.hxx>
 #include <pivot/builtins/events/editor_tick.hxx>
@@ -100,8 +102,9 @@ Engine::Engine()
     m_event_index.registerEvent(builtins::events::editor_tick);
     m_event_index.registerEvent(builtins::events::keyPress);
     m_event_index.registerEvent(builtins::events::collision);
-    m_system_index.registerSystem(builtins::systems::physicSystem);
-    m_system_index.registerSystem(builtins::systems::makeCollisionSystem(m_vulkan_application.assetStorage));
+    m_system_index.registerSystem(builtins::systems::makePhysicSystem(m_vulkan_application.threadPool));
+    m_system_index.registerSystem(builtins::systems::makeCollisionSystem(m_vulkan_application.assetStorage,
+                                                                         m_vulkan_application.threadPool));
     m_system_index.registerSystem(builtins::systems::collisionTestSystem);
     m_system_index.registerSystem(builtins::systems::testTickSystem);
     m_system_index.registerSystem(builtins::systems::drawTextSystem);
@@ -165,6 +168,8 @@ void Engine::run()
         fpsLimiter.sleep();
         auto stopTime = std::chrono::high_resolution_clock::now();
         dt = std::chrono::duration<float>(stopTime - startTime).count();
+        PROFILE_FRAME();
+        pivot::memory::FrameArena::nextFrame();
     }
 }
 
@@ -218,9 +223,10 @@ void Engine::changeCurrentScene(ecs::SceneManager::SceneId sceneId)
 
 namespace
 {
-    void postSceneRegister(Scene &scene)
+    void postSceneRegister(Scene &scene, ThreadPool &threadPool)
     {
         DEBUG_FUNCTION();
+        scene.setThreadPool(&threadPool);
         auto &cm = scene.getComponentManager();
         if (!cm.GetComponentId(builtins::components::RenderObject::description.name).has_value()) {
             cm.RegisterComponent(builtins::components::RenderObject::description);
@@ -247,7 +253,7 @@ ecs::SceneManager::SceneId Engine::registerScene()
 {
     DEBUG_FUNCTION();
     auto id = m_scene_manager.registerScene();
-    postSceneRegister(m_scene_manager.getSceneById(id));
+    postSceneRegister(m_scene_manager.getSceneById(id), m_vulkan_application.threadPool);
     return id;
 }
 
@@ -255,7 +261,7 @@ ecs::SceneManager::SceneId Engine::registerScene(std::string name)
 {
     DEBUG_FUNCTION();
     auto id = m_scene_manager.registerScene(name);
-    postSceneRegister(m_scene_manager.getSceneById(id));
+    postSceneRegister(m_scene_manager.getSceneById(id), m_vulkan_application.threadPool);
     return id;
 }
 
@@ -263,7 +269,7 @@ ecs::SceneManager::SceneId Engine::registerScene(std::unique_ptr<ecs::Scene> sce
 {
     DEBUG_FUNCTION();
     auto id = m_scene_manager.registerScene(std::move(scene));
-    postSceneRegister(m_scene_manager.getSceneById(id));
+    postSceneRegister(m_scene_manager.getSceneById(id), m_vulkan_application.threadPool);
     return id;
 }
 
@@ -271,7 +277,7 @@ void Engine::resetScene(ecs::SceneManager::SceneId id, const nlohmann::json &jso
 {
     auto scene = Scene::load(json, m_component_index, m_system_index);
     m_scene_manager.resetScene(id, std::move(scene));
-    postSceneRegister(m_scene_manager.getSceneById(id));
+    postSceneRegister(m_scene_manager.getSceneById(id), m_vulkan_application.threadPool);
     changeCurrentScene(id);
 }
 
@@ -294,28 +300,43 @@ void Engine::saveScene(ecs::SceneManager::SceneId id, const std::filesystem::pat
             return std::filesystem::relative(std::filesystem::absolute(scriptPath), path.parent_path()).string();
         }));
 
-    m_scene_manager.getSceneById(id).save(path, assetTranslator, scriptTranslator);
+    auto &scene = m_scene_manager.getSceneById(id);
+    if (path.extension() == ecs::BinaryScene::extension)
+        scene.saveBinary(path, assetTranslator, scriptTranslator);
+    else
+        scene.save(path, assetTranslator, scriptTranslator);
 }
 
 ecs::SceneManager::SceneId Engine::loadScene(const std::filesystem::path &path)
 {
     DEBUG_FUNCTION();
     logger.info("Scene Manager") << "Loading scene at " << path;
+    auto scene_base_path = path.parent_path();
+    auto loadResources = [&](const std::vector<std::string> &scripts, const std::vector<std::string> &assets) {
+        for (auto &script: scripts) {
+            auto scriptPath = scene_base_path / script;
+            m_scripting_engine.loadFile(scriptPath.string(), false, true);
+        }
+        m_vulkan_application.assetStorage.setAssetDirectory(scene_base_path);
+        for (auto &asset: assets) loadAsset(asset, false);
+        m_vulkan_application.buildAssetStorage(graphics::AssetStorage::BuildFlagBits::eReloadOldAssets);
+    };
+    if (ecs::BinaryScene::isBinaryScene(path)) {
+        ecs::BinaryScene binary(path);
+        loadResources(binary.getScripts(), binary.getAssets());
+        return this->registerScene(binary.load(m_component_index, m_system_index));
+    }
     std::ifstream scene_file{path};
     if (!scene_file.is_open()) {
         logger.err() << "Could not open scene file: " << std::strerror(errno);
         return 1;
     }
-    auto scene_json = nlohmann::json::parse(scene_file);
-    auto scene_base_path = path.parent_path();
-    for (auto &script: scene_json["scripts"]) {
-        auto scriptPath = scene_base_path / script.get<std::string>();
-        m_scripting_engine.loadFile(scriptPath.string(), false, true);
-    }
-    m_vulkan_application.assetStorage.setAssetDirectory(scene_base_path);
-    for (auto &asset: scene_json["assets"]) loadAsset(asset.get<std::string>(), false);
-    m_vulkan_application.buildAssetStorage(graphics::AssetStorage::BuildFlagBits::eReloadOldAssets);
-    auto scene = Scene::load(scene_json, m_component_index, m_system_index);
+    // The scripts register components which must be known before streaming the scene
+    auto resources = Scene::readResources(scene_file);
+    loadResources(resources.scripts, resources.assets);
+    scene_file.clear();
+    scene_file.seekg(0);
+    auto scene = Scene::loadStream(scene_file, m_component_index, m_system_index);
     return this->registerScene(std::move(scene));
 }
 
@@ -345,7 +366,8 @@ bool Engine::isKeyPressed(const std::string &key) const
 void Engine::onKeyPressed(graphics::Window &, const graphics::Window::Key key, const graphics::Window::Modifier)
 {
     if (!m_paused) {
-        m_scene_manager.getCurrentScene().getEventManager().sendEvent(
+        // Dispatched with the next editor tick
+        m_scene_manager.getCurrentScene().getEventManager().queueEvent(
             {pivot::builtins::events::keyPress, {}, data::Value(std::string(magic_enum::enum_name(key)))});
     }
 }
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <span>
 #include <vector>
 
 #include "pivot/ecs/Core/Data/value.hxx"
@@ -47,7 +48,7 @@ data::Value builtin_isPressed(const std::vector<data::Value> &params, const Buil
 data::Value builtin_print(const std::vector<data::Value> &params, const BuiltinContext &context);
 
 /// Same as above but take a ostream to write to
-data::Value builtin_print_stream(const std::vector<data::Value> &params, std::ostream &stream);
+data::Value builtin_print_stream(std::span<const data::Value> params, std::ostream &stream);
 
 // Math built-ins
 /// Number cos(Number radAngle)
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <functional>
+#include <map>
+#include <memory_resource>
 #include <span>
 #include <unordered_map>
 
 #include <pivot/ecs/Core/Component/ref.hxx>
 #include <pivot/ecs/Core/Data/value.hxx>
+#include <pivot/memory/PoolResource.hxx>
 
 namespace pivot::ecs::script::interpreter
 {
@@ -29,7 +32,7 @@ public:
     /// Update an entity components from its value on the stack
     void updateEntity(const std::string &entityName, std::span<component::ComponentRef>);
     /// Find a variable in the stack (read-only), name can contain access ('.')
-    const data::Value find(const std::string &name) const;
+    data::Value find(const std::string &name) const;
     /// Modify the value of a variable in the stack, by name, name can contain access ('.')
     void setValue(const std::string &name, const data::Value &newVal);
 
@@ -55,11 +58,13 @@ public:
     const std::vector<EventToEmit> &getEventsToEmit() const { return _eventsToEmit; }
 
 private:
-    data::Record _stack;    /// name to variable
+    memory::PoolResource _pool;    /// recycle the nodes of the variables, as the stack is cleared for every entity
+    std::pmr::map<std::string, data::Value> _stack;    /// name to variable
 
-    bool setVectorValue(const std::string &name, const data::Value &newVal, data::Record &where);
-    data::Value &findMut(const std::string &name, data::Record &where);
-    const data::Value find(const std::string &name, const data::Record &where) const;
+    template <typename Map>
+    void setValue(const std::string &name, const data::Value &newVal, Map &where);
+    template <typename Map>
+    data::Value find(const std::string &name, const Map &where) const;
 
     std::vector<EventToEmit> _eventsToEmit;
 };
@@ -26,7 +26,7 @@ data::Value builtin_print(const std::vector<data::Value> &params, const BuiltinC
     return builtin_print_stream(params, std::cout);
 }
 
-data::Value builtin_print_stream(const std::vector<data::Value> &params, std::ostream &stream)
+data::Value builtin_print_stream(std::span<const data::Value> params, std::ostream &stream)
 {
     bool first = true;
     for (const data::Value &param: params) {    // print has unlimited number of parameters
@@ -52,7 +52,7 @@ data::Value builtin_print_stream(const std::vector<data::Value> &params, std::os
                     stream << "EntityRef(" << (value.is_empty() ? "EMPTY" : std::to_string(value.ref).c_str()) << ")";
                 } else if constexpr (std::is_same_v<type, data::List>) {
                     stream << "List\t";
-                    builtin_print_stream((std::get<data::List>((const data::Value &)value)).items, stream);
+                    builtin_print_stream(std::as_const(value.items), stream);
                 } else {
                     throw std::runtime_error("Code branch shouldn't execute.");
                 }
@@ -442,10 +442,7 @@ data::Value builtin_color(const std::vector<data::Value> &params, const BuiltinC
 
 data::Value builtin_list(const std::vector<data::Value> &params, const BuiltinContext &)
 {
-    data::List r;
-
-    for (const data::Value &param: params) { r.items.push_back(param); }
-    return {r};
+    return {data::List{params}};
 }
 
 data::Value builtin_at(const std::vector<data::Value> &params, const BuiltinContext &)
@@ -472,19 +469,21 @@ data::Value builtin_remove(const std::vector<data::Value> &params, const Builtin
         logger.err("ERROR") << " by index 'at(" << index << ")' and size '" << list.items.size() << "'";
         throw InvalidOperation("Index out of list range.");
     }
-    data::List r;
+    std::vector<data::Value> items;
+    items.reserve(list.items.size() - 1);
     for (size_t i = 0; i < list.items.size(); i++)
-        if (i != index) r.items.push_back(data::Value{list.items.at(i)});
-    return data::Value{r};
+        if (i != index) items.push_back(list.items[i]);
+    return data::Value{data::List{std::move(items)}};
 }
 
 data::Value builtin_push(const std::vector<data::Value> &params, const BuiltinContext &)
 {
     const data::List &list = std::get<data::List>(params.at(0));
-    data::List r;
-    for (const data::Value &v: list.items) r.items.push_back(v);
-    for (size_t i = 1; i < params.size(); i++) r.items.push_back(params.at(i));
-    return data::Value{r};
+    std::vector<data::Value> items;
+    items.reserve(list.items.size() + params.size() - 1);
+    items.insert(items.end(), list.items.begin(), list.items.end());
+    items.insert(items.end(), std::next(params.begin()), params.end());
+    return data::Value{data::List{std::move(items)}};
 }
 
 // Mathematical/Arithmetic operators -- end
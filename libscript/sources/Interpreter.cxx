@@ -208,6 +208,7 @@ Interpreter::executeSystem(const Node &systemEntry, const systems::Description &
 void Interpreter::executeStatement(const Node &statement, Stack &stack)
 {
     PROFILE_FUNCTION();
+    PROFILE_COUNTER("Script statements executed", 1);
     if (statement.value == "functionCall") {
         executeFunction(statement, stack);
     } else if (statement.value == "if") {
@@ -631,6 +632,7 @@ data::Value Interpreter::evaluateExpression(const Node &expr, const Stack &stack
 
     // vector to hold operands/operators during evaluation
     std::vector<ExpressionOp> ops;
+    ops.reserve(expr.children.size());
     for (const Node &n: expr.children) {    // fill the vector
         if (n.type == NodeType::Operator)
             ops.push_back(ExpressionOp{.isOperator = true, .operatorStr = n.value});
@@ -653,7 +655,7 @@ data::Value Interpreter::evaluateExpression(const Node &expr, const Stack &stack
             }
         }
     }
-    return ops.at(0).operand;
+    return std::move(ops.at(0).operand);
 }
 
 // Throw if the type or value of the targeted node isn't equal to the expected type and value
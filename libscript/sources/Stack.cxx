@@ -5,7 +5,7 @@
 namespace pivot::ecs::script::interpreter
 {
 
-Stack::Stack() {}
+Stack::Stack(): _stack(&_pool) {}
 
 // Public methods
 
@@ -23,13 +23,12 @@ void Stack::pushEntity(const std::string &entityName, Entity entityId,
 {
     if (entityName.empty()) return;
 
-    data::Record entityRecord;
-
-    for (const component::ComponentRef &ref: components) {
-        entityRecord.insert_or_assign(ref.description().name, ref.get());
-    }
-    entityRecord.insert_or_assign("id", data::Value{EntityRef{entityId}});
-    this->push(entityName, entityRecord);
+    std::vector<data::Record::value_type> entityRecord;
+    entityRecord.reserve(components.size() + 1);
+    // The first field of a name is kept, so the id takes precedence over a component named id
+    entityRecord.emplace_back("id", data::Value{EntityRef{entityId}});
+    for (const component::ComponentRef &ref: components) entityRecord.emplace_back(ref.description().name, ref.get());
+    this->push(entityName, data::Record(std::move(entityRecord)));
 }
 
 void Stack::updateEntity(const std::string &entityName, std::span<component::ComponentRef> components)
@@ -40,55 +39,31 @@ void Stack::updateEntity(const std::string &entityName, std::span<component::Com
     for (component::ComponentRef &ref: components) { ref.set(newEntityRecord.at(ref.description().name)); }
 }
 
-const data::Value Stack::find(const std::string &name) const { return find(name, _stack); }
+data::Value Stack::find(const std::string &name) const { return find(name, _stack); }
 
-void Stack::setValue(const std::string &name, const data::Value &newVal)
-{
-    if (!setVectorValue(name, newVal, _stack)) findMut(name, _stack) = newVal;
-}
+void Stack::setValue(const std::string &name, const data::Value &newVal) { setValue(name, newVal, _stack); }
 
 // Private methods
 
-bool Stack::setVectorValue(const std::string &name, const data::Value &newVal, data::Record &where)
+namespace
 {
-    size_t dot = name.find('.');
-    if (dot == std::string::npos) {    // base case, final access of variable
-        return false;
+    /// Modifies a variable of the stack, which must exist
+    template <typename F>
+    void modifyVariable(std::pmr::map<std::string, data::Value> &variables, const std::string &name, F &&f)
+    {
+        f(variables.at(name));
     }
-    const std::string accessingVar = name.substr(0, dot);
-    if (!where.contains(accessingVar)) {    // record does not contain searched variable
-        return false;
-    } else if (!std::holds_alternative<data::Record>(
-                   where.at(accessingVar))) {    // record contains variable, but it is not a record
-        if (std::holds_alternative<glm::vec3>(where.at(accessingVar))) {    // but it might be a vector3
-            if (!std::holds_alternative<double>(newVal)) {
-                logger.err("ERROR") << " with new variable of type " << newVal.type();
-                throw InvalidException("Stack Find: Can only apply Number type to Vector3 field");
-            }
-            // if it is a vector3, check that the accessed variable is 'x' 'y' or 'z'
-            const std::string accessedVar = name.substr(dot + 1);
-            if (accessedVar == "x") {
-                std::get<glm::vec3>(where.at(accessingVar)).x = std::get<double>(newVal);
-                return true;
-            } else if (accessedVar == "y") {
-                std::get<glm::vec3>(where.at(accessingVar)).y = std::get<double>(newVal);
-                return true;
-            } else if (accessedVar == "z") {
-                std::get<glm::vec3>(where.at(accessingVar)).z = std::get<double>(newVal);
-                return true;
-            } else {
-                return false;
-            }
-        } else {
-            return false;
-        }
+
+    /// Modifies a field of a record, which must exist, without preventing the record from being shared afterwards
+    template <typename F>
+    void modifyVariable(data::Record &record, const std::string &name, F &&f)
+    {
+        record.modify(name, std::forward<F>(f));
     }
-    return setVectorValue(
-        name.substr(dot + 1), newVal,
-        std::get<data::Record>(where.at(accessingVar)));    // recursive call on the rest of the access chain
-}
+}    // namespace
 
-data::Value &Stack::findMut(const std::string &name, data::Record &where)
+template <typename Map>
+void Stack::setValue(const std::string &name, const data::Value &newVal, Map &where)
 {
     size_t dot = name.find('.');
     if (dot == std::string::npos) {    // base case, final access of variable
@@ -96,29 +71,36 @@ data::Value &Stack::findMut(const std::string &name, data::Record &where)
             logger.err("ERROR") << " with variable " << name;
             throw InvalidException("Stack Find: Unknown Variable.");
         }
-        return where.at(name);
+        modifyVariable(where, name, [&](data::Value &variable) { variable = newVal; });
+        return;
     }
     const std::string accessingVar = name.substr(0, dot);
     if (!where.contains(accessingVar)) {    // record does not contain searched variable
         logger.err("ERROR") << " with variable " << name;
         throw InvalidException("Stack Find: Unknown Variable.");
-    } else if (!std::holds_alternative<data::Record>(
-                   where.at(accessingVar))) {    // record contains variable, but it is not a record
-        if (std::holds_alternative<data::ScriptEntity>(where.at(accessingVar))) {
-            return findMut(name.substr(dot + 1),
-                           std::get<data::ScriptEntity>(where.at(accessingVar))
-                               .components);    // recursive call on the rest of the access chain
-
+    }
+    const std::string accessedVar = name.substr(dot + 1);
+    modifyVariable(where, accessingVar, [&](data::Value &variable) {
+        if (auto record = std::get_if<data::Record>(&variable)) {
+            setValue(accessedVar, newVal, *record);    // recursive call on the rest of the access chain
+        } else if (auto entity = std::get_if<data::ScriptEntity>(&variable)) {
+            setValue(accessedVar, newVal, entity->components);
+        } else if (auto vector = std::get_if<glm::vec3>(&variable);
+                   vector && (accessedVar == "x" || accessedVar == "y" || accessedVar == "z")) {
+            if (!std::holds_alternative<double>(newVal)) {
+                logger.err("ERROR") << " with new variable of type " << newVal.type();
+                throw InvalidException("Stack Find: Can only apply Number type to Vector3 field");
+            }
+            (*vector)[accessedVar[0] - 'x'] = std::get<double>(newVal);
         } else {
-            logger.err("ERROR") << " with variable " << accessingVar << " of type " << where.at(accessingVar).type();
+            logger.err("ERROR") << " with variable " << accessingVar << " of type " << variable.type();
             throw InvalidException("Stack Find: Variable is not a Record");
         }
-    }
-    return findMut(name.substr(dot + 1),
-                   std::get<data::Record>(where.at(accessingVar)));    // recursive call on the rest of the access chain
+    });
 }
 
-const data::Value Stack::find(const std::string &name, const data::Record &where) const
+template <typename Map>
+data::Value Stack::find(const std::string &name, const Map &where) const
 {
     size_t dot = name.find('.');
     if (dot == std::string::npos) {    // base case, final access of variable
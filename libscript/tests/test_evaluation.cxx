@@ -0,0 +1,74 @@
+#include "pivot/script/Engine.hxx"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace pivot::ecs;
+
+namespace
+{
+const std::string script = "component Body\n"
+                           "\tNumber x\n"
+                           "\tNumber y\n"
+                           "\tString name\n"
+                           "system Integrate(anyEntity<Body>) event Tick(Number deltaTime)\n"
+                           "\tList steps = list(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16)\n"
+                           "\tNumber i = 0\n"
+                           "\twhile i < 200\n"
+                           "\t\tanyEntity.Body.x = anyEntity.Body.x + anyEntity.Body.y * deltaTime * at(steps, 1)\n"
+                           "\t\tsteps = push(steps, i)\n"
+                           "\t\tsteps = remove(steps, 16)\n"
+                           "\t\ti = i + 1\n";
+
+struct Fixture {
+    Fixture()
+    {
+        engine.loadFile(script, true);
+        system = systems.getDescription("Integrate").value();
+        const auto body = components.getDescription("Body").value();
+        array = body.createContainer(body);
+        array->setValueForEntity(0, data::Record{{"x", 0.0}, {"y", 2.0}, {"name", "a body with a long name"}});
+    }
+
+    double x() const { return std::get<double>(std::get<data::Record>(array->getValueForEntity(0).value()).at("x")); }
+
+    void tick()
+    {
+        component::ArrayCombination combination{{std::ref(*array)}};
+        event::EventWithComponent event = {
+            .event = event::Event{.description = system.eventListener, .entities = {}, .payload = 0.5}};
+        system.system(system, combination, event);
+    }
+
+    component::Index components;
+    systems::Index systems;
+    event::Index events;
+    script::Engine engine{systems, components, events, script::interpreter::builtins::BuiltinContext()};
+    systems::Description system;
+    std::unique_ptr<component::IComponentArray> array;
+};
+}    // namespace
+
+TEST_CASE("Scripts evaluate expressions on records and lists", "[script][evaluation]")
+{
+    Fixture fixture;
+    fixture.tick();
+    // x += y * deltaTime * 2 on every iteration
+    REQUIRE(fixture.x() == 400.0);
+}
+
+TEST_CASE("Script expression evaluation", "[.][benchmark][script][evaluation]")
+{
+    constexpr int repeat = 200;
+    using Clock = std::chrono::steady_clock;
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    Fixture fixture;
+    const auto start = Clock::now();
+    for (int i = 0; i < repeat; i++) fixture.tick();
+    std::cout << "sizeof(data::Value): " << sizeof(data::Value) << " bytes" << std::endl;
+    std::cout << "Script loop of 200 iterations: " << Microseconds(Clock::now() - start).count() / repeat
+              << "us per tick" << std::endl;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <pivot/utility/TraceStream.hxx>
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+///
+/// @brief Keep the last seconds of a trace stream in memory, and write them to disk
+///
+/// The events are written in rolling windows of fixed duration, only the last windows are kept on disk. The memory
+/// used is bounded both by the duration of the history, and by a maximum amount of events.
+///
+/// Timestamps are only comparable inside a connection, so the history restarts with each connection.
+///
+class TraceHistory
+{
+public:
+    /// What is kept, and where it is written
+    struct Config {
+        /// Duration kept in memory
+        std::chrono::seconds history;
+        /// Duration of each window written to disk, 0 to disable them
+        std::chrono::seconds window;
+        /// Amount of windows kept on disk
+        unsigned keptWindows;
+        /// Maximum amount of events kept in memory
+        std::size_t maxEvents;
+        /// Directory where the files are written
+        std::filesystem::path output;
+    };
+
+public:
+    /// Constructor
+    TraceHistory(Config config);
+
+    /// Start recording a new connection, forgetting the previous one
+    void beginConnection();
+    /// Record a message of the current connection
+    void add(const pivot::benchmark::stream::Message &message);
+    /// Write the events not written in a window yet
+    void endConnection();
+
+    ///
+    /// @brief Write the last seconds of the trace
+    ///
+    /// @return the path of the written file
+    std::filesystem::path dump(std::chrono::seconds duration);
+    /// Amount of events in memory
+    std::size_t size() const;
+
+private:
+    struct Event {
+        const std::string *name;
+        const std::string *thread;
+        pivot::benchmark::ZoneType type;
+        std::uint64_t timestamp;
+        std::uint64_t duration;
+        double value;
+    };
+
+    const std::string &intern(std::string value);
+    void prune();
+    void closeWindow(std::uint64_t end);
+    void write(const std::filesystem::path &path, std::uint64_t begin, std::uint64_t end) const;
+
+private:
+    const Config config;
+    mutable std::mutex mutex;
+
+    std::deque<Event> events;
+    std::uint64_t latestTimestamp = 0;
+    std::optional<std::uint64_t> windowBegin;
+    std::size_t windowIndex = 0;
+    std::size_t dumpIndex = 0;
+
+    /// Names of the zones and threads, shared between the events
+    std::set<std::string> names;
+    std::unordered_map<std::uint32_t, std::pair<const std::string *, pivot::benchmark::ZoneType>> zones;
+    std::unordered_map<std::uint32_t, const std::string *> threads;
+};
@@ -0,0 +1,162 @@
+#include "TraceHistory.hxx"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace pivot::benchmark;
+
+namespace
+{
+/// Events may arrive a bit after the end of their window, as each thread buffer is drained separately
+constexpr std::uint64_t windowGracePeriod = std::chrono::nanoseconds(std::chrono::seconds(1)).count();
+
+std::uint64_t toNanoseconds(std::chrono::seconds duration)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+}    // namespace
+
+TraceHistory::TraceHistory(Config config): config(std::move(config))
+{
+    std::filesystem::create_directories(this->config.output);
+}
+
+void TraceHistory::beginConnection()
+{
+    std::unique_lock lock(mutex);
+    events.clear();
+    latestTimestamp = 0;
+    windowBegin.reset();
+    zones.clear();
+    threads.clear();
+}
+
+void TraceHistory::add(const stream::Message &message)
+{
+    std::unique_lock lock(mutex);
+    std::visit(
+        [this](const auto &msg) {
+            using T = std::decay_t<decltype(msg)>;
+            Event event{};
+            if constexpr (std::is_same_v<T, stream::ZoneMessage>) {
+                zones[msg.id] = {&intern(msg.name), msg.type};
+                return;
+            } else if constexpr (std::is_same_v<T, stream::ThreadMessage>) {
+                threads[msg.id] = &intern(msg.name);
+                return;
+            } else if constexpr (std::is_same_v<T, stream::FrameMessage>) {
+                event = {&intern("Frame"), &intern(""), ZoneType::Frame, msg.timestamp};
+            } else {
+                auto zone = zones.find(msg.zone);
+                auto thread = threads.find(msg.thread);
+                if (zone == zones.end() || thread == threads.end()) {
+                    logger.warn("Trace History") << "Event referencing an unknown zone or thread";
+                    return;
+                }
+                if constexpr (std::is_same_v<T, stream::ScopeMessage>) {
+                    event = {zone->second.first, thread->second, zone->second.second, msg.start, msg.duration};
+                } else {
+                    event = {zone->second.first, thread->second, zone->second.second, msg.timestamp, 0, msg.value};
+                }
+            }
+
+            events.push_back(event);
+            latestTimestamp = std::max(latestTimestamp, event.timestamp + event.duration);
+            if (!windowBegin) windowBegin = event.timestamp;
+        },
+        message);
+
+    if (config.window.count() > 0 && windowBegin &&
+        latestTimestamp >= *windowBegin + toNanoseconds(config.window) + windowGracePeriod)
+        closeWindow(*windowBegin + toNanoseconds(config.window));
+    prune();
+}
+
+void TraceHistory::endConnection()
+{
+    std::unique_lock lock(mutex);
+    if (config.window.count() > 0 && windowBegin) closeWindow(latestTimestamp + 1);
+}
+
+std::filesystem::path TraceHistory::dump(std::chrono::seconds duration)
+{
+    std::unique_lock lock(mutex);
+    const std::uint64_t length = toNanoseconds(duration);
+    const std::uint64_t begin = (latestTimestamp > length) ? (latestTimestamp - length) : (0);
+    auto path = config.output / ("trace_dump_" + std::to_string(dumpIndex++) + ".json");
+    write(path, begin, latestTimestamp + 1);
+    return path;
+}
+
+std::size_t TraceHistory::size() const
+{
+    std::unique_lock lock(mutex);
+    return events.size();
+}
+
+const std::string &TraceHistory::intern(std::string value)
+{
+    // Names are written as is in the json files
+    std::replace(value.begin(), value.end(), '"', '\'');
+    std::replace(value.begin(), value.end(), '\\', '/');
+    return *names.insert(std::move(value)).first;
+}
+
+void TraceHistory::prune()
+{
+    // Windows must be written before their events are forgotten
+    std::uint64_t limit = latestTimestamp - std::min(latestTimestamp, toNanoseconds(config.history));
+    if (config.window.count() > 0 && windowBegin) limit = std::min(limit, *windowBegin);
+
+    while (!events.empty() && (events.front().timestamp < limit || events.size() > config.maxEvents))
+        events.pop_front();
+}
+
+void TraceHistory::closeWindow(std::uint64_t end)
+{
+    write(config.output / ("trace_window_" + std::to_string(windowIndex) + ".json"), *windowBegin, end);
+    if (windowIndex >= config.keptWindows) {
+        std::error_code error;
+        std::filesystem::remove(
+            config.output / ("trace_window_" + std::to_string(windowIndex - config.keptWindows) + ".json"), error);
+    }
+    windowIndex++;
+    windowBegin = end;
+}
+
+void TraceHistory::write(const std::filesystem::path &path, std::uint64_t begin, std::uint64_t end) const
+{
+    std::ofstream file(path);
+    if (!file) {
+        logger.err("Trace History") << "Can't write " << path;
+        return;
+    }
+
+    // Same format as the session files of the Instrumentor
+    file << "{\"otherData\": {},\"traceEvents\":[";
+    bool first = true;
+    for (const auto &event: events) {
+        if (event.timestamp < begin || event.timestamp >= end) continue;
+        if (!first) file << ",";
+        first = false;
+
+        switch (event.type) {
+            case ZoneType::Scope:
+                file << "{\"cat\":\"function\",\"dur\":" << event.duration << ",\"name\":\"" << *event.name
+                     << "\",\"ph\":\"X\",\"pid\":0,\"tid\": \"" << *event.thread << "\",\"ts\":" << event.timestamp
+                     << "}";
+                break;
+            case ZoneType::Counter:
+            case ZoneType::Gauge:
+                file << "{\"cat\":\"counter\",\"name\":\"" << *event.name << "\",\"ph\":\"C\",\"pid\":0,\"tid\": \""
+                     << *event.thread << "\",\"ts\":" << event.timestamp << ",\"args\":{\"value\":" << event.value
+                     << "}}";
+                break;
+            case ZoneType::Frame:
+                file << "{\"cat\":\"frame\",\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"ts\":"
+                     << event.timestamp << "}";
+                break;
+        }
+    }
+    file << "]}";
+}
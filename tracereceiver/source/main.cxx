@@ -0,0 +1,143 @@
+#include <pivot/utility/Socket.hxx>
+#include <pivot/utility/TraceStream.hxx>
+
+#include <argparse/argparse.hpp>
+
+#include <array>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "TraceHistory.hxx"
+
+using namespace pivot;
+using namespace pivot::benchmark;
+
+namespace
+{
+constexpr const char *help = "Commands:\n"
+                             "  dump [seconds]  write the last seconds of the trace (the whole history by default)\n"
+                             "  status          show the amount of events in memory\n"
+                             "  quit            stop the receiver\n";
+
+/// Receive the streams of the engine, one connection at a time
+void receive(Socket &listener, TraceHistory &history, std::mutex &connectionMutex, Socket *&connection)
+{
+    while (true) {
+        Socket client;
+        try {
+            client = listener.accept();
+        } catch (const Socket::SocketError &) {
+            return;
+        }
+        {
+            std::unique_lock lock(connectionMutex);
+            connection = &client;
+        }
+        history.beginConnection();
+        logger.info("Receiver") << "Engine connected";
+
+        stream::Decoder decoder;
+        std::array<std::byte, 64 * 1024> buffer;
+        try {
+            while (auto size = client.receive(buffer)) {
+                decoder.feed(std::span(buffer).first(size));
+                while (auto message = decoder.next()) history.add(*message);
+            }
+        } catch (const stream::Decoder::DecoderError &error) {
+            logger.err("Receiver") << error.what();
+        }
+
+        {
+            std::unique_lock lock(connectionMutex);
+            connection = nullptr;
+        }
+        history.endConnection();
+        logger.info("Receiver") << "Engine disconnected";
+    }
+}
+}    // namespace
+
+int main(int argc, const char *argv[])
+{
+    logger.start();
+
+    argparse::ArgumentParser parser("pivot-trace-receiver", "1.0", argparse::default_arguments::help);
+    parser.add_description("Record the profiling results streamed by the engine (Instrumentor::beginStreaming).");
+    parser.add_argument("-a", "--address").help("Address to listen on.").default_value(std::string("127.0.0.1"));
+    parser.add_argument("-p", "--port")
+        .help("Port to listen on.")
+        .default_value(int(stream::defaultPort))
+        .scan<'i', int>();
+    parser.add_argument("-o", "--output")
+        .help("Directory where the traces are written.")
+        .default_value(std::string("traces"));
+    parser.add_argument("--history").help("Seconds of trace kept in memory.").default_value(60).scan<'i', int>();
+    parser.add_argument("--window")
+        .help("Seconds of trace in each rolling file, 0 to disable them.")
+        .default_value(10)
+        .scan<'i', int>();
+    parser.add_argument("--keep").help("Amount of rolling files kept on disk.").default_value(6).scan<'i', int>();
+    parser.add_argument("--max-events")
+        .help("Maximum amount of events kept in memory.")
+        .default_value(4'000'000)
+        .scan<'i', int>();
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::runtime_error &err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    const std::chrono::seconds history(std::max(parser.get<int>("--history"), 1));
+    TraceHistory traceHistory({
+        .history = history,
+        .window = std::chrono::seconds(std::max(parser.get<int>("--window"), 0)),
+        .keptWindows = static_cast<unsigned>(std::max(parser.get<int>("--keep"), 1)),
+        .maxEvents = static_cast<std::size_t>(std::max(parser.get<int>("--max-events"), 1)),
+        .output = parser.get<std::string>("--output"),
+    });
+
+    Socket listener;
+    try {
+        listener = Socket::listen(static_cast<std::uint16_t>(parser.get<int>("--port")),
+                                  parser.get<std::string>("--address"));
+    } catch (const Socket::SocketError &error) {
+        logger.err("Receiver") << error.what();
+        return 1;
+    }
+    logger.info("Receiver") << "Listening on port " << listener.getPort();
+    std::cout << help << std::flush;
+
+    std::mutex connectionMutex;
+    Socket *connection = nullptr;
+    std::jthread network(receive, std::ref(listener), std::ref(traceHistory), std::ref(connectionMutex),
+                         std::ref(connection));
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream command(line);
+        std::string name;
+        command >> name;
+        if (name == "dump") {
+            int seconds = history.count();
+            command >> seconds;
+            auto path = traceHistory.dump(std::chrono::seconds(seconds));
+            logger.info("Receiver") << "Last " << seconds << " seconds written to " << path;
+        } else if (name == "status") {
+            logger.info("Receiver") << traceHistory.size() << " events in memory";
+        } else if (name == "quit" || name == "exit") {
+            listener.shutdown();
+            std::unique_lock lock(connectionMutex);
+            if (connection) connection->shutdown();
+            break;
+        } else if (!name.empty()) {
+            std::cout << help << std::flush;
+        }
+    }
+    // Without any input, record until killed
+    network.join();
+    return 0;
+}